@@ -0,0 +1,273 @@
+#include <core/bidirectional_search.h>
+#include <core/hierarchical_map.h>
+#include <core/jump_point_search.h>
+#include <core/landmarks.h>
+#include <core/map_io.h>
+#include <core/search.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using pathfinder::CellIndex;
+using pathfinder::CornerCutting;
+using pathfinder::GridMap;
+using pathfinder::HierarchicalMap;
+using pathfinder::JumpTable;
+using pathfinder::LandmarkTable;
+using pathfinder::Scenario;
+using pathfinder::SearchContext;
+using pathfinder::SearchResult;
+
+namespace {
+
+// The searches that can be picked with --mode
+const char* const kModes[] = {"astar", "jps", "jps+", "hpa", "bidir",
+                              "bidir-mt", "alt", "octile"};
+
+// Moving in 8 directions without cutting corners, as the optimal lengths in
+// .scen files do
+typedef pathfinder::EightConnected<CornerCutting::kNever> OctileConnectivity;
+
+/**
+ * Helper method that prints how the program is meant to be run
+ */
+void PrintUsage(const char* program) {
+  std::cerr << "Usage: " << program << " [--mode <mode>] <scen file> [map file]"
+            << std::endl
+            << "Modes:";
+  for (const char* mode : kModes) {
+    std::cerr << " " << mode;
+  }
+  std::cerr << std::endl;
+}
+
+/**
+ * Helper method that returns the directory part of a path, including the
+ * trailing slash
+ */
+std::string GetDirectory(const std::string& path) {
+  size_t slash = path.find_last_of('/');
+  return slash == std::string::npos ? "" : path.substr(0, slash + 1);
+}
+
+/**
+ * Helper method that loads the map a scenario refers to. .scen files name
+ * their map relative to the benchmark root, so the map is looked for next to
+ * the .scen file both with and without its directories.
+ * @param map_path Set to the file the map was loaded from
+ */
+bool LoadScenarioMap(const std::string& scenario_path,
+                     const std::string& map_name, GridMap& map,
+                     std::string& map_path) {
+  std::string directory = GetDirectory(scenario_path);
+  std::string base_name = map_name.substr(GetDirectory(map_name).size());
+  const std::string candidates[] = {directory + map_name,
+                                    directory + base_name};
+  for (const std::string& candidate : candidates) {
+    std::ifstream map_file(candidate);
+    if (map_file && pathfinder::LoadMap(map_file, map)) {
+      map_path = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Helper method that loads the landmarks saved next to a map file, or builds
+ * them and tries to save them there for the next run
+ */
+void LoadLandmarks(const std::string& map_path, const GridMap& map,
+                   LandmarkTable& landmarks) {
+  std::string landmark_path = map_path + ".landmarks";
+  std::ifstream input(landmark_path, std::ios::binary);
+  if (input && landmarks.Load(input, map)) {
+    return;
+  }
+  landmarks.Build(map);
+  std::ofstream output(landmark_path, std::ios::binary);
+  if (!output || !landmarks.Save(output)) {
+    std::cerr << "Could not save landmarks " << landmark_path << std::endl;
+  }
+}
+
+/**
+ * Helper method that returns the value below which the given fraction of the
+ * sorted values fall
+ */
+double Percentile(const std::vector<double>& sorted_values, double fraction) {
+  if (sorted_values.empty()) {
+    return 0;
+  }
+  size_t rank = (size_t)std::ceil(fraction * sorted_values.size());
+  return sorted_values[std::max<size_t>(rank, 1) - 1];
+}
+
+}  // namespace
+
+/**
+ * Runs every scenario of a Moving AI .scen file and prints a summary of the
+ * optimality gap, the number of expanded cells and the latency of each query.
+ *
+ * The optimal lengths in .scen files are for 8-connected movement, so the
+ * optimality gap shows how much longer the paths found are than those.
+ *
+ * --mode picks the search: astar (the default), jps for jump point search,
+ * jps+, hpa for HPA*, bidir for bidirectional A*, which bidir-mt runs on
+ * two threads, alt for A* with landmark distances, or octile for A* moving
+ * in 8 directions like the .scen files, whose gap only comes from rounding
+ * diagonal steps to 1.4. The JPS+ table and the HPA* clusters are built
+ * whenever a new map is loaded, which is not counted in the latency.
+ * Landmarks are saved next to the map as <map file>.landmarks and loaded from
+ * there on later runs.
+ *
+ * Usage: benchmark-suite [--mode <mode>] <scen file> [map file]
+ */
+int main(int argc, char** argv) {
+  std::string mode = kModes[0];
+  std::vector<std::string> files;
+  for (int arg = 1; arg < argc; arg++) {
+    std::string option = argv[arg];
+    if (option == "--mode" && arg + 1 < argc) {
+      mode = argv[++arg];
+    } else {
+      files.push_back(option);
+    }
+  }
+  if (files.empty() || files.size() > 2 ||
+      std::find(std::begin(kModes), std::end(kModes), mode) ==
+          std::end(kModes)) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  std::string scenario_path = files[0];
+  std::ifstream scenario_file(scenario_path);
+  std::vector<Scenario> scenarios;
+  if (!scenario_file || !pathfinder::LoadScenarios(scenario_file, scenarios)) {
+    std::cerr << "Could not load scenarios " << scenario_path << std::endl;
+    return 1;
+  }
+
+  GridMap map;
+  std::string loaded_map_name;
+  std::string map_path;
+  bool map_given = files.size() == 2;
+  if (map_given) {
+    map_path = files[1];
+    std::ifstream map_file(files[1]);
+    if (!map_file || !pathfinder::LoadMap(map_file, map)) {
+      std::cerr << "Could not load map " << files[1] << std::endl;
+      return 1;
+    }
+  }
+  SearchContext context = SearchContext(map);
+  SearchContext backward_context = SearchContext(map);
+  std::vector<CellIndex>& path = context.GetPathBuffer();
+  JumpTable jump_table;
+  LandmarkTable landmarks;
+  std::unique_ptr<HierarchicalMap> hierarchy;
+  bool map_changed = true;
+
+  size_t num_solved = 0;
+  size_t num_expanded = 0;
+  double total_gap = 0;
+  double max_gap = 0;
+  std::vector<double> latencies;
+  latencies.reserve(scenarios.size());
+
+  for (const Scenario& scenario : scenarios) {
+    // Scenarios are grouped by map, so a map is only loaded when it changes
+    if (!map_given && scenario.map_name != loaded_map_name) {
+      if (!LoadScenarioMap(scenario_path, scenario.map_name, map, map_path)) {
+        std::cerr << "Could not load map " << scenario.map_name << std::endl;
+        return 1;
+      }
+      loaded_map_name = scenario.map_name;
+      context.SetMap(map);
+      backward_context.SetMap(map);
+      map_changed = true;
+    }
+    if (map_changed && mode == "jps+") {
+      jump_table.Build(map);
+    } else if (map_changed && mode == "hpa") {
+      hierarchy.reset(new HierarchicalMap(map));
+    } else if (map_changed && mode == "alt") {
+      LoadLandmarks(map_path, map, landmarks);
+      context.SetLandmarks(&landmarks);
+    }
+    map_changed = false;
+    if (!map.InBounds(scenario.start_row, scenario.start_col) ||
+        !map.InBounds(scenario.goal_row, scenario.goal_col)) {
+      std::cerr << "Scenario is outside of its map" << std::endl;
+      return 1;
+    }
+
+    std::chrono::steady_clock::time_point start_time =
+        std::chrono::steady_clock::now();
+    CellIndex start = map.GetIndex(scenario.start_row, scenario.start_col);
+    CellIndex goal = map.GetIndex(scenario.goal_row, scenario.goal_col);
+    SearchResult result;
+    if (mode == "jps") {
+      result = pathfinder::FindJumpPointPath(context, start, goal, path);
+    } else if (mode == "jps+") {
+      result = pathfinder::FindJumpPointPath(context, start, goal, path,
+                                             &jump_table);
+    } else if (mode == "hpa") {
+      result = hierarchy->FindPath(start, goal, path);
+    } else if (mode == "bidir" || mode == "bidir-mt") {
+      result = pathfinder::FindBidirectionalPath(
+          context, backward_context, start, goal, path, mode == "bidir-mt");
+    } else if (mode == "octile") {
+      result = pathfinder::FindPath<OctileConnectivity>(context, start, goal,
+                                                        path);
+    } else {
+      result = pathfinder::FindPath(context, start, goal, path);
+    }
+    std::chrono::steady_clock::time_point end_time =
+        std::chrono::steady_clock::now();
+
+    latencies.push_back(
+        std::chrono::duration<double, std::micro>(end_time - start_time)
+            .count());
+    num_expanded += result.num_expanded;
+    if (result.found) {
+      num_solved++;
+      if (scenario.optimal_length > 0) {
+        double length = result.cost;
+        if (mode == "octile") {
+          length /= OctileConnectivity::kStraightCost;
+        }
+        double gap = (length - scenario.optimal_length) /
+                     scenario.optimal_length;
+        total_gap += gap;
+        max_gap = std::max(max_gap, gap);
+      }
+    }
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  size_t num_scenarios = scenarios.size();
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "Scenarios:      " << num_scenarios << "\n";
+  std::cout << "Solved:         " << num_solved << "\n";
+  std::cout << "Optimality gap: mean "
+            << (num_solved == 0 ? 0 : 100 * total_gap / num_solved)
+            << "%, max " << 100 * max_gap << "%\n";
+  std::cout << "Expanded cells: total " << num_expanded << ", mean "
+            << (num_scenarios == 0 ? 0 : (double)num_expanded / num_scenarios)
+            << "\n";
+  std::cout << "Latency (us):   p50 " << Percentile(latencies, 0.5) << ", p90 "
+            << Percentile(latencies, 0.9) << ", p99 "
+            << Percentile(latencies, 0.99) << ", max "
+            << Percentile(latencies, 1.0) << std::endl;
+
+  return num_solved == num_scenarios ? 0 : 1;
+}
@@ -0,0 +1,176 @@
+#include <core/batch_solver.h>
+#include <core/map_io.h>
+#include <core/search.h>
+#include <core/search_context.h>
+#include <core/search_trace.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using pathfinder::BatchSolver;
+using pathfinder::CellIndex;
+using pathfinder::GridMap;
+using pathfinder::Query;
+using pathfinder::SearchContext;
+using pathfinder::SearchResult;
+using pathfinder::TraceWriter;
+
+namespace {
+
+void PrintUsage(const char* program) {
+  std::cerr << "Usage: " << program
+            << " [--threads N] [--trace FILE] <map file> [query file]"
+            << std::endl;
+}
+
+/**
+ * Helper method that solves the queries one after another on a single
+ * context, recording every search to a trace file
+ * @return false if the trace could not be written
+ */
+bool SolveTraced(const GridMap& map, const std::vector<Query>& queries,
+                 const std::string& trace_path,
+                 std::vector<SearchResult>& results) {
+  std::ofstream trace_file(trace_path, std::ios::binary);
+  TraceWriter writer(trace_file);
+  if (!trace_file || !writer.WriteHeader(map)) {
+    return false;
+  }
+
+  SearchContext context(map);
+  context.SetTrace(&writer);
+  std::vector<CellIndex>& path = context.GetPathBuffer();
+  results.clear();
+  for (const Query& query : queries) {
+    results.push_back(
+        pathfinder::FindPath(context, query.start, query.goal, path));
+  }
+  return writer.Flush();
+}
+
+}  // namespace
+
+/**
+ * Headless batch pathfinder. Loads a map, then reads one query per line in
+ * the form "start_row start_col goal_row goal_col" from the query file (or
+ * stdin when no query file is given) and prints one line per query:
+ * "path_length cost num_expanded". Queries with no path print a length of 0
+ * and a cost of -1. Blank lines and lines starting with '#' are skipped.
+ *
+ * Queries are solved in parallel by a BatchSolver. --threads sets the number
+ * of threads, and defaults to one per hardware thread. The output is the
+ * same for any number of threads.
+ *
+ * --trace writes every search to a file that the visualizer can replay. The
+ * queries are then solved on one thread, so the searches are recorded in
+ * order. It needs a build with PATHFINDER_TRACE, or the file only holds the
+ * map.
+ *
+ * Usage: pathfind-batch [--threads N] [--trace FILE] <map file> [query file]
+ */
+int main(int argc, char** argv) {
+  size_t num_threads = 0;
+  std::string trace_path;
+  std::vector<std::string> files;
+  for (int arg = 1; arg < argc; arg++) {
+    std::string option = argv[arg];
+    if (option == "--threads" && arg + 1 < argc) {
+      num_threads = std::strtoul(argv[++arg], nullptr, 10);
+    } else if (option == "--trace" && arg + 1 < argc) {
+      trace_path = argv[++arg];
+    } else {
+      files.push_back(option);
+    }
+  }
+  if (files.empty() || files.size() > 2) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  std::ifstream map_file(files[0]);
+  GridMap map;
+  if (!map_file || !pathfinder::LoadMap(map_file, map)) {
+    std::cerr << "Could not load map " << files[0] << std::endl;
+    return 1;
+  }
+
+  std::ifstream query_file;
+  if (files.size() == 2 && files[1] != "-") {
+    query_file.open(files[1]);
+    if (!query_file) {
+      std::cerr << "Could not open queries " << files[1] << std::endl;
+      return 1;
+    }
+  }
+  std::istream& query_input = query_file.is_open() ? query_file : std::cin;
+
+  // Read the whole batch first. Invalid queries are kept as gaps so the output
+  // stays aligned with the input.
+  std::vector<Query> queries;
+  std::vector<bool> valid;
+  std::string line;
+  size_t line_number = 0;
+  int exit_code = 0;
+  while (std::getline(query_input, line)) {
+    line_number++;
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    std::istringstream query(line);
+    int start_row, start_col, goal_row, goal_col;
+    if (!(query >> start_row >> start_col >> goal_row >> goal_col) ||
+        !map.InBounds(start_row, start_col) ||
+        !map.InBounds(goal_row, goal_col)) {
+      std::cerr << "Skipping invalid query on line " << line_number << ": "
+                << line << std::endl;
+      valid.push_back(false);
+      exit_code = 1;
+      continue;
+    }
+
+    Query new_query;
+    new_query.start = map.GetIndex(start_row, start_col);
+    new_query.goal = map.GetIndex(goal_row, goal_col);
+    queries.push_back(new_query);
+    valid.push_back(true);
+  }
+
+  std::vector<SearchResult> results;
+  if (trace_path.empty()) {
+    BatchSolver solver(map, num_threads);
+    solver.Solve(queries, results);
+  } else {
+#ifndef PATHFINDER_TRACE
+    std::cerr << "Built without PATHFINDER_TRACE, so " << trace_path
+              << " will only hold the map" << std::endl;
+#endif
+    if (!SolveTraced(map, queries, trace_path, results)) {
+      std::cerr << "Could not write trace " << trace_path << std::endl;
+      return 1;
+    }
+  }
+
+  size_t next_result = 0;
+  for (bool is_valid : valid) {
+    if (!is_valid) {
+      std::cout << "0 -1 0\n";
+      continue;
+    }
+
+    const SearchResult& result = results[next_result++];
+    if (result.found) {
+      std::cout << result.path_length << ' ' << result.cost << ' '
+                << result.num_expanded << '\n';
+    } else {
+      std::cout << "0 -1 " << result.num_expanded << '\n';
+    }
+  }
+
+  std::cout.flush();
+  return exit_code;
+}
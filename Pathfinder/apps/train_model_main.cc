@@ -1,9 +0,0 @@
-#include <core/pathfinder.h>
-
-#include <iostream>
-
-int main() {
-  std::cout << "Welcome to " << naivebayes::Placeholder().GetBestClass()
-            << std::endl;
-  return 0;
-}
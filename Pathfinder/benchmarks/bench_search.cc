@@ -0,0 +1,674 @@
+#include <core/basic_search.h>
+#include <core/bidirectional_search.h>
+#include <core/bit_scan.h>
+#include <core/flow_field.h>
+#include <core/hierarchical_map.h>
+#include <core/jump_point_search.h>
+#include <core/landmarks.h>
+#include <core/replanner.h>
+#include <core/search.h>
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <utility>
+#include <vector>
+
+using pathfinder::CellIndex;
+using pathfinder::FlowField;
+using pathfinder::GridMap;
+using pathfinder::HierarchicalMap;
+using pathfinder::LandmarkTable;
+using pathfinder::Replanner;
+using pathfinder::SearchContext;
+using pathfinder::SearchResult;
+
+namespace {
+
+// The search that checks for landmarks and cell costs at every cell, with
+// buckets in place of the heap
+typedef pathfinder::BasicSearch<pathfinder::LandmarkHeuristic,
+                                pathfinder::FourConnected,
+                                pathfinder::BucketQueue, pathfinder::CellCost>
+    CheckedBucketSearch;
+
+// The search FindPath picks for maps without landmarks or cell costs
+typedef pathfinder::BasicSearch<pathfinder::ManhattanHeuristic,
+                                pathfinder::FourConnected,
+                                pathfinder::BucketQueue,
+                                pathfinder::UniformCost>
+    UniformBucketSearch;
+
+// Every map is generated from the same seed so that runs on different
+// commits search exactly the same maps
+const unsigned kSeed = 20201208;
+
+/**
+ * Helper method that makes a map where each cell is a wall with the given
+ * probability. Seeds are tried in order until the corners, which are used as
+ * the start and goal, are connected.
+ */
+GridMap MakeRandomMap(size_t size, int wall_percent) {
+  for (unsigned seed = kSeed;; seed++) {
+    GridMap map = GridMap(size, size);
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> percent(0, 99);
+    for (CellIndex index = 0; index < map.GetNumCells(); index++) {
+      if (percent(random) < wall_percent) {
+        map.SetPassable(index, false);
+      }
+    }
+    CellIndex start = map.GetIndex(0, 0);
+    CellIndex goal = map.GetIndex(size - 1, size - 1);
+    map.SetPassable(start, true);
+    map.SetPassable(goal, true);
+
+    SearchContext context = SearchContext(map);
+    if (pathfinder::FindPath(context, start, goal, context.GetPathBuffer())
+            .found) {
+      return map;
+    }
+  }
+}
+
+/**
+ * Helper method that makes a perfect maze with corridors one cell wide, carved
+ * by a randomized depth first search. Every open cell is reachable from every
+ * other one along exactly one route.
+ */
+GridMap MakeMaze(size_t size) {
+  GridMap map = GridMap(size, size);
+  for (CellIndex index = 0; index < map.GetNumCells(); index++) {
+    map.SetPassable(index, false);
+  }
+
+  // Rooms sit on even rows and columns, and the walls between them are
+  // knocked down as the maze is carved
+  size_t num_rooms = (size + 1) / 2;
+  std::vector<bool> carved(num_rooms * num_rooms, false);
+  std::vector<std::pair<size_t, size_t>> stack;
+  std::mt19937 random(kSeed);
+  const int kRowSteps[] = {-1, 1, 0, 0};
+  const int kColSteps[] = {0, 0, -1, 1};
+
+  stack.push_back(std::make_pair(0, 0));
+  carved[0] = true;
+  map.SetPassable(map.GetIndex(0, 0), true);
+  while (!stack.empty()) {
+    size_t row = stack.back().first;
+    size_t col = stack.back().second;
+
+    int directions[4];
+    int num_directions = 0;
+    for (int direction = 0; direction < 4; direction++) {
+      int next_row = (int)row + kRowSteps[direction];
+      int next_col = (int)col + kColSteps[direction];
+      if (next_row >= 0 && next_row < (int)num_rooms && next_col >= 0 &&
+          next_col < (int)num_rooms &&
+          !carved[next_row * num_rooms + next_col]) {
+        directions[num_directions++] = direction;
+      }
+    }
+    if (num_directions == 0) {
+      stack.pop_back();
+      continue;
+    }
+
+    int direction = directions[random() % num_directions];
+    size_t next_row = row + kRowSteps[direction];
+    size_t next_col = col + kColSteps[direction];
+    carved[next_row * num_rooms + next_col] = true;
+    map.SetPassable(map.GetIndex(row + next_row, col + next_col), true);
+    map.SetPassable(map.GetIndex(2 * next_row, 2 * next_col), true);
+    stack.push_back(std::make_pair(next_row, next_col));
+  }
+
+  // Even sizes leave a border with no rooms on it, so open the far corner up
+  // to the nearest room
+  CellIndex goal = map.GetIndex(size - 1, size - 1);
+  map.SetPassable(goal, true);
+  if (size % 2 == 0) {
+    map.SetPassable(map.GetIndex(size - 2, size - 1), true);
+  }
+  return map;
+}
+
+/**
+ * Helper method that makes the map a benchmark asks for. A negative wall
+ * percentage means a maze.
+ */
+GridMap MakeBenchmarkMap(const benchmark::State& state) {
+  size_t size = state.range(0);
+  int wall_percent = state.range(1);
+  return wall_percent < 0 ? MakeMaze(size) : MakeRandomMap(size, wall_percent);
+}
+
+/**
+ * Sizes from 32 to 4096 on open maps, maps with 20% and 35% walls, and mazes.
+ * Above about 40% walls random maps break up into islands, so the corners
+ * are rarely connected.
+ */
+void MapArguments(benchmark::internal::Benchmark* benchmark) {
+  for (int size : {32, 128, 512, 2048, 4096}) {
+    for (int wall_percent : {0, 20, 35, -1}) {
+      benchmark->Args({size, wall_percent});
+    }
+  }
+  benchmark->ArgNames({"size", "walls"});
+}
+
+/**
+ * Helper method that runs every map from MapArguments on one thread and then
+ * on two
+ */
+void ThreadedMapArguments(benchmark::internal::Benchmark* benchmark) {
+  for (int size : {32, 128, 512, 2048, 4096}) {
+    for (int wall_percent : {0, 20, 35, -1}) {
+      benchmark->Args({size, wall_percent, 0});
+      benchmark->Args({size, wall_percent, 1});
+    }
+  }
+  benchmark->ArgNames({"size", "walls", "threaded"});
+}
+
+/**
+ * Helper method that runs the maps from MapArguments up to 2048 cells wide.
+ * A landmark table for a 4096 map takes 256MB with the default number of
+ * landmarks.
+ */
+void LandmarkMapArguments(benchmark::internal::Benchmark* benchmark) {
+  for (int size : {32, 128, 512, 2048}) {
+    for (int wall_percent : {0, 20, 35, -1}) {
+      benchmark->Args({size, wall_percent});
+    }
+  }
+  benchmark->ArgNames({"size", "walls"});
+}
+
+/**
+ * Helper method that runs every map from MapArguments on 1, 2 and 4 threads
+ */
+void PoolMapArguments(benchmark::internal::Benchmark* benchmark) {
+  for (int size : {32, 128, 512, 2048, 4096}) {
+    for (int wall_percent : {0, 20, 35, -1}) {
+      for (int num_threads : {1, 2, 4}) {
+        benchmark->Args({size, wall_percent, num_threads});
+      }
+    }
+  }
+  benchmark->ArgNames({"size", "walls", "threads"});
+}
+
+/**
+ * Helper method that runs the random maps from MapArguments with cell costs
+ * up to 9, up to kMaxBucketCost and just above it. The last one is searched
+ * with the heap instead of the bucket queue.
+ */
+void WeightedMapArguments(benchmark::internal::Benchmark* benchmark) {
+  for (int size : {32, 128, 512, 2048}) {
+    for (int wall_percent : {0, 20}) {
+      for (int max_cost : {9, pathfinder::kMaxBucketCost,
+                           pathfinder::kMaxBucketCost + 1}) {
+        benchmark->Args({size, wall_percent, max_cost});
+      }
+    }
+  }
+  benchmark->ArgNames({"size", "walls", "max_cost"});
+}
+
+}  // namespace
+
+/**
+ * A full query from one corner of the map to the other
+ */
+void BM_FindPath(benchmark::State& state) {
+  GridMap map = MakeBenchmarkMap(state);
+  SearchContext context = SearchContext(map);
+  std::vector<CellIndex>& path = context.GetPathBuffer();
+  CellIndex start = map.GetIndex(0, 0);
+  CellIndex goal = map.GetIndex(map.GetNumRows() - 1, map.GetNumCols() - 1);
+
+  SearchResult result = SearchResult();
+  for (auto _ : state) {
+    result = pathfinder::FindPath(context, start, goal, path);
+    benchmark::DoNotOptimize(result);
+  }
+  state.counters["expanded"] = result.num_expanded;
+  state.counters["path_length"] = result.path_length;
+  state.counters["cells_per_second"] = benchmark::Counter(
+      result.num_expanded, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_FindPath)->Apply(MapArguments)->Unit(benchmark::kMicrosecond);
+
+/**
+ * The same query as BM_FindPath on a map where every cell gets a random cost
+ * from 1 to the third argument
+ */
+void BM_FindWeightedPath(benchmark::State& state) {
+  GridMap map = MakeBenchmarkMap(state);
+  std::mt19937 random(kSeed);
+  std::uniform_int_distribution<int> terrain(1, state.range(2));
+  for (CellIndex index = 0; index < map.GetNumCells(); index++) {
+    map.SetCost(index, terrain(random));
+  }
+  SearchContext context = SearchContext(map);
+  std::vector<CellIndex>& path = context.GetPathBuffer();
+  CellIndex start = map.GetIndex(0, 0);
+  CellIndex goal = map.GetIndex(map.GetNumRows() - 1, map.GetNumCols() - 1);
+
+  SearchResult result = SearchResult();
+  for (auto _ : state) {
+    result = pathfinder::FindPath(context, start, goal, path);
+    benchmark::DoNotOptimize(result);
+  }
+  state.counters["expanded"] = result.num_expanded;
+  state.counters["cost"] = result.cost;
+  state.counters["cells_per_second"] = benchmark::Counter(
+      result.num_expanded, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_FindWeightedPath)
+    ->Apply(WeightedMapArguments)
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * The same query as BM_FindPath with a search put together from fixed
+ * policies. AStarSearch makes its choices at every cell, like the step by
+ * step Pathfinder, while UniformBucketSearch has them all made at compile
+ * time.
+ */
+template <typename Search>
+void BM_BasicSearch(benchmark::State& state) {
+  GridMap map = MakeBenchmarkMap(state);
+  SearchContext context = SearchContext(map);
+  std::vector<CellIndex>& path = context.GetPathBuffer();
+  CellIndex start = map.GetIndex(0, 0);
+  CellIndex goal = map.GetIndex(map.GetNumRows() - 1, map.GetNumCols() - 1);
+
+  SearchResult result = SearchResult();
+  for (auto _ : state) {
+    result = Search(context).FindPath(start, goal, path);
+    benchmark::DoNotOptimize(result);
+  }
+  state.counters["expanded"] = result.num_expanded;
+  state.counters["cells_per_second"] = benchmark::Counter(
+      result.num_expanded, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK_TEMPLATE(BM_BasicSearch, pathfinder::AStarSearch)
+    ->Apply(MapArguments)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BasicSearch, CheckedBucketSearch)
+    ->Apply(MapArguments)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BasicSearch, UniformBucketSearch)
+    ->Apply(MapArguments)
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * The same query as BM_FindPath moving in 8 directions without cutting
+ * corners, guided by the octile distance
+ */
+void BM_FindOctilePath(benchmark::State& state) {
+  typedef pathfinder::EightConnected<pathfinder::CornerCutting::kNever>
+      Connectivity;
+  GridMap map = MakeBenchmarkMap(state);
+  SearchContext context = SearchContext(map);
+  std::vector<CellIndex>& path = context.GetPathBuffer();
+  CellIndex start = map.GetIndex(0, 0);
+  CellIndex goal = map.GetIndex(map.GetNumRows() - 1, map.GetNumCols() - 1);
+
+  SearchResult result = SearchResult();
+  for (auto _ : state) {
+    result = pathfinder::FindPath<Connectivity>(context, start, goal, path);
+    benchmark::DoNotOptimize(result);
+  }
+  state.counters["expanded"] = result.num_expanded;
+  state.counters["path_length"] = result.path_length;
+  state.counters["cells_per_second"] = benchmark::Counter(
+      result.num_expanded, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_FindOctilePath)
+    ->Apply(MapArguments)
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * The same query as BM_FindPath with bidirectional A*. The second argument
+ * picks whether the backward direction runs on its own thread.
+ */
+void BM_FindBidirectionalPath(benchmark::State& state) {
+  GridMap map = MakeBenchmarkMap(state);
+  SearchContext forward = SearchContext(map);
+  SearchContext backward = SearchContext(map);
+  std::vector<CellIndex>& path = forward.GetPathBuffer();
+  CellIndex start = map.GetIndex(0, 0);
+  CellIndex goal = map.GetIndex(map.GetNumRows() - 1, map.GetNumCols() - 1);
+  bool concurrent = state.range(2) != 0;
+
+  SearchResult result = SearchResult();
+  for (auto _ : state) {
+    result = pathfinder::FindBidirectionalPath(forward, backward, start, goal,
+                                               path, concurrent);
+    benchmark::DoNotOptimize(result);
+  }
+  state.counters["expanded"] = result.num_expanded;
+  state.counters["path_length"] = result.path_length;
+}
+BENCHMARK(BM_FindBidirectionalPath)
+    ->Apply(ThreadedMapArguments)
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * The same query as BM_FindPath with jump point search, scanning the map for
+ * jump points
+ */
+void BM_FindJumpPointPath(benchmark::State& state) {
+  GridMap map = MakeBenchmarkMap(state);
+  SearchContext context = SearchContext(map);
+  std::vector<CellIndex>& path = context.GetPathBuffer();
+  CellIndex start = map.GetIndex(0, 0);
+  CellIndex goal = map.GetIndex(map.GetNumRows() - 1, map.GetNumCols() - 1);
+
+  SearchResult result = SearchResult();
+  for (auto _ : state) {
+    result = pathfinder::FindJumpPointPath(context, start, goal, path);
+    benchmark::DoNotOptimize(result);
+  }
+  state.counters["expanded"] = result.num_expanded;
+  state.counters["path_length"] = result.path_length;
+}
+BENCHMARK(BM_FindJumpPointPath)
+    ->Apply(MapArguments)
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * The same query with JPS+, looking jump points up in a JumpTable. Building
+ * the table is not timed.
+ */
+void BM_FindJumpPointPlusPath(benchmark::State& state) {
+  GridMap map = MakeBenchmarkMap(state);
+  SearchContext context = SearchContext(map);
+  std::vector<CellIndex>& path = context.GetPathBuffer();
+  pathfinder::JumpTable table;
+  table.Build(map);
+  CellIndex start = map.GetIndex(0, 0);
+  CellIndex goal = map.GetIndex(map.GetNumRows() - 1, map.GetNumCols() - 1);
+
+  SearchResult result = SearchResult();
+  for (auto _ : state) {
+    result = pathfinder::FindJumpPointPath(context, start, goal, path, &table);
+    benchmark::DoNotOptimize(result);
+  }
+  state.counters["expanded"] = result.num_expanded;
+  state.counters["path_length"] = result.path_length;
+}
+BENCHMARK(BM_FindJumpPointPlusPath)
+    ->Apply(MapArguments)
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * Building the JPS+ table for a whole map
+ */
+void BM_BuildJumpTable(benchmark::State& state) {
+  GridMap map = MakeBenchmarkMap(state);
+  pathfinder::JumpTable table;
+  for (auto _ : state) {
+    table.Build(map);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * map.GetNumCells());
+}
+BENCHMARK(BM_BuildJumpTable)
+    ->Apply(MapArguments)
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * A flow field towards the bottom right corner, which every cell can follow
+ * to get there. The last argument is the number of threads.
+ */
+void BM_BuildFlowField(benchmark::State& state) {
+  GridMap map = MakeBenchmarkMap(state);
+  FlowField field(state.range(2));
+  std::vector<CellIndex> goals = {
+      map.GetIndex(map.GetNumRows() - 1, map.GetNumCols() - 1)};
+  for (auto _ : state) {
+    field.Build(map, goals);
+    benchmark::ClobberMemory();
+  }
+  state.counters["max_distance"] = field.GetMaxDistance();
+  state.SetItemsProcessed(state.iterations() * map.GetNumCells());
+}
+BENCHMARK(BM_BuildFlowField)
+    ->Apply(PoolMapArguments)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+/**
+ * Following a flow field from the top left corner to the bottom right one,
+ * which is what each unit does instead of running BM_FindPath. Building the
+ * field is not timed.
+ */
+void BM_FollowFlowField(benchmark::State& state) {
+  GridMap map = MakeBenchmarkMap(state);
+  FlowField field(1);
+  field.Build(map, {map.GetIndex(map.GetNumRows() - 1, map.GetNumCols() - 1)});
+  std::vector<CellIndex> path;
+  path.reserve(map.GetNumCells());
+  for (auto _ : state) {
+    field.GetPath(map.GetIndex(0, 0), path);
+    benchmark::DoNotOptimize(path.data());
+  }
+  state.counters["path_length"] = path.size();
+}
+BENCHMARK(BM_FollowFlowField)
+    ->Apply(MapArguments)
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * The same query as BM_FindPath with H costs from landmark distances as well
+ * as the Manhattan distance. Building the landmarks is not timed.
+ */
+void BM_FindLandmarkPath(benchmark::State& state) {
+  GridMap map = MakeBenchmarkMap(state);
+  SearchContext context = SearchContext(map);
+  std::vector<CellIndex>& path = context.GetPathBuffer();
+  LandmarkTable table;
+  table.Build(map);
+  context.SetLandmarks(&table);
+  CellIndex start = map.GetIndex(0, 0);
+  CellIndex goal = map.GetIndex(map.GetNumRows() - 1, map.GetNumCols() - 1);
+
+  SearchResult result = SearchResult();
+  for (auto _ : state) {
+    result = pathfinder::FindPath(context, start, goal, path);
+    benchmark::DoNotOptimize(result);
+  }
+  state.counters["expanded"] = result.num_expanded;
+  state.counters["path_length"] = result.path_length;
+}
+BENCHMARK(BM_FindLandmarkPath)
+    ->Apply(LandmarkMapArguments)
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * Picking the default number of landmarks and finding their distances to
+ * every cell
+ */
+void BM_BuildLandmarks(benchmark::State& state) {
+  GridMap map = MakeBenchmarkMap(state);
+  LandmarkTable table;
+  for (auto _ : state) {
+    table.Build(map);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * map.GetNumCells());
+}
+BENCHMARK(BM_BuildLandmarks)
+    ->Apply(LandmarkMapArguments)
+    ->Unit(benchmark::kMillisecond);
+
+/**
+ * The same query with HPA*, searching the entrances of the clusters and then
+ * filling in the route through each one. Building the clusters is not timed.
+ */
+void BM_FindHierarchicalPath(benchmark::State& state) {
+  GridMap map = MakeBenchmarkMap(state);
+  HierarchicalMap hierarchy(map);
+  std::vector<CellIndex> path;
+  CellIndex start = map.GetIndex(0, 0);
+  CellIndex goal = map.GetIndex(map.GetNumRows() - 1, map.GetNumCols() - 1);
+
+  SearchResult result = SearchResult();
+  for (auto _ : state) {
+    result = hierarchy.FindPath(start, goal, path);
+    benchmark::DoNotOptimize(result);
+  }
+  state.counters["expanded"] = result.num_expanded;
+  state.counters["path_length"] = result.path_length;
+  state.counters["entrances"] = hierarchy.GetNumEntrances();
+}
+BENCHMARK(BM_FindHierarchicalPath)
+    ->Apply(MapArguments)
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * Toggling a wall in the middle of the map and updating the clusters around
+ * it, compared to rebuilding every cluster in BM_RebuildHierarchicalMap
+ */
+void BM_UpdateHierarchicalMap(benchmark::State& state) {
+  GridMap map = MakeBenchmarkMap(state);
+  HierarchicalMap hierarchy(map);
+  std::vector<CellIndex> cells = {
+      map.GetIndex(map.GetNumRows() / 2, map.GetNumCols() / 2)};
+
+  for (auto _ : state) {
+    map.SetPassable(cells[0], !map.IsPassable(cells[0]));
+    hierarchy.UpdateCells(cells);
+    benchmark::ClobberMemory();
+  }
+  state.counters["rebuilt_clusters"] = hierarchy.GetNumRebuiltClusters();
+}
+BENCHMARK(BM_UpdateHierarchicalMap)
+    ->Apply(MapArguments)
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * Building the clusters of a whole map
+ */
+void BM_RebuildHierarchicalMap(benchmark::State& state) {
+  GridMap map = MakeBenchmarkMap(state);
+  HierarchicalMap hierarchy(map);
+  for (auto _ : state) {
+    hierarchy.Rebuild();
+    benchmark::ClobberMemory();
+  }
+  state.counters["clusters"] = hierarchy.GetNumClusters();
+}
+BENCHMARK(BM_RebuildHierarchicalMap)
+    ->Apply(MapArguments)
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * Repairing a D* Lite search after a wall is toggled on the middle of the
+ * path between the corners, compared to searching from scratch in
+ * BM_FindPath. The first search is not timed.
+ */
+void BM_Replan(benchmark::State& state) {
+  GridMap map = MakeBenchmarkMap(state);
+  Replanner replanner(map);
+  std::vector<CellIndex> path;
+  CellIndex start = map.GetIndex(0, 0);
+  CellIndex goal = map.GetIndex(map.GetNumRows() - 1, map.GetNumCols() - 1);
+  replanner.Reset(start, goal);
+  replanner.FindPath(path);
+  std::vector<CellIndex> cells = {path[path.size() / 2]};
+
+  SearchResult result = SearchResult();
+  size_t num_touched = 0;
+  for (auto _ : state) {
+    map.SetPassable(cells[0], !map.IsPassable(cells[0]));
+    replanner.UpdateCells(cells);
+    result = replanner.FindPath(path);
+    num_touched += replanner.GetNumTouched();
+    benchmark::DoNotOptimize(result);
+  }
+  state.counters["expanded"] = result.num_expanded;
+  state.counters["touched"] = benchmark::Counter(
+      num_touched, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_Replan)->Apply(MapArguments)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Scanning every row of the map from its first cell, then every column from
+ * its first cell
+ */
+void BM_ScanLine(benchmark::State& state) {
+  GridMap map = MakeBenchmarkMap(state);
+  size_t num_rows = map.GetNumRows();
+  size_t num_cols = map.GetNumCols();
+
+  for (auto _ : state) {
+    int total = 0;
+    for (size_t row = 0; row < num_rows; row++) {
+      total += pathfinder::ScanLine(map, map.GetIndex(row, 0),
+                                    pathfinder::kRight);
+    }
+    for (size_t col = 0; col < num_cols; col++) {
+      total += pathfinder::ScanLine(map, map.GetIndex(0, col),
+                                    pathfinder::kDown);
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * (num_rows + num_cols));
+}
+BENCHMARK(BM_ScanLine)->Apply(MapArguments)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Expanding every open cell of the map once, which is the inner loop of a
+ * search without the open set pops in between
+ */
+void BM_FindNeighbors(benchmark::State& state) {
+  GridMap map = MakeBenchmarkMap(state);
+  SearchContext context = SearchContext(map);
+  std::vector<CellIndex> open_cells;
+  for (CellIndex index = 0; index < map.GetNumCells(); index++) {
+    if (map.IsPassable(index)) {
+      open_cells.push_back(index);
+    }
+  }
+  CellIndex goal = map.GetIndex(map.GetNumRows() - 1, map.GetNumCols() - 1);
+
+  for (auto _ : state) {
+    pathfinder::StartSearch(context, open_cells[0], goal);
+    for (CellIndex current : open_cells) {
+      pathfinder::FindNeighbors(context, current, goal);
+    }
+    benchmark::DoNotOptimize(context.GetOpenSet().Size());
+  }
+  state.SetItemsProcessed(state.iterations() * open_cells.size());
+}
+BENCHMARK(BM_FindNeighbors)->Apply(MapArguments)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Walking the parents of a finished search back from the goal
+ */
+void BM_ReconstructPath(benchmark::State& state) {
+  GridMap map = MakeBenchmarkMap(state);
+  SearchContext context = SearchContext(map);
+  std::vector<CellIndex>& path = context.GetPathBuffer();
+  CellIndex start = map.GetIndex(0, 0);
+  CellIndex goal = map.GetIndex(map.GetNumRows() - 1, map.GetNumCols() - 1);
+  if (!pathfinder::FindPath(context, start, goal, path).found) {
+    state.SkipWithError("No path between the corners");
+    return;
+  }
+
+  size_t length = 0;
+  for (auto _ : state) {
+    length = pathfinder::ReconstructPath(context.GetState(), start, goal, path);
+    benchmark::DoNotOptimize(path.data());
+  }
+  state.SetItemsProcessed(state.iterations() * length);
+}
+BENCHMARK(BM_ReconstructPath)
+    ->Apply(MapArguments)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "core/grid_map.h"
+#include "core/pathfinder.h"
+#include "core/spsc_ring_buffer.h"
+
+namespace pathfinder {
+
+/**
+ * Something a BackgroundSearch has done, in the order it was done
+ */
+struct SearchEvent {
+  enum class Type : uint8_t {
+    // The search moved to cell, as Pathfinder::FindNextCell would
+    kExpand,
+
+    // cell is the next cell of the path, which is sent from the start to the
+    // goal once it has been found
+    kPath,
+
+    // The search is over. cell is the goal if a path was found, or kNoCell
+    // if there is none.
+    kFinished
+  };
+
+  Type type;
+  CellIndex cell;
+};
+
+/**
+ * Runs a step by step Pathfinder on its own thread, so that how fast a
+ * search finishes doesn't depend on how often it is drawn. Every step is
+ * sent to the thread that started the search through a lock-free ring
+ * buffer, and that thread takes as many as it has time for with Poll.
+ *
+ * The search runs on a copy of the map, so the map can be edited while it
+ * runs. When the buffer is full the search waits for the consumer, so it
+ * never gets more than the buffer's capacity ahead of what has been shown.
+ */
+class BackgroundSearch {
+ public:
+  /**
+   * Constructor for a BackgroundSearch that isn't running
+   * @param capacity The most events that can be waiting to be polled
+   */
+  explicit BackgroundSearch(size_t capacity = kDefaultCapacity);
+
+  /**
+   * Stops and joins the search thread
+   */
+  ~BackgroundSearch();
+
+  BackgroundSearch(const BackgroundSearch&) = delete;
+  BackgroundSearch& operator=(const BackgroundSearch&) = delete;
+
+  /**
+   * Stops the search that is running, if any, and starts a new one. Events
+   * from the old search that haven't been polled are dropped. The jump table
+   * and landmarks the mode needs are built on the search thread.
+   * @param map The map to search, which is copied
+   * @param start The cell the search starts from
+   * @param goal The cell the search is trying to reach
+   * @param mode How the pathfinder expands cells
+   * @param use_landmarks Whether H costs are estimated with landmarks
+   */
+  void Start(const GridMap& map, CellIndex start, CellIndex goal,
+             SearchMode mode, bool use_landmarks);
+
+  /**
+   * Stops the search that is running, if any, and waits for its thread
+   */
+  void Stop();
+
+  /**
+   * Takes the oldest event that hasn't been polled. Only the thread that
+   * started the search may call this.
+   * @param event Set to the event taken
+   * @return false if no event is waiting
+   */
+  bool Poll(SearchEvent& event);
+
+ private:
+  // Enough events for a few frames of a fast search
+  static const size_t kDefaultCapacity = 1 << 16;
+
+  /**
+   * Loop run by the search thread
+   */
+  void Run();
+
+  /**
+   * Helper method that waits until there is room for an event and sends it
+   * @return false if the search was stopped while waiting
+   */
+  bool Send(SearchEvent::Type type, CellIndex cell);
+
+  SpscRingBuffer<SearchEvent> events_;
+  std::thread thread_;
+  std::atomic<bool> stopping_;
+
+  // Only used by the search thread while it runs
+  GridMap map_;
+  Pathfinder pathfinder_;
+  CellIndex start_ = kNoCell;
+  CellIndex goal_ = kNoCell;
+  SearchMode mode_ = SearchMode::kAStar;
+  bool use_landmarks_ = false;
+};
+
+}  // namespace pathfinder
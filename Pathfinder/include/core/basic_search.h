@@ -0,0 +1,321 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "core/bucket_queue.h"
+#include "core/connectivity.h"
+#include "core/grid_map.h"
+#include "core/open_set.h"
+#include "core/search.h"
+#include "core/search_context.h"
+#include "core/search_trace.h"
+
+namespace pathfinder {
+
+/**
+ * Heuristic policy that estimates H costs with a connectivity's own distance,
+ * which is exact on an open map
+ * @tparam Connectivity The connectivity whose Distance is used
+ */
+template <typename Connectivity>
+struct DistanceHeuristic {
+  /**
+   * Method that estimates the cost of the cheapest route between two cells
+   */
+  static int Estimate(const SearchContext& context, CellIndex from,
+                      CellIndex to);
+};
+
+/**
+ * The H cost for searches along edges
+ */
+typedef DistanceHeuristic<FourConnected> ManhattanHeuristic;
+
+/**
+ * The H cost for searches that step diagonally. The octile distance is the
+ * same whichever corners can be cut.
+ */
+typedef DistanceHeuristic<EightConnected<CornerCutting::kNever>>
+    OctileHeuristic;
+
+/**
+ * Heuristic policy that uses the Manhattan distance, or the ALT lower bound
+ * from the context's landmarks when there are landmarks and it is larger.
+ * Landmark distances count straight steps, so this only suits FourConnected.
+ */
+struct LandmarkHeuristic {
+  /**
+   * Method that estimates the cost of the cheapest route between two cells
+   */
+  static int Estimate(const SearchContext& context, CellIndex from,
+                      CellIndex to);
+};
+
+/**
+ * Cost model policy where stepping onto any cell costs the same. The costs
+ * set on the map are ignored, so the step costs fold into constants.
+ */
+struct UniformCost {
+  /**
+   * Getter method for what stepping onto a cell costs, on top of the step
+   */
+  static int GetCost(const GridMap& map, CellIndex index);
+
+  /**
+   * Getter method that returns an upper bound on GetCost
+   */
+  static int GetMaxCost(const GridMap& map);
+};
+
+/**
+ * Cost model policy where stepping onto a cell costs what the map says
+ */
+struct CellCost {
+  /**
+   * Getter method for what stepping onto a cell costs, on top of the step
+   */
+  static int GetCost(const GridMap& map, CellIndex index);
+
+  /**
+   * Getter method that returns an upper bound on GetCost
+   */
+  static int GetMaxCost(const GridMap& map);
+};
+
+/**
+ * An A* search put together from policies at compile time, so the compiler
+ * can inline every call in the loop that expands cells and fold away the
+ * choices that don't apply. It works on a SearchContext's state and on the
+ * context's queue of the chosen type, and keeps no state of its own, so it
+ * is cheap to make one for each call.
+ *
+ * A step onto a neighbor costs the connectivity's step cost times the cost
+ * model's cost for the neighbor.
+ * @tparam Heuristic How H costs are estimated, which must never overestimate
+ * and may change by at most the cost of a step from one cell to the next
+ * @tparam Connectivity Which cells are one step apart, and the step costs
+ * @tparam Queue The queue the cells waiting to be expanded are kept in,
+ * either OpenSet or BucketQueue
+ * @tparam CostModel What stepping onto a cell costs
+ */
+template <typename Heuristic, typename Connectivity, typename Queue,
+          typename CostModel>
+class BasicSearch {
+ public:
+  /**
+   * Constructor for a search that runs in the given context
+   */
+  explicit BasicSearch(SearchContext& context);
+
+  /**
+   * Forgets the context's previous search and puts start into the queue
+   * @param start The cell the search starts from
+   * @param goal The cell the search is trying to reach
+   */
+  void Start(CellIndex start, CellIndex goal);
+
+  /**
+   * Records a route to a cell, putting it into the queue or lowering its G
+   * cost if it is already queued and the new route is cheaper
+   * @param cell The cell that has been reached, which must not be closed
+   * @param parent The cell it was reached from
+   * @param g_cost The cost of the route to the cell through parent
+   * @param goal The cell the search is trying to reach
+   */
+  void Open(CellIndex cell, CellIndex parent, int g_cost, CellIndex goal);
+
+  /**
+   * Opens every neighbor of a cell that isn't closed
+   * @param current The cell being expanded
+   * @param goal The cell the search is trying to reach
+   */
+  void Expand(CellIndex current, CellIndex goal);
+
+  /**
+   * Runs the whole search from start to goal
+   * @param start The cell the path starts from
+   * @param goal The cell the path has to reach
+   * @param path Filled with the cells of the path from start to goal, or left
+   * empty if there is no path
+   * @return Whether a path was found, its cost and the number of expanded
+   * cells
+   */
+  SearchResult FindPath(CellIndex start, CellIndex goal,
+                        std::vector<CellIndex>& path);
+
+ private:
+  /**
+   * Helper methods that empty a queue for a new search. The bucket queue
+   * also needs to know how far apart the F costs in it can be.
+   */
+  static void ResetQueue(OpenSet& queue, const GridMap& map);
+  static void ResetQueue(BucketQueue& queue, const GridMap& map);
+
+  SearchContext& context_;
+  const GridMap& map_;
+  SearchState& state_;
+  Queue& queue_;
+};
+
+/**
+ * The search every part of the library used before searches were put
+ * together from policies, and the one the step by step Pathfinder and the
+ * FindNeighbors, OpenCell and StartSearch functions still run: edges only,
+ * landmarks when the context has them, the map's cell costs and the heap.
+ * Its choices are made at run time, for each cell, by checking whether there
+ * are landmarks and costs.
+ */
+typedef BasicSearch<LandmarkHeuristic, FourConnected, OpenSet, CellCost>
+    AStarSearch;
+
+template <typename Connectivity>
+inline int DistanceHeuristic<Connectivity>::Estimate(
+    const SearchContext& context, CellIndex from, CellIndex to) {
+  return Connectivity::Distance(context.GetMap(), from, to);
+}
+
+inline int LandmarkHeuristic::Estimate(const SearchContext& context,
+                                       CellIndex from, CellIndex to) {
+  int h_cost = FourConnected::Distance(context.GetMap(), from, to);
+  const LandmarkTable* landmarks = context.GetLandmarks();
+  if (landmarks != nullptr) {
+    h_cost = std::max(h_cost, landmarks->GetLowerBound(from, to));
+  }
+  return h_cost;
+}
+
+inline int UniformCost::GetCost(const GridMap& /*map*/,
+                                 CellIndex /*index*/) {
+  return 1;
+}
+
+inline int UniformCost::GetMaxCost(const GridMap& /*map*/) {
+  return 1;
+}
+
+inline int CellCost::GetCost(const GridMap& map, CellIndex index) {
+  return map.GetCost(index);
+}
+
+inline int CellCost::GetMaxCost(const GridMap& map) {
+  return map.GetMaxCost();
+}
+
+template <typename Heuristic, typename Connectivity, typename Queue,
+          typename CostModel>
+inline BasicSearch<Heuristic, Connectivity, Queue, CostModel>::BasicSearch(
+    SearchContext& context)
+    : context_(context),
+      map_(context.GetMap()),
+      state_(context.GetState()),
+      queue_(context.GetQueue<Queue>()) {
+}
+
+template <typename Heuristic, typename Connectivity, typename Queue,
+          typename CostModel>
+inline void BasicSearch<Heuristic, Connectivity, Queue, CostModel>::Start(
+    CellIndex start, CellIndex goal) {
+  context_.Reset();
+  ResetQueue(queue_, map_);
+  int h_cost = Heuristic::Estimate(context_, start, goal);
+  state_.Visit(start, 0, kNoCell);
+  queue_.Push(start, h_cost, h_cost);
+  PATHFINDER_TRACE_EVENT(context_, kStart, start, 0);
+  PATHFINDER_TRACE_EVENT(context_, kGoal, goal, 0);
+  PATHFINDER_TRACE_EVENT(context_, kPush, start, h_cost);
+}
+
+template <typename Heuristic, typename Connectivity, typename Queue,
+          typename CostModel>
+inline void BasicSearch<Heuristic, Connectivity, Queue, CostModel>::Open(
+    CellIndex cell, CellIndex parent, int g_cost, CellIndex goal) {
+  // Every visited cell that isn't closed is in the queue
+  if (state_.IsVisited(cell)) {
+    if (g_cost < state_.GetGCost(cell)) {
+      state_.Visit(cell, g_cost, parent);
+      int h_cost = Heuristic::Estimate(context_, cell, goal);
+      queue_.DecreaseKey(cell, g_cost + h_cost, h_cost);
+      PATHFINDER_TRACE_EVENT(context_, kDecreaseKey, cell, g_cost + h_cost);
+    }
+  } else {
+    state_.Visit(cell, g_cost, parent);
+    int h_cost = Heuristic::Estimate(context_, cell, goal);
+    queue_.Push(cell, g_cost + h_cost, h_cost);
+    PATHFINDER_TRACE_EVENT(context_, kPush, cell, g_cost + h_cost);
+  }
+}
+
+template <typename Heuristic, typename Connectivity, typename Queue,
+          typename CostModel>
+inline void BasicSearch<Heuristic, Connectivity, Queue, CostModel>::Expand(
+    CellIndex current, CellIndex goal) {
+  int g_cost = state_.GetGCost(current);
+  Connectivity::ForEachNeighbor(
+      map_, current, [&](CellIndex neighbor, int step_cost) {
+        if (!state_.IsClosed(neighbor)) {
+          Open(neighbor, current,
+               g_cost + step_cost * CostModel::GetCost(map_, neighbor), goal);
+        }
+      });
+}
+
+template <typename Heuristic, typename Connectivity, typename Queue,
+          typename CostModel>
+SearchResult BasicSearch<Heuristic, Connectivity, Queue, CostModel>::FindPath(
+    CellIndex start, CellIndex goal, std::vector<CellIndex>& path) {
+  SearchResult result;
+  result.found = false;
+  result.cost = 0;
+  result.path_length = 0;
+  result.num_expanded = 0;
+  path.clear();
+  if (!map_.IsPassable(start) || !map_.IsPassable(goal)) {
+    return result;
+  }
+
+  Start(start, goal);
+  while (!queue_.Empty()) {
+    CellIndex current = queue_.Pop();
+    state_.Close(current);
+    PATHFINDER_TRACE_EVENT(context_, kPop, current, state_.GetGCost(current));
+    if (current == goal) {
+      result.found = true;
+      break;
+    }
+    Expand(current, goal);
+    result.num_expanded++;
+  }
+
+  if (!result.found) {
+    return result;
+  }
+  result.cost = state_.GetGCost(goal);
+  result.path_length = ReconstructPath(state_, start, goal, path);
+#ifdef PATHFINDER_TRACE
+  for (size_t i = 0; i < path.size(); i++) {
+    PATHFINDER_TRACE_EVENT(context_, kPath, path[i],
+                           state_.GetGCost(path[i]));
+  }
+#endif
+  return result;
+}
+
+template <typename Heuristic, typename Connectivity, typename Queue,
+          typename CostModel>
+inline void BasicSearch<Heuristic, Connectivity, Queue, CostModel>::ResetQueue(
+    OpenSet& /*queue*/, const GridMap& /*map*/) {
+  // SearchContext::Reset has already emptied the open set
+}
+
+template <typename Heuristic, typename Connectivity, typename Queue,
+          typename CostModel>
+inline void BasicSearch<Heuristic, Connectivity, Queue, CostModel>::ResetQueue(
+    BucketQueue& queue, const GridMap& map) {
+  // A step raises the F cost by at most its own cost plus the most the H cost
+  // can change in one step, which is the step's cost before the cell's cost
+  queue.Reset(map.GetNumCells(),
+              Connectivity::kMaxStepCost * (CostModel::GetMaxCost(map) + 1));
+}
+
+}  // namespace pathfinder
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/grid_map.h"
+#include "core/search.h"
+#include "core/search_context.h"
+
+namespace pathfinder {
+
+/**
+ * A single start/goal pair to be solved by a BatchSolver
+ */
+struct Query {
+  CellIndex start;
+  CellIndex goal;
+};
+
+/**
+ * Solves many independent queries against one map on a pool of worker
+ * threads. The map is shared read-only, and every worker has its own
+ * SearchContext so queries never contend on search state.
+ *
+ * Each worker starts with an equal, contiguous share of the batch and takes
+ * small chunks from the front of it. A worker that runs out steals the back
+ * half of another worker's remaining share, so uneven query costs still keep
+ * every thread busy. Results are written by query index and every query is
+ * solved the same way on any thread, so the output does not depend on the
+ * number of threads.
+ */
+class BatchSolver {
+ public:
+  /**
+   * Constructor for a BatchSolver. The map is not copied, so it has to outlive
+   * the solver and must not change while a batch is being solved.
+   * @param map The map every query is solved on
+   * @param num_threads The number of threads to solve with, including the one
+   * calling Solve. 0 uses one thread per hardware thread.
+   */
+  explicit BatchSolver(const GridMap& map, size_t num_threads = 0);
+
+  /**
+   * Stops and joins the worker threads
+   */
+  ~BatchSolver();
+
+  BatchSolver(const BatchSolver&) = delete;
+  BatchSolver& operator=(const BatchSolver&) = delete;
+
+  /**
+   * Getter method that returns the number of threads queries are solved on
+   */
+  size_t GetNumThreads() const;
+
+  /**
+   * Solves every query, blocking until the whole batch is done
+   * @param queries The queries to solve
+   * @param results Resized to match queries, with results[i] holding the
+   * result of queries[i]
+   */
+  void Solve(const std::vector<Query>& queries,
+             std::vector<SearchResult>& results);
+
+ private:
+  /**
+   * The part of the current batch that a worker has not started yet
+   */
+  struct WorkRange {
+    std::mutex mutex;
+    size_t begin = 0;
+    size_t end = 0;
+  };
+
+  // Number of queries a worker takes from its own range at a time
+  static const size_t kChunkSize = 16;
+
+  /**
+   * Loop run by each background thread, which waits for a batch, helps solve
+   * it and goes back to waiting
+   */
+  void WorkerLoop(size_t worker);
+
+  /**
+   * Helper method that solves queries until there are none left to take
+   */
+  void SolveQueries(size_t worker);
+
+  /**
+   * Helper method that hands a worker its next chunk of queries, stealing
+   * from other workers once its own range is empty
+   * @return false if every range is empty
+   */
+  bool TakeWork(size_t worker, size_t& begin, size_t& end);
+
+  const GridMap& map_;
+  std::vector<std::unique_ptr<SearchContext>> contexts_;
+  std::vector<std::unique_ptr<WorkRange>> ranges_;
+  std::vector<std::thread> threads_;
+
+  // The batch currently being solved
+  const std::vector<Query>* queries_ = nullptr;
+  std::vector<SearchResult>* results_ = nullptr;
+
+  std::mutex mutex_;
+  std::condition_variable batch_started_;
+  std::condition_variable batch_finished_;
+  size_t batch_number_ = 0;
+  size_t num_busy_threads_ = 0;
+  bool stopping_ = false;
+};
+
+}  // namespace pathfinder
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <climits>
+#include <cstddef>
+#include <vector>
+
+#include "core/grid_map.h"
+#include "core/search.h"
+#include "core/search_context.h"
+#include "core/search_state.h"
+
+namespace pathfinder {
+
+/**
+ * The cheapest route found so far by a bidirectional search, through a cell
+ * that both directions have reached
+ */
+struct Meeting {
+  // The cell where the two halves of the route join, or kNoCell if the
+  // directions haven't met yet
+  CellIndex cell = kNoCell;
+
+  // The G cost of the cell from the start plus its G cost from the goal
+  int cost = INT_MAX;
+};
+
+/**
+ * Expands a cell for one direction of a bidirectional search. Neighbors are
+ * opened the same way as FindNeighbors does, and every neighbor whose G cost
+ * went down is also added to reached, so that it can be checked against the
+ * other direction.
+ * @param context The direction the cell belongs to
+ * @param current The cell being expanded, which has to be closed already
+ * @param target The cell this direction is searching towards
+ * @param backward Whether this direction searches from the goal, whose steps
+ * are walked in reverse and so cost what the cell being left costs
+ * @param reached The cells whose G cost changed are appended to this
+ */
+void ExpandFrontier(SearchContext& context, CellIndex current, CellIndex target,
+                    bool backward, std::vector<CellIndex>& reached);
+
+/**
+ * Checks cells that one direction has just reached against the cells the
+ * other direction has reached, keeping the cheapest route through any of
+ * them
+ * @param context The direction the cells were reached by
+ * @param other The opposite direction
+ * @param reached The cells to check
+ * @param meeting Updated if a route through one of the cells is cheaper
+ */
+void MeetFrontiers(const SearchContext& context, const SearchContext& other,
+                   const std::vector<CellIndex>& reached, Meeting& meeting);
+
+/**
+ * Checks whether a bidirectional search can stop. That is once either open
+ * set is empty, or once the directions have met and every cell left on one
+ * of the open sets has an F cost at least the cost of the meeting. The H cost
+ * never overestimates, so no route through those cells can be cheaper.
+ * @param forward The direction searching from the start to the goal
+ * @param backward The direction searching from the goal to the start
+ * @param meeting The cheapest route found so far
+ * @return true if meeting is a shortest path, or if there is no path at all
+ * when it is still empty
+ */
+bool FrontiersAreDone(const SearchContext& forward,
+                      const SearchContext& backward, const Meeting& meeting);
+
+/**
+ * Joins the two halves of a route found by a bidirectional search
+ * @param forward The state of the direction that started from start
+ * @param backward The state of the direction that started from goal
+ * @param start The cell the path starts from
+ * @param goal The cell the path has to reach
+ * @param meeting The cell the halves join at
+ * @param path Replaced with the cells of the path from start to goal
+ * @return The number of cells in the path
+ */
+size_t ReconstructBidirectionalPath(const SearchState& forward,
+                                    const SearchState& backward,
+                                    CellIndex start, CellIndex goal,
+                                    CellIndex meeting,
+                                    std::vector<CellIndex>& path);
+
+/**
+ * Finds the shortest path between two cells with A* running from both ends
+ * at once, which expands fewer cells than FindPath on maps where the search
+ * can't head straight for the goal. The direction with the smaller open set
+ * is expanded next, and the search stops as soon as the cheapest route where
+ * they meet can't be beaten.
+ *
+ * When concurrent is true the backward direction runs on a second thread.
+ * The directions expand a batch of cells each and then wait for each other
+ * before their frontiers are compared, so neither reads the other's state
+ * while it is being written. Starting the thread costs more than a short
+ * search does, so this only pays off for long searches.
+ * @param forward The scratch space for the direction from the start
+ * @param backward The scratch space for the direction from the goal, which
+ * has to be for the same map
+ * @param start The cell the path starts from
+ * @param goal The cell the path has to reach
+ * @param path Filled with the cells of the path from start to goal, or left
+ * empty if there is no path
+ * @param concurrent Whether to run the backward direction on its own thread
+ * @return Whether a path was found, its cost and the number of cells
+ * expanded in both directions
+ */
+SearchResult FindBidirectionalPath(SearchContext& forward,
+                                   SearchContext& backward, CellIndex start,
+                                   CellIndex goal, std::vector<CellIndex>& path,
+                                   bool concurrent = false);
+
+}  // namespace pathfinder
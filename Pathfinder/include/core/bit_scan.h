@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+
+#include "core/grid_map.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace pathfinder {
+
+/**
+ * Counts the zero bits below the lowest set bit of a word
+ * @param word A word with at least one bit set
+ */
+int CountTrailingZeros(uint64_t word);
+
+/**
+ * Counts the zero bits above the highest set bit of a word
+ * @param word A word with at least one bit set
+ */
+int CountLeadingZeros(uint64_t word);
+
+/**
+ * Moves from a cell in a straight line, 64 cells at a time, until it reaches
+ * a wall or a cell with a forced neighbor: a cell beside the line that is open
+ * while the cell beside the previous one is a wall. Each word of the line is
+ * checked for both at once with a few shifts and masks, and the first one is
+ * found with a single count of trailing or leading zeros.
+ * @param map The map being scanned
+ * @param from The cell the scan starts from, which is not itself considered
+ * @param direction The direction to scan in
+ * @return The number of steps to the first cell with a forced neighbor if it
+ * is positive. Otherwise a wall or the edge of the map comes first, and the
+ * negated value is the number of open cells before it.
+ */
+int ScanLine(const GridMap& map, CellIndex from, Direction direction);
+
+inline int CountTrailingZeros(uint64_t word) {
+#if defined(_MSC_VER)
+  unsigned long bit;
+  _BitScanForward64(&bit, word);
+  return (int)bit;
+#else
+  return __builtin_ctzll(word);
+#endif
+}
+
+inline int CountLeadingZeros(uint64_t word) {
+#if defined(_MSC_VER)
+  unsigned long bit;
+  _BitScanReverse64(&bit, word);
+  return 63 - (int)bit;
+#else
+  return __builtin_clzll(word);
+#endif
+}
+
+}  // namespace pathfinder
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "core/grid_map.h"
+
+namespace pathfinder {
+
+/**
+ * Dial's bucket queue, which holds the cells waiting to be expanded in one
+ * bucket per F cost instead of a heap, so push, pop and decrease-key are all
+ * O(1).
+ *
+ * This only works when the F costs in the queue never spread further apart
+ * than the number of buckets, which is the case for A* with small integer
+ * step costs and a heuristic that changes by at most 1 per step, like the
+ * Manhattan distance. A cell's F cost is then never lower than the F cost of
+ * the cell it was reached from, and at most the step cost plus 1 higher. The
+ * buckets are reused in a ring as the lowest F cost goes up.
+ *
+ * Each bucket is a doubly linked list threaded through arrays with an entry
+ * per cell, so nothing is allocated once the queue has been sized for a map.
+ * Cells with the same F cost come out in the opposite order they went in,
+ * which favors the cells reached last.
+ */
+class BucketQueue {
+ public:
+  /**
+   * Constructor for an empty BucketQueue, which has to be reset before use
+   */
+  BucketQueue() = default;
+
+  /**
+   * Empties the queue and sizes it for a new search. This only allocates if
+   * the number of cells changed or more buckets are needed than ever before.
+   * @param num_cells The number of cells in the map
+   * @param max_spread The largest difference there can be between the F
+   * costs of two cells in the queue
+   */
+  void Reset(size_t num_cells, int max_spread);
+
+  /**
+   * Checks whether there are any cells left to expand
+   * @return true if the queue is empty, false otherwise
+   */
+  bool Empty() const;
+
+  /**
+   * Getter method that returns the number of cells in the queue
+   */
+  size_t Size() const;
+
+  /**
+   * Adds a cell to the queue
+   * @param index The linear index of the cell, which must not be in the queue
+   * @param f_cost The F cost of the cell, which must be at most max_spread
+   * above the F cost of every cell in the queue and of the cell popped last
+   * @param h_cost Unused, but taken so the queue can stand in for an OpenSet.
+   * Ties are broken by insertion order instead of by H cost: of the cells
+   * with the same F cost, the one pushed last comes out first.
+   */
+  void Push(CellIndex index, int f_cost, int h_cost);
+
+  /**
+   * Lowers the F cost of a cell that is already in the queue
+   * @param index The linear index of the cell
+   * @param f_cost The new F cost, which must not be larger than the old one
+   * @param h_cost Unused, but taken so the queue can stand in for an OpenSet.
+   * The cell is ordered among the cells with its new F cost as if it had
+   * just been pushed.
+   */
+  void DecreaseKey(CellIndex index, int f_cost, int h_cost);
+
+  /**
+   * Removes a cell with the lowest F cost from the queue
+   * @return The linear index of the removed cell
+   */
+  CellIndex Pop();
+
+ private:
+  /**
+   * Helper method that unlinks a cell from its bucket
+   */
+  void Unlink(CellIndex index);
+
+  // The first cell of each bucket. The number of buckets is a power of two,
+  // so a cost's bucket is cost & bucket_mask_.
+  std::vector<CellIndex> heads_;
+  int bucket_mask_ = 0;
+
+  // No cell in the queue has a lower F cost than this
+  int lowest_f_cost_ = 0;
+  size_t size_ = 0;
+
+  // The F cost of every cell in the queue and its neighbors in its bucket
+  std::vector<int> f_costs_;
+  std::vector<CellIndex> next_;
+  std::vector<CellIndex> previous_;
+};
+
+inline bool BucketQueue::Empty() const {
+  return size_ == 0;
+}
+
+inline size_t BucketQueue::Size() const {
+  return size_;
+}
+
+inline void BucketQueue::Push(CellIndex index, int f_cost,
+                              int /*h_cost*/) {
+  if (size_ == 0 || f_cost < lowest_f_cost_) {
+    lowest_f_cost_ = f_cost;
+  }
+  CellIndex& head = heads_[f_cost & bucket_mask_];
+  f_costs_[index] = f_cost;
+  previous_[index] = kNoCell;
+  next_[index] = head;
+  if (head != kNoCell) {
+    previous_[head] = index;
+  }
+  head = index;
+  size_++;
+}
+
+inline void BucketQueue::DecreaseKey(CellIndex index, int f_cost, int h_cost) {
+  if (f_cost == f_costs_[index]) {
+    return;
+  }
+  Unlink(index);
+  size_--;
+  Push(index, f_cost, h_cost);
+}
+
+inline CellIndex BucketQueue::Pop() {
+  while (heads_[lowest_f_cost_ & bucket_mask_] == kNoCell) {
+    lowest_f_cost_++;
+  }
+  CellIndex index = heads_[lowest_f_cost_ & bucket_mask_];
+  Unlink(index);
+  size_--;
+  return index;
+}
+
+inline void BucketQueue::Unlink(CellIndex index) {
+  CellIndex next = next_[index];
+  CellIndex previous = previous_[index];
+  if (next != kNoCell) {
+    previous_[next] = previous;
+  }
+  if (previous != kNoCell) {
+    next_[previous] = next;
+  } else {
+    heads_[f_costs_[index] & bucket_mask_] = next;
+  }
+}
+
+}  // namespace pathfinder
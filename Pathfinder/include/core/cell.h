@@ -1,4 +1,7 @@
-#include "cinder/gl/gl.h"
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
 
 namespace pathfinder {
 
@@ -9,13 +12,34 @@ enum class CellType {
   kEnd,
 };
 
+/**
+ * The row and column of a cell. Two 16-bit coordinates cover every map up to
+ * 65536 cells a side in 4 bytes, half of what a pair of floats takes.
+ */
+struct CellPosition {
+  uint16_t row;
+  uint16_t col;
+};
+
+/**
+ * Checks whether two positions are the same cell
+ */
+bool operator==(const CellPosition& first, const CellPosition& second);
+
+/**
+ * Checks whether two positions are different cells
+ */
+bool operator!=(const CellPosition& first, const CellPosition& second);
+
 class Cell {
  public:
   /**
    * Constructor for Cell object
    * @param type The type of cell being created (kStart, kEnd, kEmpty, or kWall)
+   * @param row The row of the cell, which must be below 65536
+   * @param col The column of the cell, which must be below 65536
   */
-  Cell(CellType type, int x_pos, int y_pos);
+  Cell(CellType type, size_t row, size_t col);
 
   /**
    * Helper method that returns the CellType of the cell
@@ -31,22 +55,9 @@ class Cell {
 
   /**
    * Getter method that will get the position of the cell
-   * @return the (row,col) position of the cell as a vec2
+   * @return the (row,col) position of the cell
    */
-  const glm::vec2& GetPosition() const;
-
-  /**
-   * Setter method that will set the previous_cell of the current cell to the
-   * parameter
-   * @param previous_cell the cell preceding the current cell
-   */
-  void SetPreviousCell(Cell& previous_cell);
-
-  /**
-   * Getter method that returns the current cell's previous cell
-   * @return the current cell's previous cell
-  */
-  const Cell * GetPreviousCell();
+  const CellPosition& GetPosition() const;
 
   /**
    * Setter method that sets the G Cost of the cell to the given value
@@ -66,6 +77,12 @@ class Cell {
    */
   const int GetGCost() const;
 
+  /**
+   * Getter method that returns the H Cost of the current cell
+   * @return the H Cost of the current cell as an int
+   */
+  const int GetHCost() const;
+
   /**
    * Getter method that will return the F Cost of the given cell,
    * calculated from the G and H costs
@@ -76,11 +93,19 @@ class Cell {
  private:
   CellType type_;
 
-  glm::vec2 kPosition_;
+  CellPosition kPosition_;
   int g_cost_ = 0;
   int h_cost_ = 0;
-
-  Cell * previous_cell_;
 };
 
-} //namespace pathfinder
\ No newline at end of file
+inline bool operator==(const CellPosition& first,
+                       const CellPosition& second) {
+  return first.row == second.row && first.col == second.col;
+}
+
+inline bool operator!=(const CellPosition& first,
+                       const CellPosition& second) {
+  return !(first == second);
+}
+
+} //namespace pathfinder
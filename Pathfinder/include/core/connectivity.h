@@ -0,0 +1,215 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+
+#include "core/grid_map.h"
+
+namespace pathfinder {
+
+/**
+ * Whether a diagonal step may pass the corner of a wall next to it. The two
+ * cells beside a diagonal step are the ones it would go through if it were
+ * made as two straight steps.
+ */
+enum class CornerCutting {
+  // Diagonal steps are allowed even between two walls that touch at a corner
+  kAlways,
+
+  // A diagonal step may cut the corner of one wall, but not squeeze between
+  // two of them
+  kOneSideOpen,
+
+  // Both cells beside a diagonal step have to be open, which is the rule of
+  // the Moving AI benchmarks
+  kNever
+};
+
+/**
+ * Connectivity policy for searches that move between cells sharing an edge,
+ * where every step costs 1 before the cost of the cell stepped onto. The H
+ * cost that goes with it is the Manhattan distance.
+ *
+ * A connectivity policy is a template argument of the search, so each one
+ * gets its own copy of the neighbor loop with every step known at compile
+ * time.
+ */
+struct FourConnected {
+  // The cost of a step to a cell sharing an edge
+  static const int kStraightCost = 1;
+
+  // The most a single step costs, before the cost of the cell stepped onto
+  static const int kMaxStepCost = 1;
+
+  /**
+   * Method that calculates the cost of the cheapest route between two cells
+   * if the map were open and every cell cost 1
+   */
+  static int Distance(const GridMap& map, CellIndex from, CellIndex to);
+
+  /**
+   * Calls visit(neighbor, step_cost) for each open cell one step from
+   * current, in the order up, left, right, down
+   */
+  template <typename Visit>
+  static void ForEachNeighbor(const GridMap& map, CellIndex current,
+                              Visit visit);
+};
+
+/**
+ * Connectivity policy for searches that can also step diagonally. Costs are
+ * scaled so they stay integers: a straight step costs 5 and a diagonal one
+ * 7, which is within 1% of the true ratio of the square root of 2. The H cost
+ * that goes with it is the octile distance.
+ * @tparam kCornerCutting Which diagonal steps past walls are allowed
+ */
+template <CornerCutting kCornerCutting>
+struct EightConnected {
+  // The cost of a step to a cell sharing an edge
+  static const int kStraightCost = 5;
+
+  // The cost of a step to a cell sharing only a corner
+  static const int kDiagonalCost = 7;
+
+  // The most a single step costs, before the cost of the cell stepped onto
+  static const int kMaxStepCost = kDiagonalCost;
+
+  /**
+   * Method that calculates the octile distance between two cells: diagonal
+   * steps until the cells share a row or column, then straight steps
+   */
+  static int Distance(const GridMap& map, CellIndex from, CellIndex to);
+
+  /**
+   * Calls visit(neighbor, step_cost) for each open cell one step from
+   * current that can be stepped onto, in row-major order
+   */
+  template <typename Visit>
+  static void ForEachNeighbor(const GridMap& map, CellIndex current,
+                              Visit visit);
+
+ private:
+  /**
+   * Helper method that checks whether a diagonal step is allowed, given
+   * whether the two cells beside it are open
+   */
+  static bool CanCutCorner(bool first_open, bool second_open);
+};
+
+template <CornerCutting kCornerCutting>
+const int EightConnected<kCornerCutting>::kStraightCost;
+
+template <CornerCutting kCornerCutting>
+const int EightConnected<kCornerCutting>::kDiagonalCost;
+
+template <CornerCutting kCornerCutting>
+const int EightConnected<kCornerCutting>::kMaxStepCost;
+
+inline int FourConnected::Distance(const GridMap& map, CellIndex from,
+                                   CellIndex to) {
+  int x_distance = std::abs((int)map.GetRow(to) - (int)map.GetRow(from));
+  int y_distance = std::abs((int)map.GetCol(to) - (int)map.GetCol(from));
+  return x_distance + y_distance;
+}
+
+template <typename Visit>
+inline void FourConnected::ForEachNeighbor(const GridMap& map,
+                                           CellIndex current, Visit visit) {
+  size_t num_cols = map.GetNumCols();
+  size_t row = map.GetRow(current);
+  size_t col = current - row * num_cols;
+
+  if (row > 0 && map.IsPassable(current - num_cols)) {
+    visit(current - num_cols, kStraightCost);
+  }
+  if (col > 0 && map.IsPassable(current - 1)) {
+    visit(current - 1, kStraightCost);
+  }
+  if (col + 1 < num_cols && map.IsPassable(current + 1)) {
+    visit(current + 1, kStraightCost);
+  }
+  if (row + 1 < map.GetNumRows() && map.IsPassable(current + num_cols)) {
+    visit(current + num_cols, kStraightCost);
+  }
+}
+
+template <CornerCutting kCornerCutting>
+inline int EightConnected<kCornerCutting>::Distance(const GridMap& map,
+                                                    CellIndex from,
+                                                    CellIndex to) {
+  int x_distance = std::abs((int)map.GetRow(to) - (int)map.GetRow(from));
+  int y_distance = std::abs((int)map.GetCol(to) - (int)map.GetCol(from));
+  int num_diagonal = std::min(x_distance, y_distance);
+  int num_straight = std::max(x_distance, y_distance) - num_diagonal;
+  return num_diagonal * kDiagonalCost + num_straight * kStraightCost;
+}
+
+template <CornerCutting kCornerCutting>
+inline bool EightConnected<kCornerCutting>::CanCutCorner(bool first_open,
+                                                         bool second_open) {
+  switch (kCornerCutting) {
+    case CornerCutting::kAlways:
+      return true;
+
+    case CornerCutting::kOneSideOpen:
+      return first_open || second_open;
+
+    case CornerCutting::kNever:
+      return first_open && second_open;
+  }
+  return false;
+}
+
+template <CornerCutting kCornerCutting>
+template <typename Visit>
+inline void EightConnected<kCornerCutting>::ForEachNeighbor(
+    const GridMap& map, CellIndex current, Visit visit) {
+  size_t num_cols = map.GetNumCols();
+  size_t row = map.GetRow(current);
+  size_t col = current - row * num_cols;
+  bool has_up = row > 0;
+  bool has_down = row + 1 < map.GetNumRows();
+  bool has_left = col > 0;
+  bool has_right = col + 1 < num_cols;
+
+  // The straight neighbors decide which corners can be cut, so they are all
+  // looked up before anything is visited
+  CellIndex up = current - num_cols;
+  CellIndex down = current + num_cols;
+  bool up_open = has_up && map.IsPassable(up);
+  bool down_open = has_down && map.IsPassable(down);
+  bool left_open = has_left && map.IsPassable(current - 1);
+  bool right_open = has_right && map.IsPassable(current + 1);
+
+  if (has_up && has_left && CanCutCorner(up_open, left_open) &&
+      map.IsPassable(up - 1)) {
+    visit(up - 1, kDiagonalCost);
+  }
+  if (up_open) {
+    visit(up, kStraightCost);
+  }
+  if (has_up && has_right && CanCutCorner(up_open, right_open) &&
+      map.IsPassable(up + 1)) {
+    visit(up + 1, kDiagonalCost);
+  }
+  if (left_open) {
+    visit(current - 1, kStraightCost);
+  }
+  if (right_open) {
+    visit(current + 1, kStraightCost);
+  }
+  if (has_down && has_left && CanCutCorner(down_open, left_open) &&
+      map.IsPassable(down - 1)) {
+    visit(down - 1, kDiagonalCost);
+  }
+  if (down_open) {
+    visit(down, kStraightCost);
+  }
+  if (has_down && has_right && CanCutCorner(down_open, right_open) &&
+      map.IsPassable(down + 1)) {
+    visit(down + 1, kDiagonalCost);
+  }
+}
+
+}  // namespace pathfinder
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/grid_map.h"
+
+namespace pathfinder {
+
+/**
+ * The distance from every cell of a map to the nearest of a set of goals,
+ * and the direction to step in to get closer, so any number of units heading
+ * for the same goals can each look up their next move in constant time
+ * instead of running a search of their own. Cell costs are ignored, so the
+ * distance is the number of steps.
+ *
+ * The distances are found with a breadth first search that expands one
+ * frontier level at a time. Levels with many cells are split between a pool
+ * of worker threads, which claim the cells of the next level with an atomic
+ * compare and swap so each cell is added exactly once. Directions are picked
+ * afterwards from the finished distances, so the field does not depend on the
+ * number of threads.
+ */
+class FlowField {
+ public:
+  /**
+   * Constructor for an empty FlowField
+   * @param num_threads The number of threads to build with, including the one
+   * calling Build. 0 uses one thread per hardware thread.
+   */
+  explicit FlowField(size_t num_threads = 0);
+
+  /**
+   * Stops and joins the worker threads
+   */
+  ~FlowField();
+
+  FlowField(const FlowField&) = delete;
+  FlowField& operator=(const FlowField&) = delete;
+
+  /**
+   * Getter method that returns the number of threads the field is built on
+   */
+  size_t GetNumThreads() const;
+
+  /**
+   * Finds the distance and direction from every cell to the nearest goal. The
+   * map is only read while the field is built, so it can change afterwards,
+   * although the field will then be out of date.
+   * @param map The map the field is for
+   * @param goals The cells every step leads towards. Walls are ignored.
+   */
+  void Build(const GridMap& map, const std::vector<CellIndex>& goals);
+
+  /**
+   * Getter method for the number of steps from a cell to the nearest goal
+   * @return -1 if the cell is a wall or can't reach any goal
+   */
+  int GetDistance(CellIndex index) const;
+
+  /**
+   * Getter method that returns the largest distance of any cell that can
+   * reach a goal, or -1 if no cell can
+   */
+  int GetMaxDistance() const;
+
+  /**
+   * Method that looks up the step a unit on a cell should take
+   * @return The neighbor one step closer to the nearest goal, or kNoCell if
+   * the cell is a goal or can't reach one
+   */
+  CellIndex GetNextCell(CellIndex index) const;
+
+  /**
+   * Follows the field from a cell to the nearest goal
+   * @param start The cell the path starts from
+   * @param path Filled with the cells from start to the goal, or left empty
+   * if start can't reach a goal
+   */
+  void GetPath(CellIndex start, std::vector<CellIndex>& path) const;
+
+ private:
+  /**
+   * The work handed to every thread at once
+   */
+  enum class Task { kExpand, kPointDirections };
+
+  // Stored for cells that are walls or can't reach a goal
+  static const int kUnreachable = -1;
+
+  // Stored for goals and for cells that can't reach one
+  static const uint8_t kNoDirection = 4;
+
+  // Levels with fewer cells than this are expanded by the thread calling
+  // Build alone, since waking the workers would take longer
+  static const size_t kMinParallelLevel = 512;
+
+  /**
+   * Loop run by each background thread, which waits for a task, does its
+   * share of it and goes back to waiting
+   */
+  void WorkerLoop(size_t worker);
+
+  /**
+   * Helper method that has every thread do its share of a task, blocking
+   * until all of them are done
+   */
+  void RunTask(Task task);
+
+  /**
+   * Helper method that does a worker's share of the current task
+   */
+  void DoTask(size_t worker);
+
+  /**
+   * Helper method that claims the open neighbors of some cells of the
+   * current level for the next one
+   * @param begin The first cell of level_ to expand
+   * @param end One past the last cell of level_ to expand
+   * @param next_level The cells claimed are added to this
+   */
+  void ExpandLevel(size_t begin, size_t end,
+                   std::vector<CellIndex>& next_level);
+
+  /**
+   * Helper method that points each cell in a range at a neighbor one step
+   * closer to a goal
+   */
+  void PointDirections(CellIndex begin, CellIndex end);
+
+  const GridMap* map_ = nullptr;
+  size_t num_cells_ = 0;
+  int max_distance_ = kUnreachable;
+
+  // Written by several threads at once while the field is being built
+  std::unique_ptr<std::atomic<int>[]> distances_;
+  std::vector<uint8_t> directions_;
+
+  // The index step for each Direction
+  CellIndex steps_[4] = {0, 0, 0, 0};
+
+  // The cells at distance level_distance_, and the cells each worker has
+  // claimed for the next level
+  std::vector<CellIndex> level_;
+  int level_distance_ = 0;
+  std::vector<std::vector<CellIndex>> next_levels_;
+
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable task_started_;
+  std::condition_variable task_finished_;
+  Task task_ = Task::kExpand;
+  size_t task_number_ = 0;
+  size_t num_busy_threads_ = 0;
+  bool stopping_ = false;
+};
+
+inline CellIndex FlowField::GetNextCell(CellIndex index) const {
+  uint8_t direction = directions_[index];
+  return direction == kNoDirection ? kNoCell : index + steps_[direction];
+}
+
+}  // namespace pathfinder
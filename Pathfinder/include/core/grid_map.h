@@ -0,0 +1,260 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pathfinder {
+
+/**
+ * Linear index of a cell in a GridMap, equal to row * num_cols + col
+ */
+typedef uint32_t CellIndex;
+
+/**
+ * Index used to mark that a cell has no parent, or that no cell was found
+ */
+const CellIndex kNoCell = UINT32_MAX;
+
+/**
+ * The four directions a straight line across the map can go in
+ */
+enum Direction { kUp, kDown, kLeft, kRight };
+
+/**
+ * A contiguous, row-major map of which cells can be walked through. Each cell
+ * takes a single bit, so large maps stay small enough to remain in cache while
+ * they are being searched. A second, column-major copy of the bits lets
+ * straight lines in either direction be read 64 cells at a time.
+ *
+ * Cells can also have a cost for stepping onto them, such as mud or water
+ * that is slow to cross. Costs take a byte per cell, which is only allocated
+ * once a cost other than 1 is set.
+ */
+class GridMap {
+ public:
+  /**
+   * The largest cost a cell can have
+   */
+  static const int kMaxCost = 255;
+
+  /**
+   * Constructor for a GridMap where every cell is passable
+   * @param num_rows The number of rows in the map
+   * @param num_cols The number of columns in the map
+   */
+  GridMap(size_t num_rows = 0, size_t num_cols = 0);
+
+  /**
+   * Getter method that returns the number of rows in the map
+   */
+  size_t GetNumRows() const;
+
+  /**
+   * Getter method that returns the number of columns in the map
+   */
+  size_t GetNumCols() const;
+
+  /**
+   * Getter method that returns the total number of cells in the map
+   */
+  size_t GetNumCells() const;
+
+  /**
+   * Checks whether the given position lies inside the map
+   * @return true if 0 <= row < num_rows and 0 <= col < num_cols
+   */
+  bool InBounds(int row, int col) const;
+
+  /**
+   * Converts a (row, col) position into a linear index
+   */
+  CellIndex GetIndex(size_t row, size_t col) const;
+
+  /**
+   * Getter method that returns the row of the cell with the given index
+   */
+  size_t GetRow(CellIndex index) const;
+
+  /**
+   * Getter method that returns the column of the cell with the given index
+   */
+  size_t GetCol(CellIndex index) const;
+
+  /**
+   * Checks whether the cell with the given index can be walked through
+   * @return false if the cell is a wall, true otherwise
+   */
+  bool IsPassable(CellIndex index) const;
+
+  /**
+   * Setter method that marks a cell as passable or as a wall
+   * @param index The index of the cell
+   * @param passable false to make the cell a wall, true to clear it
+   */
+  void SetPassable(CellIndex index, bool passable);
+
+  /**
+   * Getter method for the cost of stepping onto a cell
+   * @return The cost of the cell, which is 1 unless it has been set
+   */
+  int GetCost(CellIndex index) const;
+
+  /**
+   * Setter method for the cost of stepping onto a cell. Walls keep their
+   * cost, which applies again if they are cleared.
+   * @param index The index of the cell
+   * @param cost The new cost, which is clamped to between 1 and kMaxCost
+   */
+  void SetCost(CellIndex index, int cost);
+
+  /**
+   * Getter method that returns the largest cost set since the map was last
+   * cleared, which no cell's cost is above
+   */
+  int GetMaxCost() const;
+
+  /**
+   * Checks whether every cell costs 1 to step onto, which searches that only
+   * count steps rely on
+   */
+  bool HasUniformCosts() const;
+
+  /**
+   * Reads the passability of 64 consecutive cells of a row
+   * @param row The row to read, which may be outside of the map
+   * @param first_col The column of the cell that ends up in the lowest bit,
+   * which may be outside of the map
+   * @return A word where bit i is set if (row, first_col + i) is passable.
+   * Cells outside of the map read as walls.
+   */
+  uint64_t GetRowBits(int row, int first_col) const;
+
+  /**
+   * Reads the passability of 64 consecutive cells of a column
+   * @param col The column to read, which may be outside of the map
+   * @param first_row The row of the cell that ends up in the lowest bit,
+   * which may be outside of the map
+   * @return A word where bit i is set if (first_row + i, col) is passable.
+   * Cells outside of the map read as walls.
+   */
+  uint64_t GetColumnBits(int col, int first_row) const;
+
+  /**
+   * Marks every cell in the map as passable with a cost of 1
+   */
+  void Clear();
+
+ private:
+  static const size_t kBitsPerWord = 64;
+
+  /**
+   * Helper method that reads 64 cells of a line stored in a bitset, starting
+   * first cells into the line
+   * @param bits The bitset the line is stored in
+   * @param line_start The bit the line starts at
+   * @param line_length The number of cells in the line
+   */
+  static uint64_t ReadBits(const std::vector<uint64_t>& bits,
+                           size_t line_start, size_t line_length, int first);
+
+  size_t num_rows_;
+  size_t num_cols_;
+
+  // Both bitsets end with an extra word of walls, so 64 bits starting at any
+  // cell can be read from two neighboring words
+  std::vector<uint64_t> passable_bits_;
+  std::vector<uint64_t> passable_columns_;
+
+  // Empty while every cell costs 1
+  std::vector<uint8_t> costs_;
+  int max_cost_ = 1;
+};
+
+inline size_t GridMap::GetNumRows() const {
+  return num_rows_;
+}
+
+inline size_t GridMap::GetNumCols() const {
+  return num_cols_;
+}
+
+inline size_t GridMap::GetNumCells() const {
+  return num_rows_ * num_cols_;
+}
+
+inline bool GridMap::InBounds(int row, int col) const {
+  return row >= 0 && col >= 0 && (size_t)row < num_rows_ &&
+         (size_t)col < num_cols_;
+}
+
+inline CellIndex GridMap::GetIndex(size_t row, size_t col) const {
+  return (CellIndex)(row * num_cols_ + col);
+}
+
+inline size_t GridMap::GetRow(CellIndex index) const {
+  return index / num_cols_;
+}
+
+inline size_t GridMap::GetCol(CellIndex index) const {
+  return index % num_cols_;
+}
+
+inline bool GridMap::IsPassable(CellIndex index) const {
+  return (passable_bits_[index / kBitsPerWord] >> (index % kBitsPerWord)) & 1;
+}
+
+inline int GridMap::GetCost(CellIndex index) const {
+  return costs_.empty() ? 1 : costs_[index];
+}
+
+inline int GridMap::GetMaxCost() const {
+  return max_cost_;
+}
+
+inline bool GridMap::HasUniformCosts() const {
+  return max_cost_ == 1;
+}
+
+inline uint64_t GridMap::GetRowBits(int row, int first_col) const {
+  if (row < 0 || (size_t)row >= num_rows_) {
+    return 0;
+  }
+  return ReadBits(passable_bits_, row * num_cols_, num_cols_, first_col);
+}
+
+inline uint64_t GridMap::GetColumnBits(int col, int first_row) const {
+  if (col < 0 || (size_t)col >= num_cols_) {
+    return 0;
+  }
+  return ReadBits(passable_columns_, col * num_rows_, num_rows_, first_row);
+}
+
+inline uint64_t GridMap::ReadBits(const std::vector<uint64_t>& bits,
+                                  size_t line_start, size_t line_length,
+                                  int first) {
+  // Cells before the start of the line are shifted in as walls
+  int skipped = first < 0 ? -first : 0;
+  if (skipped >= (int)kBitsPerWord || first >= (int)line_length) {
+    return 0;
+  }
+
+  size_t position = line_start + first + skipped;
+  size_t shift = position % kBitsPerWord;
+  const uint64_t* words = &bits[position / kBitsPerWord];
+  uint64_t value = words[0] >> shift;
+  if (shift != 0) {
+    value |= words[1] << (kBitsPerWord - shift);
+  }
+  value <<= skipped;
+
+  // Cells past the end of the line belong to the next line, so they are
+  // masked off as walls
+  size_t end = (size_t)((int)line_length - first);
+  if (end < kBitsPerWord) {
+    value &= ((uint64_t)1 << end) - 1;
+  }
+  return value;
+}
+
+}  // namespace pathfinder
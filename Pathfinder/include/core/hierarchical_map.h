@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "core/grid_map.h"
+#include "core/search.h"
+#include "core/search_context.h"
+
+namespace pathfinder {
+
+/**
+ * An HPA* abstraction of a GridMap. The map is split into square clusters,
+ * and every stretch of open cells along the border of two clusters gets one
+ * or two entrances. The entrances of a cluster are linked by the length of
+ * the shortest route between them inside the cluster, which is precomputed,
+ * so a long query only searches the small graph of entrances and then fills
+ * in the cells of each cluster it passes through.
+ *
+ * Paths found this way are close to, but not always exactly, the shortest.
+ * Cell costs are ignored, so every step counts as 1.
+ *
+ * Each cluster's entrances and distances only depend on the cells of that
+ * cluster and its borders, so after walls change only the clusters around
+ * the changed cells are rebuilt.
+ */
+class HierarchicalMap {
+ public:
+  /**
+   * Side length of the clusters when none is given
+   */
+  static const size_t kDefaultClusterSize = 16;
+
+  /**
+   * Constructor for a HierarchicalMap, which builds the abstraction of the
+   * whole map. The map is not copied, so it has to outlive this object, and
+   * UpdateCells has to be called after any of its walls change.
+   * @param map The map to build the abstraction of
+   * @param cluster_size The side length of a cluster, in cells
+   */
+  explicit HierarchicalMap(const GridMap& map,
+                           size_t cluster_size = kDefaultClusterSize);
+
+  /**
+   * Rebuilds the entrances and distances of every cluster
+   */
+  void Rebuild();
+
+  /**
+   * Rebuilds only the parts of the abstraction that depend on the given
+   * cells: the clusters that contain them, and the clusters across any
+   * border they lie on
+   * @param cells The cells whose walls have changed
+   */
+  void UpdateCells(const std::vector<CellIndex>& cells);
+
+  /**
+   * Finds a path between two cells by searching the graph of entrances and
+   * then filling in the route through each cluster
+   * @param start The cell the path starts from
+   * @param goal The cell the path has to reach
+   * @param path Filled with every cell of the path from start to goal, or
+   * left empty if there is no path
+   * @return Whether a path was found, its cost and the number of entrances
+   * that were expanded
+   */
+  SearchResult FindPath(CellIndex start, CellIndex goal,
+                        std::vector<CellIndex>& path);
+
+  /**
+   * Getter method that returns the side length of a cluster
+   */
+  size_t GetClusterSize() const;
+
+  /**
+   * Getter method that returns the number of clusters the map is split into
+   */
+  size_t GetNumClusters() const;
+
+  /**
+   * Getter method that returns the number of entrance cells in every cluster
+   * combined
+   */
+  size_t GetNumEntrances() const;
+
+  /**
+   * Getter method that returns the number of clusters rebuilt by the last
+   * call to Rebuild or UpdateCells
+   */
+  size_t GetNumRebuiltClusters() const;
+
+ private:
+  /**
+   * A pair of open cells on either side of a border between two clusters
+   */
+  struct Transition {
+    CellIndex inside;
+    CellIndex outside;
+  };
+
+  /**
+   * The abstract graph inside a single cluster
+   */
+  struct Cluster {
+    // The entrance cells of the cluster
+    std::vector<CellIndex> entrances;
+
+    // distances[i * entrances.size() + j] is the length of the shortest route
+    // from entrance i to entrance j inside the cluster, or -1 if there is none
+    std::vector<int> distances;
+
+    // The entrance each transition out of the cluster starts from, and the
+    // cell in the neighboring cluster it leads to
+    std::vector<size_t> link_entrances;
+    std::vector<CellIndex> link_cells;
+  };
+
+  /**
+   * Helper method that returns the cluster a cell belongs to
+   */
+  size_t GetCluster(CellIndex index) const;
+
+  /**
+   * Helper method that finds the transitions across the bottom border of a
+   * cluster (vertical is false) or its right border (vertical is true)
+   */
+  void BuildBorder(size_t cluster, bool vertical);
+
+  /**
+   * Helper method that collects a cluster's entrances from its four borders
+   * and works out the distances between them
+   */
+  void BuildCluster(size_t cluster);
+
+  /**
+   * Helper method that runs a breadth first search from a cell that stays
+   * inside its cluster, filling local_costs_ and local_parents_. Both are
+   * indexed by the position of a cell inside the cluster.
+   */
+  void SearchCluster(CellIndex source);
+
+  /**
+   * Helper method that returns the position of a cell in local_costs_ and
+   * local_parents_, which are laid out like the cluster being searched
+   */
+  size_t GetLocalIndex(CellIndex index) const;
+
+  /**
+   * Helper method that appends the cells after from up to and including to,
+   * found by searching the cluster they are both in
+   */
+  void AppendClusterRoute(CellIndex from, CellIndex to,
+                          std::vector<CellIndex>& path);
+
+  const GridMap& map_;
+  size_t cluster_size_;
+  size_t num_cluster_rows_;
+  size_t num_cluster_cols_;
+  size_t num_rebuilt_clusters_ = 0;
+
+  // The transitions across the bottom and right borders of every cluster
+  std::vector<std::vector<Transition>> bottom_transitions_;
+  std::vector<std::vector<Transition>> right_transitions_;
+  std::vector<Cluster> clusters_;
+
+  // Scratch space for searches inside one cluster
+  size_t local_first_row_ = 0;
+  size_t local_first_col_ = 0;
+  std::vector<int> local_costs_;
+  std::vector<size_t> local_parents_;
+  std::vector<size_t> local_queue_;
+  std::vector<size_t> rebuilt_clusters_;
+
+  // Scratch space for searches over the entrances
+  SearchContext context_;
+  std::vector<int> start_costs_;
+  std::vector<int> goal_costs_;
+  std::vector<CellIndex> abstract_path_;
+};
+
+}  // namespace pathfinder
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/grid_map.h"
+#include "core/search.h"
+#include "core/search_context.h"
+#include "core/search_state.h"
+
+namespace pathfinder {
+
+/**
+ * Precomputed jump distances for JPS+. For every cell and direction the table
+ * holds how far a jump from that cell travels before it reaches a jump point
+ * that doesn't depend on the goal, so a jump becomes a lookup instead of a
+ * scan. The table has to be rebuilt whenever a wall of the map changes.
+ */
+class JumpTable {
+ public:
+  /**
+   * Creates an empty table, which has to be built before it is used
+   */
+  JumpTable() = default;
+
+  /**
+   * Recomputes every jump distance of a map, in four sweeps over the map
+   * @param map The map the table is for
+   */
+  void Build(const GridMap& map);
+
+  /**
+   * Getter method for the jump distance of a cell
+   * @param index The cell the jump starts from
+   * @param direction The direction of the jump
+   * @return The number of cells to the next jump point if it is positive.
+   * Otherwise there is no jump point before the next wall, and the negated
+   * value is the number of open cells before it.
+   */
+  int GetDistance(CellIndex index, Direction direction) const;
+
+ private:
+  // Four distances per cell, in the order of Direction
+  std::vector<int32_t> distances_;
+};
+
+/**
+ * Moves from a cell in a straight line until it reaches a jump point: the
+ * goal, a cell next to a wall corner that makes a turn there necessary, or,
+ * when moving vertically, a cell from which a horizontal jump reaches one of
+ * those
+ * @param map The map being searched
+ * @param from The cell the jump starts from, which is not itself considered
+ * @param direction The direction to move in
+ * @param goal The cell the search is trying to reach
+ * @return The jump point that was reached, or kNoCell if a wall or the edge
+ * of the map was hit first
+ */
+CellIndex Jump(const GridMap& map, CellIndex from, Direction direction,
+               CellIndex goal);
+
+/**
+ * Does the same as Jump, but looks the distances up in a JumpTable
+ * @param table A table built for map
+ */
+CellIndex Jump(const GridMap& map, const JumpTable& table, CellIndex from,
+               Direction direction, CellIndex goal);
+
+/**
+ * Jump point search's replacement for FindNeighbors. Only the directions that
+ * can continue an optimal route from the cell's parent are followed, and only
+ * the jump points they lead to are opened, with the length of the straight
+ * line to them as the cost. Skipping cells is only safe when every cell costs
+ * the same, so on maps with costs this expands the cell like FindNeighbors.
+ * @param context The search that the cell belongs to
+ * @param current The cell that the jump points will be found for
+ * @param goal The cell the search is trying to reach
+ * @param table Jump distances for JPS+, or nullptr to scan the map instead
+ */
+void FindJumpPoints(SearchContext& context, CellIndex current, CellIndex goal,
+                    const JumpTable* table = nullptr);
+
+/**
+ * Fills in the cells between the jump points of a finished search, writing
+ * out every cell of the path from start to goal
+ * @param map The map that was searched
+ * @param state The state of a search that reached the goal
+ * @param start The cell the search started from
+ * @param goal The cell the search reached
+ * @param path Replaced with the cells of the path from start to goal
+ * @return The number of cells in the path
+ */
+size_t ReconstructJumpPath(const GridMap& map, const SearchState& state,
+                           CellIndex start, CellIndex goal,
+                           std::vector<CellIndex>& path);
+
+/**
+ * Finds the shortest path between two cells with jump point search. The path
+ * and its cost are the same as FindPath's, but far fewer cells are expanded
+ * on open maps. On maps with costs every cell is expanded, as in FindPath.
+ * @param context The scratch space used for the search
+ * @param start The cell the path starts from
+ * @param goal The cell the path has to reach
+ * @param path Filled with every cell of the path from start to goal, or left
+ * empty if there is no path
+ * @param table Jump distances for JPS+, or nullptr to scan the map instead
+ * @return Whether a path was found, its cost and the number of expanded jump
+ * points
+ */
+SearchResult FindJumpPointPath(SearchContext& context, CellIndex start,
+                               CellIndex goal, std::vector<CellIndex>& path,
+                               const JumpTable* table = nullptr);
+
+}  // namespace pathfinder
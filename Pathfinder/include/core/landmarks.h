@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "core/grid_map.h"
+
+namespace pathfinder {
+
+/**
+ * Exact distances from a few landmark cells to every cell of a map, for the
+ * ALT heuristic. By the triangle inequality, the distance between two cells
+ * is at least the difference of their distances to any landmark, which is
+ * a much closer estimate than the Manhattan distance when walls are in the
+ * way. Distances count steps, ignoring cell costs, which can only make them
+ * shorter than the real cost since every cell costs at least 1.
+ *
+ * Distances are stored as 16 bits per landmark per cell, with a cell's
+ * distances next to each other so an estimate reads a single cache line per
+ * cell. Distances too long for 16 bits are stored as the largest value that
+ * fits, which can only make an estimate smaller, so it never overestimates.
+ *
+ * The table has to be rebuilt or reloaded whenever a wall of the map changes.
+ */
+class LandmarkTable {
+ public:
+  /**
+   * Number of landmarks used when none is given
+   */
+  static const size_t kDefaultNumLandmarks = 8;
+
+  /**
+   * Creates an empty table, whose estimates are all 0 until it is built
+   */
+  LandmarkTable() = default;
+
+  /**
+   * Picks landmarks spread as far apart as possible and finds the distance
+   * from each of them to every cell with a breadth first search. The first
+   * landmark is the cell farthest from the first open cell, and every other
+   * one is the reachable cell farthest from the landmarks picked so far.
+   * @param map The map the table is for
+   * @param num_landmarks The number of landmarks to pick, which is fewer if
+   * the map doesn't have that many open cells
+   */
+  void Build(const GridMap& map, size_t num_landmarks = kDefaultNumLandmarks);
+
+  /**
+   * Writes the table in a compact binary format, so it can be stored next
+   * to the map it was built for instead of being rebuilt every time
+   * @param output The stream the table is written to
+   * @return Whether the whole table was written
+   */
+  bool Save(std::ostream& output) const;
+
+  /**
+   * Reads a table written by Save
+   * @param input The stream the table is read from
+   * @param map The map the table is for
+   * @return false if the data is malformed, is shorter than the number of
+   * landmarks it claims needs, or was saved for a map of a different size or
+   * with different walls, in which case the table is left empty
+   */
+  bool Load(std::istream& input, const GridMap& map);
+
+  /**
+   * Checks whether the table was built or loaded for a map of the same size
+   * and with the same walls, in which case it doesn't need to be rebuilt.
+   * This hashes the walls, which is much cheaper than building the table.
+   */
+  bool IsBuiltFor(const GridMap& map) const;
+
+  /**
+   * Getter method that returns the cells that were picked as landmarks
+   */
+  const std::vector<CellIndex>& GetLandmarks() const;
+
+  /**
+   * Getter method for the distance from a landmark to a cell
+   * @param landmark The position of the landmark in GetLandmarks
+   * @param index The cell the distance is to
+   * @return The length of the shortest path, capped at the largest value
+   * that fits in 16 bits, or -1 if the cell can't be reached
+   */
+  int GetDistance(size_t landmark, CellIndex index) const;
+
+  /**
+   * Method that calculates the ALT lower bound on the distance between two
+   * cells
+   * @return The largest difference between the cells' distances to any
+   * landmark that can reach both of them
+   */
+  int GetLowerBound(CellIndex from, CellIndex to) const;
+
+ private:
+  // Stored for cells that a landmark can't reach
+  static const uint16_t kUnreachable = UINT16_MAX;
+
+  // The largest distance that can be stored
+  static const uint16_t kMaxDistance = UINT16_MAX - 1;
+
+  /**
+   * Helper method that fills in the distances from one landmark with a
+   * breadth first search
+   * @param queue Left holding every cell the landmark can reach
+   * @param field Left holding the distance from the landmark to each cell
+   */
+  void SearchFrom(const GridMap& map, size_t landmark,
+                  std::vector<CellIndex>& queue, std::vector<uint16_t>& field);
+
+  size_t num_rows_ = 0;
+  size_t num_cols_ = 0;
+
+  // Identifies the walls of the map the table was built for
+  uint32_t wall_hash_ = 0;
+  std::vector<CellIndex> landmarks_;
+
+  // distances_[index * landmarks_.size() + landmark]
+  std::vector<uint16_t> distances_;
+};
+
+inline int LandmarkTable::GetLowerBound(CellIndex from, CellIndex to) const {
+  size_t num_landmarks = landmarks_.size();
+  const uint16_t* from_distances = distances_.data() + from * num_landmarks;
+  const uint16_t* to_distances = distances_.data() + to * num_landmarks;
+
+  int bound = 0;
+  for (size_t landmark = 0; landmark < num_landmarks; landmark++) {
+    if (from_distances[landmark] == kUnreachable ||
+        to_distances[landmark] == kUnreachable) {
+      continue;
+    }
+    int difference = std::abs((int)from_distances[landmark] -
+                              (int)to_distances[landmark]);
+    if (difference > bound) {
+      bound = difference;
+    }
+  }
+  return bound;
+}
+
+}  // namespace pathfinder
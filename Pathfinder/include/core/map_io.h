@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "core/grid_map.h"
+
+namespace pathfinder {
+
+/**
+ * A single query from a Moving AI .scen file
+ */
+struct Scenario {
+  // Scenarios are grouped into buckets of similar path length
+  size_t bucket;
+
+  // The map the scenario is for, as written in the .scen file
+  std::string map_name;
+  size_t map_width;
+  size_t map_height;
+
+  size_t start_row;
+  size_t start_col;
+  size_t goal_row;
+  size_t goal_col;
+
+  // Length of the shortest 8-connected path, with diagonals costing sqrt(2)
+  double optimal_length;
+};
+
+/**
+ * Reads a map into a GridMap. Two formats are understood:
+ *  - Moving AI .map files, which start with a "type", "height", "width" and
+ *    "map" header. The rows are streamed straight into the map, so the file
+ *    is never held in memory.
+ *  - Plain maps with no header, written as one line of characters per row.
+ * In both formats '.', 'G' and 'S' are passable and every other character is
+ * a wall.
+ * @param input The stream the map is read from
+ * @param map Replaced with the map that was read
+ * @return false if the stream is empty, the header is malformed or the rows
+ * don't match the map's width and height
+ */
+bool LoadMap(std::istream& input, GridMap& map);
+
+/**
+ * Reads every scenario from a Moving AI .scen file
+ * @param input The stream the scenarios are read from
+ * @param scenarios Replaced with the scenarios that were read
+ * @return false if the version line or any scenario line is malformed
+ */
+bool LoadScenarios(std::istream& input, std::vector<Scenario>& scenarios);
+
+/**
+ * Checks whether a character in a map file is a cell that can be walked
+ * through
+ */
+bool IsPassableTerrain(char terrain);
+
+}  // namespace pathfinder
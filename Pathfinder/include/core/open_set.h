@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "core/grid_map.h"
+
+namespace pathfinder {
+
+/**
+ * Indexed binary min-heap holding the cells that are waiting to be expanded.
+ * Cells are identified by their linear index (row * num_cols + col), which
+ * lets the heap keep a position table so that membership checks are O(1) and
+ * push, pop and decrease-key are all O(log n).
+ *
+ * A position only counts if the heap entry it points at refers back to the
+ * same cell, so stale positions left over from earlier searches are harmless
+ * and the table never has to be cleared.
+ *
+ * Entries are ordered by F cost, then by H cost (so cells closer to the goal
+ * win ties), then by cell index so the expansion order is deterministic.
+ */
+class OpenSet {
+ public:
+  /**
+   * Constructor for an OpenSet that can hold the cells of a map
+   * @param num_cells The number of cells in the map
+   */
+  explicit OpenSet(size_t num_cells = 0);
+
+  /**
+   * Empties the heap and sizes it and the position table for a new map, so
+   * that pushes never allocate. This is O(1) when the number of cells is
+   * unchanged.
+   * @param num_cells The number of cells in the map
+   */
+  void Reset(size_t num_cells);
+
+  /**
+   * Checks whether there are any cells left to expand
+   * @return true if the heap is empty, false otherwise
+   */
+  bool Empty() const;
+
+  /**
+   * Getter method that returns the number of cells in the heap
+   */
+  size_t Size() const;
+
+  /**
+   * Checks whether the given cell is currently in the heap
+   * @param index The linear index of the cell
+   * @return true if the cell is in the heap, false otherwise
+   */
+  bool Contains(CellIndex index) const;
+
+  /**
+   * Adds a cell to the heap
+   * @param index The linear index of the cell, which must not be in the heap
+   * @param f_cost The F cost of the cell
+   * @param h_cost The H cost of the cell, used to break ties on F cost
+   */
+  void Push(CellIndex index, int f_cost, int h_cost);
+
+  /**
+   * Lowers the F cost of a cell that is already in the heap
+   * @param index The linear index of the cell
+   * @param f_cost The new F cost, which must not be larger than the old one
+   * @param h_cost The H cost of the cell
+   */
+  void DecreaseKey(CellIndex index, int f_cost, int h_cost);
+
+  /**
+   * Getter method that returns the index of the cell with the lowest F cost
+   * without removing it
+   */
+  CellIndex Top() const;
+
+  /**
+   * Getter methods that return the F and H cost of the cell that Top returns
+   */
+  int GetTopFCost() const;
+  int GetTopHCost() const;
+
+  /**
+   * Removes the cell with the lowest F cost from the heap
+   * @return The linear index of the removed cell
+   */
+  CellIndex Pop();
+
+  /**
+   * Removes the given cell from the heap if it is there
+   * @param index The linear index of the cell
+   */
+  void Remove(CellIndex index);
+
+  /**
+   * Getter method that returns the indices of every cell in the heap, in heap
+   * order rather than sorted order
+   */
+  std::vector<CellIndex> GetIndices() const;
+
+ private:
+  struct Entry {
+    int f_cost;
+    int h_cost;
+    CellIndex index;
+  };
+
+  /**
+   * Helper method that checks if entry a should be expanded before entry b
+   */
+  static bool Precedes(const Entry& a, const Entry& b);
+
+  void SiftUp(uint32_t position);
+  void SiftDown(uint32_t position);
+  void Place(const Entry& entry, uint32_t position);
+
+  std::vector<Entry> heap_;
+  std::vector<uint32_t> positions_;
+};
+
+}  // namespace pathfinder
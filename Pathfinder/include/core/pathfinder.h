@@ -1,63 +1,140 @@
+#pragma once
+
 #include <string>
 #include <vector>
 
+#include "core/basic_search.h"
+#include "core/bidirectional_search.h"
 #include "core/cell.h"
+#include "core/grid_map.h"
+#include "core/jump_point_search.h"
+#include "core/landmarks.h"
+#include "core/search.h"
+#include "core/search_context.h"
 
 namespace pathfinder {
 
+/**
+ * Builds a GridMap whose walls match a grid of cells
+ * @param cells The grid of cells, indexed as cells[row][col]
+ */
+GridMap MakeGridMap(const std::vector<std::vector<Cell>>& cells);
+
+/**
+ * The ways a Pathfinder can expand cells
+ */
+enum class SearchMode {
+  // Every neighbor of a cell is opened
+  kAStar,
+
+  // Only jump points are opened, found by scanning the map
+  kJumpPoint,
+
+  // Only jump points are opened, found from a precomputed JumpTable
+  kJumpPointPlus,
+
+  // Every neighbor of a cell is opened, searching from the start and the
+  // goal at the same time
+  kBidirectional
+};
+
+/**
+ * Steps through a search one cell at a time, so it can be drawn as it goes.
+ * The search mode can be changed at run time, and A* steps are taken with
+ * AStarSearch. Cells are only built for the caller; the search itself works
+ * on cell indices.
+ */
 class Pathfinder {
  public:
   /**
-   * Constructor for Pathfinder object
-   * @param cells A vector of cells representing a map
+   * Constructor for Pathfinder object. The map is not copied, so it has to
+   * outlive the pathfinder.
+   * @param map The map that will be searched
+   * @param start The cell the search starts from
+   * @param end The cell the search is trying to reach
    */
-  Pathfinder(const std::vector<std::vector<Cell>>& cells, Cell& start, Cell& end);
+  Pathfinder(const GridMap& map, const Cell& start, const Cell& end);
 
   /**
-   * Updates the current cell and the values of the new current cell
-   * @return The new cell that is currently being occupied
+   * Expands the current cell and moves to the open cell with the lowest F
+   * cost. In bidirectional mode the search moves between the cells of both
+   * directions, taking the next one from the smaller open set.
+   * @param current_cell The cell that is currently being occupied
+   * @return The new cell that is currently being occupied, or current_cell if
+   * there are no cells left to move to
    */
-  Cell FindNextCell(Cell& current_cell);
+  Cell FindNextCell(const Cell& current_cell);
 
   /**
-   * Checks to see whether the current_cell is the end cell
+   * Checks to see whether the current_cell is the end cell, or in
+   * bidirectional mode whether the two directions have found a shortest path
+   * between them
    * @param current_cell
    * @return
    */
-  bool PathFound(Cell& current_cell);
-
-  /**
-   * Method that will find the full path, from start to end
-   * @return A vector representing the full path
-   */
-
+  bool PathFound(const Cell& current_cell) const;
 
   /**
    * Method that will get the path from the last cell
    * @param end_cell
-   * @return The vector of cells that are included in the path
+   * @return The vector of cells that are included in the path, from end_cell
+   * back to the start
    */
-  std::vector<Cell>& GetPath(Cell& end_cell);
+  std::vector<Cell>& GetPath(const Cell& end_cell);
 
   /**
    * Will go through the whole process of finding the path from start_ to goal_
-   * Doing so will populate the previous_cell member for each cell in the path
+   * Doing so will populate the parent of each cell in the path
    */
   void FindPath();
 
   /**
-   * Method that will update the grid of the pathfinder
-   * @param new_grid The new grid
+   * Method that will update the map of the pathfinder and restart the search
+   * @param new_grid The new map, which has to outlive the pathfinder
    * @param start The new start node
    * @param end The new end node
    */
-  void SetGrid(std::vector<std::vector<Cell>>& new_grid, Cell& start, Cell& end);
+  void SetGrid(const GridMap& new_grid, const Cell& start, const Cell& end);
+
+  /**
+   * Setter method for how cells are expanded, which restarts the search.
+   * The jump table JPS+ needs is built when switching to it, and again
+   * whenever the map is set.
+   * @param mode The new search mode
+   */
+  void SetSearchMode(SearchMode mode);
+
+  /**
+   * Getter method for how cells are expanded
+   */
+  SearchMode GetSearchMode() const;
+
+  /**
+   * Setter method for whether H costs are estimated with landmarks as well
+   * as the Manhattan distance, which restarts the search. The landmarks are
+   * built for the current map when they are turned on, and again whenever
+   * a map with different walls is set.
+   * @param use_landmarks Whether to use landmarks
+   */
+  void SetUseLandmarks(bool use_landmarks);
+
+  /**
+   * Getter method for whether H costs are estimated with landmarks
+   */
+  bool GetUseLandmarks() const;
 
   /**
-   * Getter method that will return the open_set_
+   * Getter method that will return the cells in the open_set_
    */
   std::vector<Cell> GetOpenSet() const;
 
+  /**
+   * Checks to see whether the search has run out of cells to move to, which
+   * means there is no path from start_ to goal_
+   * @return true if every reachable cell has been expanded
+   */
+  bool IsExhausted() const;
+
   /**
    * Helper method that checks if the given vector has the cell
    * @param vec The vector we are checking
@@ -68,52 +145,78 @@ class Pathfinder {
 
  private:
   /**
-   * Helper method that will find the next cell to travel to on the map
-   * given the current cell
-   * @param current_cell The cell that is currently being occupied
-   * @return The neighboring cell that needs to be traveled to
+   * Helper method that does the work of FindNextCell on cell indices
+   * @return The index of the next cell, or current if there are no cells
+   * left to move to
+   */
+  CellIndex Step(CellIndex current);
+
+  /**
+   * Helper method that does Step's work in bidirectional mode, expanding
+   * current in the direction it was taken from
+   */
+  CellIndex StepBidirectional(CellIndex current);
+
+  /**
+   * Helper method that does the work of PathFound on a cell index
    */
-  Cell CalculateNextCell(const Cell& current_cell);
+  bool IsPathFound(CellIndex current) const;
 
   /**
    * Method that calculates the H cost of a given cell
-   * @param cell The cell that the H cost will be calculated for
-   * @return a double representing the H cost for that specific cell
+   * @param index The cell that the H cost will be calculated for
+   * @return an int representing the H cost for that specific cell
+   */
+  int CalculateHCost(CellIndex index) const;
+
+  /**
+   * Helper method that gives both contexts landmarks_ if they are in use
    */
-  int CalculateHCost(const Cell& cell);
+  void UpdateLandmarks();
 
   /**
-   * Method that calculates the G cost of a given cell
-   * @param cell The cell that the G cost will be calculated for
-   * @return a double representing the G cost for that specific cell
+   * Helper method that starts a new search by putting start_ into the open
+   * set. Searches on a map of the same size reuse the previous state without
+   * clearing it.
    */
-  int CalculateGCost(const Cell& cell);
+  void ResetSearch();
 
   /**
-   * Helper method that finds the neighbors of a given cell and adds
-   * the proper ones to the open_set_
-   * @param current_cell The cell that the neighbors will be found for
-   * @return a vector containing all the neighbors of current_cell
+   * Helper method that converts a cell's (row, col) position into a linear
+   * index in the map
    */
- void FindNeighbors(const Cell& current_cell);
+  CellIndex GetIndex(const Cell& cell) const;
 
   /**
-   * Helper method that will remove an element from the given list
-   * @param list The list where the element will be removed from
-   * @param element The element to remove
-   * @return The new list with the element removed
+   * Helper method that builds a Cell for the given index, filled in with its
+   * type and current costs
    */
-  std::vector<Cell> RemoveElement(std::vector<Cell>& list, const Cell& element);
+  Cell MakeCell(CellIndex index) const;
+
+  SearchContext context_;
+
+  // The search from goal_ back to start_, and where it has met the search
+  // in context_, while mode_ is kBidirectional
+  SearchContext backward_context_;
+  Meeting meeting_;
+  std::vector<CellIndex> reached_;
+  bool current_is_forward_ = true;
 
-  std::vector<std::vector<Cell>> cells_;
-  std::vector<Cell> open_set_;
-  std::vector<Cell> closed_set_;
   std::vector<Cell> path_;
+  std::vector<CellIndex> path_indices_;
 
-  Cell start_ = Cell(CellType::kEmpty, 0, 0);
-  Cell goal_ = Cell(CellType::kEmpty, 0, 0);;
-};
+  SearchMode mode_ = SearchMode::kAStar;
 
-}  // namespace pathfinder
+  // Only built while mode_ is kJumpPointPlus
+  JumpTable jump_table_;
 
+  // Only built while use_landmarks_ is true
+  LandmarkTable landmarks_;
+  bool use_landmarks_ = false;
 
+  CellIndex start_ = kNoCell;
+  CellIndex goal_ = kNoCell;
+  bool exhausted_ = false;
+};
+
+}  // namespace pathfinder
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <climits>
+#include <cstddef>
+#include <vector>
+
+#include "core/grid_map.h"
+#include "core/open_set.h"
+#include "core/search.h"
+#include "core/search_state.h"
+
+namespace pathfinder {
+
+/**
+ * Keeps the shortest path between two cells up to date while walls change,
+ * using D* Lite. The search runs backwards from the goal, so every cell it has
+ * settled knows its distance to the goal. When walls change, only the cells
+ * whose distance depends on them are put back on the open set and expanded
+ * again, instead of searching the whole map from scratch. The start can also
+ * move along the path, as an agent following it would, without losing any of
+ * that work.
+ *
+ * Each cell has a G cost, its settled distance to the goal, and an RHS cost,
+ * the distance its neighbors' G costs imply. Cells where the two disagree are
+ * on the open set, ordered by the smaller of them plus the H cost to the
+ * start.
+ */
+class Replanner {
+ public:
+  /**
+   * Constructor for a Replanner on a map. The map is not copied, so it has to
+   * outlive the replanner, and UpdateCells has to be called after any of its
+   * walls or costs change.
+   */
+  explicit Replanner(const GridMap& map);
+
+  /**
+   * Forgets the previous search and starts a new one between two cells. The
+   * search itself is run by the next call to FindPath.
+   * @param start The cell the path starts from
+   * @param goal The cell the path has to reach
+   */
+  void Reset(CellIndex start, CellIndex goal);
+
+  /**
+   * Moves the start of the path, keeping everything the search has found
+   * @param start The new start, usually the next cell along the old path
+   */
+  void SetStart(CellIndex start);
+
+  /**
+   * Repairs the search after walls or costs of the map have changed. Only the
+   * changed cells and their neighbors are looked at here; FindPath expands
+   * whatever else is affected.
+   * @param cells The cells whose walls or costs changed, in any order and
+   * possibly with repeats
+   */
+  void UpdateCells(const std::vector<CellIndex>& cells);
+
+  /**
+   * Expands cells until the distance from the start to the goal is settled,
+   * then follows the distances from the start to write out the path
+   * @param path Filled with every cell of the path from start to goal, or
+   * left empty if there is no path
+   * @return Whether a path was found, its cost and the number of cells
+   * expanded by this call
+   */
+  SearchResult FindPath(std::vector<CellIndex>& path);
+
+  /**
+   * Getter methods that return the cells the path runs between
+   */
+  CellIndex GetStart() const;
+  CellIndex GetGoal() const;
+
+  /**
+   * Getter method that returns the number of different cells whose costs
+   * were recomputed or that were expanded since the last call to Reset,
+   * SetStart or UpdateCells, which shows how much of the map a repair had to
+   * look at
+   */
+  size_t GetNumTouched() const;
+
+ private:
+  // The cost of a cell that can't reach the goal. It is far enough below
+  // INT_MAX that adding an H cost to it can't overflow.
+  static const int kInfinity = INT_MAX / 4;
+
+  /**
+   * Helper method that returns the lowest cost of reaching the goal through
+   * one of a cell's neighbors, from their G costs
+   */
+  int CalculateRhs(CellIndex index) const;
+
+  /**
+   * Helper method that puts a cell on the open set if its G and RHS costs
+   * disagree, with a key matching its current costs, and takes it off
+   * otherwise
+   */
+  void UpdateCell(CellIndex index);
+
+  /**
+   * Helper method that checks whether the open set holds a cell with a
+   * smaller key than the start, or the start's own costs disagree, in which
+   * case the start's distance isn't settled yet
+   */
+  bool StartIsSettled() const;
+
+  /**
+   * Helper method that counts a cell towards GetNumTouched
+   */
+  void Touch(CellIndex index);
+
+  /**
+   * Helper method that fills neighbors with the open cells next to a cell
+   * and returns how many there are
+   */
+  int GetNeighbors(CellIndex index, CellIndex neighbors[4]) const;
+
+  const GridMap& map_;
+  CellIndex start_ = kNoCell;
+  CellIndex goal_ = kNoCell;
+
+  // How far the start has moved since Reset. Moving the start lowers the H
+  // cost of the cells on the open set by at most this much, so it is added
+  // to every new key instead of recomputing the old ones.
+  int key_offset_ = 0;
+
+  std::vector<int> g_costs_;
+  std::vector<int> rhs_costs_;
+  OpenSet open_set_;
+
+  CellSet touched_;
+  size_t num_touched_ = 0;
+};
+
+inline void Replanner::Touch(CellIndex index) {
+  if (!touched_.Contains(index)) {
+    touched_.Insert(index);
+    num_touched_++;
+  }
+}
+
+}  // namespace pathfinder
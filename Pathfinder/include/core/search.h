@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "core/connectivity.h"
+#include "core/grid_map.h"
+#include "core/search_context.h"
+
+namespace pathfinder {
+
+/**
+ * Summary of a single query, filled in by FindPath
+ */
+struct SearchResult {
+  // Whether a path from the start to the goal exists
+  bool found;
+
+  // The G cost of the goal, or 0 if no path was found. It is in the units
+  // of the search's connectivity, where a straight step onto a cell with
+  // cost 1 costs kStraightCost.
+  int cost;
+
+  // The number of cells in the path, including the start and goal
+  size_t path_length;
+
+  // The number of cells that were taken off the open set and expanded
+  size_t num_expanded;
+};
+
+/**
+ * FindPath keeps the cells waiting to be expanded in a BucketQueue instead of
+ * the open set's heap on maps where no cell costs more than this to step on
+ */
+const int kMaxBucketCost = 64;
+
+/**
+ * Method that calculates the Manhattan distance between two cells, which is
+ * the H cost used by every search unless it has landmarks
+ */
+int ManhattanDistance(const GridMap& map, CellIndex from, CellIndex to);
+
+/**
+ * Method that calculates the H cost of a cell for a search: the Manhattan
+ * distance, or the ALT lower bound from the context's landmarks when that is
+ * larger. Both never overestimate, so neither does the larger of the two.
+ * @param context The search the cost is for
+ * @param from The cell the cost is estimated from
+ * @param to The cell the search is trying to reach
+ */
+int EstimateCost(const SearchContext& context, CellIndex from, CellIndex to);
+
+/**
+ * Records a route to a cell, putting it into the open set or lowering its G
+ * cost if it is already open and the new route is shorter
+ * @param context The search that the cell belongs to
+ * @param cell The cell that has been reached, which must not be closed
+ * @param parent The cell it was reached from
+ * @param g_cost The cost of the route to the cell through parent
+ * @param goal The cell the search is trying to reach
+ */
+void OpenCell(SearchContext& context, CellIndex cell, CellIndex parent,
+              int g_cost, CellIndex goal);
+
+/**
+ * Forgets the context's previous search and puts start into the open set
+ * @param context The scratch space used for the search
+ * @param start The cell the search starts from
+ * @param goal The cell the search is trying to reach
+ */
+void StartSearch(SearchContext& context, CellIndex start, CellIndex goal);
+
+/**
+ * Finds the neighbors of a given cell and adds the proper ones to the open
+ * set, lowering the G cost of neighbors that are already open when a shorter
+ * route to them is found. Stepping onto a neighbor adds its cost to the G
+ * cost.
+ * @param context The search that the cell belongs to
+ * @param current The cell that the neighbors will be found for
+ * @param goal The cell the search is trying to reach
+ */
+void FindNeighbors(SearchContext& context, CellIndex current, CellIndex goal);
+
+/**
+ * Follows the parents recorded by a finished search back from the goal and
+ * writes the path out from start to goal
+ * @param state The state of a search that reached the goal
+ * @param start The cell the search started from
+ * @param goal The cell the search reached
+ * @param path Replaced with the cells of the path from start to goal
+ * @return The number of cells in the path
+ */
+size_t ReconstructPath(const SearchState& state, CellIndex start,
+                       CellIndex goal, std::vector<CellIndex>& path);
+
+/**
+ * Finds the cheapest path between two cells of the context's map, moving
+ * between cells that share an edge and paying the cost of every cell stepped
+ * onto. Once the context and path have room for every cell in the map,
+ * repeated calls make no heap allocations.
+ * @param context The scratch space used for the search
+ * @param start The cell the path starts from
+ * @param goal The cell the path has to reach
+ * @param path Filled with the cells of the path from start to goal, or left
+ * empty if there is no path
+ * @return Whether a path was found, its cost and the number of expanded cells
+ */
+SearchResult FindPath(SearchContext& context, CellIndex start, CellIndex goal,
+                      std::vector<CellIndex>& path);
+
+/**
+ * Finds the cheapest path between two cells like FindPath, moving the way a
+ * connectivity policy allows. FindPath<FourConnected> is the same search as
+ * FindPath. Landmark distances count straight steps, which would overestimate
+ * diagonal routes, so other policies use their own distance as the H cost
+ * and ignore the context's landmarks. This is instantiated for FourConnected
+ * and for EightConnected with each CornerCutting.
+ * @tparam Connectivity The policy for which cells are one step apart and
+ * what the step costs
+ * @param context The scratch space used for the search
+ * @param start The cell the path starts from
+ * @param goal The cell the path has to reach
+ * @param path Filled with the cells of the path from start to goal, or left
+ * empty if there is no path
+ * @return Whether a path was found, its cost and the number of expanded cells
+ */
+template <typename Connectivity>
+SearchResult FindPath(SearchContext& context, CellIndex start, CellIndex goal,
+                      std::vector<CellIndex>& path);
+
+}  // namespace pathfinder
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "core/bucket_queue.h"
+#include "core/grid_map.h"
+#include "core/landmarks.h"
+#include "core/open_set.h"
+#include "core/search_state.h"
+
+namespace pathfinder {
+
+class TraceWriter;
+
+/**
+ * Scratch space for searching one map: the open set, the bucket queue, the
+ * per-cell search state and a path buffer, all sized to the map when the
+ * context is created.
+ * A context can be reused for any number of queries against the same map
+ * without allocating, but it can only run one search at a time.
+ */
+class SearchContext {
+ public:
+  /**
+   * Constructor for a SearchContext that can search the given map. The map
+   * is not copied, so it has to outlive the context.
+   */
+  explicit SearchContext(const GridMap& map);
+
+  /**
+   * Points the context at a different map, reallocating its buffers only if
+   * the number of cells changed
+   */
+  void SetMap(const GridMap& map);
+
+  /**
+   * Getter method that returns the map being searched
+   */
+  const GridMap& GetMap() const;
+
+  /**
+   * Setter method for the landmarks used to estimate H costs. They have to
+   * be built for the context's map.
+   * @param landmarks The landmarks to use, or nullptr to estimate H costs
+   * with the Manhattan distance alone
+   */
+  void SetLandmarks(const LandmarkTable* landmarks);
+
+  /**
+   * Getter method that returns the landmarks used to estimate H costs, or
+   * nullptr if there are none
+   */
+  const LandmarkTable* GetLandmarks() const;
+
+  /**
+   * Setter method for the writer that searches in this context record their
+   * events with. Events are only recorded when the library is built with
+   * PATHFINDER_TRACE.
+   * @param trace The writer to use, or nullptr to stop tracing
+   */
+  void SetTrace(TraceWriter* trace);
+
+  /**
+   * Getter method that returns the writer events are recorded with, or
+   * nullptr if the context isn't being traced
+   */
+  TraceWriter* GetTrace() const;
+
+  /**
+   * Empties the open set and forgets the state of the previous search
+   */
+  void Reset();
+
+  /**
+   * Getter methods that return the open set of the current search
+   */
+  OpenSet& GetOpenSet();
+  const OpenSet& GetOpenSet() const;
+
+  /**
+   * Getter method that returns the bucket queue FindPath uses in place of
+   * the open set when step costs are small
+   */
+  BucketQueue& GetBucketQueue();
+
+  /**
+   * Getter method that returns the context's OpenSet or BucketQueue, for
+   * searches that take the type of queue as a template argument
+   */
+  template <typename Queue>
+  Queue& GetQueue();
+
+  /**
+   * Getter methods that return the per-cell state of the current search
+   */
+  SearchState& GetState();
+  const SearchState& GetState() const;
+
+  /**
+   * Getter method that returns a path buffer with room for every cell in the
+   * map, for callers that don't keep their own
+   */
+  std::vector<CellIndex>& GetPathBuffer();
+
+ private:
+  const GridMap* map_;
+  const LandmarkTable* landmarks_ = nullptr;
+  TraceWriter* trace_ = nullptr;
+  OpenSet open_set_;
+  BucketQueue bucket_queue_;
+  SearchState state_;
+  std::vector<CellIndex> path_buffer_;
+};
+
+inline const GridMap& SearchContext::GetMap() const {
+  return *map_;
+}
+
+inline const LandmarkTable* SearchContext::GetLandmarks() const {
+  return landmarks_;
+}
+
+inline TraceWriter* SearchContext::GetTrace() const {
+  return trace_;
+}
+
+inline OpenSet& SearchContext::GetOpenSet() {
+  return open_set_;
+}
+
+inline const OpenSet& SearchContext::GetOpenSet() const {
+  return open_set_;
+}
+
+inline BucketQueue& SearchContext::GetBucketQueue() {
+  return bucket_queue_;
+}
+
+template <>
+inline OpenSet& SearchContext::GetQueue<OpenSet>() {
+  return open_set_;
+}
+
+template <>
+inline BucketQueue& SearchContext::GetQueue<BucketQueue>() {
+  return bucket_queue_;
+}
+
+inline SearchState& SearchContext::GetState() {
+  return state_;
+}
+
+inline const SearchState& SearchContext::GetState() const {
+  return state_;
+}
+
+}  // namespace pathfinder
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/grid_map.h"
+
+namespace pathfinder {
+
+/**
+ * Per-cell bookkeeping for a single search: the G cost and parent of every
+ * cell that has been reached, and whether it has been closed.
+ *
+ * Each cell carries the generation of the search that last touched it, so a
+ * cell only counts as visited if its stamp matches the current generation.
+ * Starting a new search on a map of the same size just bumps the generation,
+ * which makes Reset O(1) instead of clearing every array.
+ */
+class SearchState {
+ public:
+  /**
+   * Constructor for the state of a search over a map with num_cells cells
+   */
+  explicit SearchState(size_t num_cells = 0);
+
+  /**
+   * Forgets every cell visited by the previous search. This only touches
+   * memory when the number of cells changes or the generation wraps around.
+   * @param num_cells The number of cells in the map being searched
+   */
+  void Reset(size_t num_cells);
+
+  /**
+   * Checks whether the cell has been reached by the current search
+   */
+  bool IsVisited(CellIndex index) const;
+
+  /**
+   * Checks whether the cell has been expanded by the current search
+   */
+  bool IsClosed(CellIndex index) const;
+
+  /**
+   * Getter method that returns the G cost of a cell, or 0 if the current
+   * search has not reached it
+   */
+  int GetGCost(CellIndex index) const;
+
+  /**
+   * Getter method that returns the cell that the current search reached the
+   * given cell from, or kNoCell if it has no parent
+   */
+  CellIndex GetParent(CellIndex index) const;
+
+  /**
+   * Records that the current search reached a cell, or found a cheaper route
+   * to it
+   * @param index The cell that was reached
+   * @param g_cost The cost of the route to the cell
+   * @param parent The cell the route came from
+   */
+  void Visit(CellIndex index, int g_cost, CellIndex parent);
+
+  /**
+   * Marks a cell as expanded. A cell that was never visited is given a G cost
+   * of 0 and no parent.
+   */
+  void Close(CellIndex index);
+
+ private:
+  // The lowest bit of a stamp is the closed flag, the rest is the generation
+  static const uint32_t kMaxGeneration = UINT32_MAX >> 1;
+
+  std::vector<uint32_t> stamps_;
+  std::vector<int> g_costs_;
+  std::vector<CellIndex> parents_;
+  uint32_t generation_;
+};
+
+inline bool SearchState::IsVisited(CellIndex index) const {
+  return (stamps_[index] >> 1) == generation_;
+}
+
+inline bool SearchState::IsClosed(CellIndex index) const {
+  return stamps_[index] == ((generation_ << 1) | 1);
+}
+
+inline int SearchState::GetGCost(CellIndex index) const {
+  return IsVisited(index) ? g_costs_[index] : 0;
+}
+
+inline CellIndex SearchState::GetParent(CellIndex index) const {
+  return IsVisited(index) ? parents_[index] : kNoCell;
+}
+
+inline void SearchState::Visit(CellIndex index, int g_cost, CellIndex parent) {
+  stamps_[index] = generation_ << 1;
+  g_costs_[index] = g_cost;
+  parents_[index] = parent;
+}
+
+inline void SearchState::Close(CellIndex index) {
+  if (!IsVisited(index)) {
+    Visit(index, 0, kNoCell);
+  }
+  stamps_[index] |= 1;
+}
+
+/**
+ * A set of cells that can be emptied in O(1), using the same generation
+ * stamps as SearchState
+ */
+class CellSet {
+ public:
+  /**
+   * Constructor for an empty set of cells from a map with num_cells cells
+   */
+  explicit CellSet(size_t num_cells = 0);
+
+  /**
+   * Empties the set and makes room for a map with num_cells cells
+   */
+  void Resize(size_t num_cells);
+
+  /**
+   * Removes every cell from the set
+   */
+  void Clear();
+
+  /**
+   * Adds a cell to the set
+   */
+  void Insert(CellIndex index);
+
+  /**
+   * Checks whether the cell is in the set
+   */
+  bool Contains(CellIndex index) const;
+
+ private:
+  std::vector<uint32_t> stamps_;
+  uint32_t generation_;
+};
+
+inline void CellSet::Insert(CellIndex index) {
+  stamps_[index] = generation_;
+}
+
+inline bool CellSet::Contains(CellIndex index) const {
+  return index < stamps_.size() && stamps_[index] == generation_;
+}
+
+}  // namespace pathfinder
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "core/grid_map.h"
+
+/**
+ * Records an event of the search running in a SearchContext, if the context
+ * has a TraceWriter. Searches are only traced when the library is built with
+ * PATHFINDER_TRACE defined; otherwise this expands to nothing and none of its
+ * arguments are evaluated.
+ * @param context The SearchContext the search runs in
+ * @param type The TraceEventType, without its enum name, such as kPush
+ * @param cell The cell the event is about
+ * @param cost The cost recorded with the event
+ */
+#ifdef PATHFINDER_TRACE
+#define PATHFINDER_TRACE_EVENT(context, type, cell, cost)             \
+  do {                                                                \
+    ::pathfinder::TraceWriter* trace_writer = (context).GetTrace();   \
+    if (trace_writer != nullptr) {                                    \
+      trace_writer->Record(::pathfinder::TraceEventType::type, (cell), \
+                           (cost));                                   \
+    }                                                                 \
+  } while (false)
+#else
+#define PATHFINDER_TRACE_EVENT(context, type, cell, cost) \
+  do {                                                    \
+  } while (false)
+#endif
+
+namespace pathfinder {
+
+/**
+ * The things a search does that are written to a trace
+ */
+enum class TraceEventType : uint8_t {
+  // A new query starts from cell. The cost is 0.
+  kStart,
+
+  // The query started by the last kStart is trying to reach cell
+  kGoal,
+
+  // cell is put into the queue with the given F cost
+  kPush,
+
+  // cell is already queued, and a cheaper route lowers its F cost to the
+  // given one
+  kDecreaseKey,
+
+  // cell is taken from the queue to be expanded, with the given G cost
+  kPop,
+
+  // cell is the next cell of the path that was found, from the start to the
+  // goal, with its G cost
+  kPath
+};
+
+/**
+ * One event of a trace, stored in 8 bytes: the cell, and the type in the top
+ * 8 bits of a 32 bit number whose low 24 bits hold the cost
+ */
+struct TraceEvent {
+  // The largest cost that can be stored. Larger costs are stored as this.
+  static const int kMaxCost = (1 << 24) - 1;
+
+  /**
+   * Builds an event, clamping the cost to [0, kMaxCost]
+   */
+  static TraceEvent Make(TraceEventType type, CellIndex cell, int cost);
+
+  /**
+   * Getter method that returns what happened
+   */
+  TraceEventType GetType() const;
+
+  /**
+   * Getter method that returns the cost recorded with the event
+   */
+  int GetCost() const;
+
+  CellIndex cell;
+  uint32_t type_and_cost;
+};
+
+/**
+ * Writes the events of searches to a stream in a compact binary format, so
+ * slow queries can be looked at offline. A trace starts with a header and
+ * the map, then holds 8 bytes per event until the end of the stream, so
+ * queries can be added to it for as long as it is open:
+ *
+ *   "PFTR", version, number of rows, number of columns
+ *     (4 bytes each, numbers little endian)
+ *   one byte per cell in row-major order: 0 for a wall, or its cost
+ *   per event: the cell, then the type and cost (4 bytes each)
+ *
+ * Events are encoded into a buffer that is written to the stream in large
+ * blocks. A writer is attached to a SearchContext with SetTrace, and only
+ * one thread may record with it at a time.
+ */
+class TraceWriter {
+ public:
+  /**
+   * Constructor for a writer that writes to the given stream, which has to
+   * outlive it
+   */
+  explicit TraceWriter(std::ostream& output);
+
+  /**
+   * Writes any events that are still buffered
+   */
+  ~TraceWriter();
+
+  TraceWriter(const TraceWriter&) = delete;
+  TraceWriter& operator=(const TraceWriter&) = delete;
+
+  /**
+   * Writes the header and the map, which has to be done before any event is
+   * recorded
+   * @param map The map the traced searches run on
+   * @return Whether the stream is still good
+   */
+  bool WriteHeader(const GridMap& map);
+
+  /**
+   * Adds an event to the trace
+   */
+  void Record(TraceEventType type, CellIndex cell, int cost);
+
+  /**
+   * Writes the buffered events to the stream
+   * @return Whether the stream is still good
+   */
+  bool Flush();
+
+  /**
+   * Getter method that returns the number of events recorded so far
+   */
+  size_t GetNumEvents() const;
+
+ private:
+  // Bytes of events buffered before they are written out
+  static const size_t kBufferSize = 1 << 16;
+
+  std::ostream& output_;
+  std::vector<char> buffer_;
+  size_t num_events_;
+};
+
+/**
+ * A trace read back from a stream
+ */
+struct SearchTrace {
+  GridMap map;
+  std::vector<TraceEvent> events;
+};
+
+/**
+ * Reads a trace written by a TraceWriter. A partly written event at the end,
+ * as left by a process that stopped while tracing, is ignored.
+ * @param input The stream the trace is read from
+ * @param trace Filled with the trace
+ * @return false if the data is not a trace, is too short for the map its
+ * header describes or has events for cells off the map, in which case trace
+ * is left empty
+ */
+bool LoadTrace(std::istream& input, SearchTrace& trace);
+
+inline TraceEvent TraceEvent::Make(TraceEventType type, CellIndex cell,
+                                   int cost) {
+  if (cost < 0) {
+    cost = 0;
+  } else if (cost > kMaxCost) {
+    cost = kMaxCost;
+  }
+  TraceEvent event;
+  event.cell = cell;
+  event.type_and_cost = ((uint32_t)type << 24) | (uint32_t)cost;
+  return event;
+}
+
+inline TraceEventType TraceEvent::GetType() const {
+  return (TraceEventType)(type_and_cost >> 24);
+}
+
+inline int TraceEvent::GetCost() const {
+  return (int)(type_and_cost & kMaxCost);
+}
+
+inline void TraceWriter::Record(TraceEventType type, CellIndex cell,
+                                int cost) {
+  TraceEvent event = TraceEvent::Make(type, cell, cost);
+  if (buffer_.size() + 8 > kBufferSize) {
+    Flush();
+  }
+  for (int i = 0; i < 4; i++) {
+    buffer_.push_back((char)((event.cell >> (8 * i)) & 0xFF));
+  }
+  for (int i = 0; i < 4; i++) {
+    buffer_.push_back((char)((event.type_and_cost >> (8 * i)) & 0xFF));
+  }
+  num_events_++;
+}
+
+}  // namespace pathfinder
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace pathfinder {
+
+/**
+ * A fixed size queue that one thread pushes to and another pops from without
+ * locks. Each side only writes its own index, and reads the other side's
+ * index with acquire ordering, so an element is fully written before the
+ * consumer can see it and fully read before the producer can reuse its slot.
+ *
+ * The two indices count every element ever pushed and popped, and are kept
+ * on separate cache lines so the threads don't invalidate each other's line
+ * on every operation.
+ * @tparam T The type of the elements, which has to be copyable
+ */
+template <typename T>
+class SpscRingBuffer {
+ public:
+  /**
+   * Constructor for an empty buffer
+   * @param capacity The most elements the buffer can hold, which is rounded
+   * up to a power of two
+   */
+  explicit SpscRingBuffer(size_t capacity);
+
+  SpscRingBuffer(const SpscRingBuffer&) = delete;
+  SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+  /**
+   * Getter method that returns the most elements the buffer can hold
+   */
+  size_t GetCapacity() const;
+
+  /**
+   * Adds an element to the back of the buffer. Only the producer thread may
+   * call this.
+   * @return false if the buffer is full, in which case nothing is added
+   */
+  bool TryPush(const T& element);
+
+  /**
+   * Takes the element at the front of the buffer. Only the consumer thread
+   * may call this.
+   * @param element Set to the element taken
+   * @return false if the buffer is empty, in which case element is unchanged
+   */
+  bool TryPop(T& element);
+
+  /**
+   * Checks whether the buffer is empty. This is exact for the consumer, but
+   * only a snapshot for any other thread.
+   */
+  bool Empty() const;
+
+  /**
+   * Empties the buffer. Neither thread may be using it at the time.
+   */
+  void Clear();
+
+ private:
+  // The size of a cache line on the CPUs this is expected to run on
+  static const size_t kCacheLineSize = 64;
+
+  std::vector<T> elements_;
+  size_t mask_;
+
+  // The number of elements popped, only written by the consumer
+  alignas(kCacheLineSize) std::atomic<size_t> head_;
+
+  // The number of elements pushed, only written by the producer
+  alignas(kCacheLineSize) std::atomic<size_t> tail_;
+};
+
+template <typename T>
+const size_t SpscRingBuffer<T>::kCacheLineSize;
+
+template <typename T>
+SpscRingBuffer<T>::SpscRingBuffer(size_t capacity) : head_(0), tail_(0) {
+  size_t size = 1;
+  while (size < capacity) {
+    size *= 2;
+  }
+  elements_.resize(size);
+  mask_ = size - 1;
+}
+
+template <typename T>
+inline size_t SpscRingBuffer<T>::GetCapacity() const {
+  return elements_.size();
+}
+
+template <typename T>
+inline bool SpscRingBuffer<T>::TryPush(const T& element) {
+  size_t tail = tail_.load(std::memory_order_relaxed);
+  if (tail - head_.load(std::memory_order_acquire) == elements_.size()) {
+    return false;
+  }
+  elements_[tail & mask_] = element;
+  tail_.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+inline bool SpscRingBuffer<T>::TryPop(T& element) {
+  size_t head = head_.load(std::memory_order_relaxed);
+  if (head == tail_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  element = elements_[head & mask_];
+  head_.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+inline bool SpscRingBuffer<T>::Empty() const {
+  return head_.load(std::memory_order_acquire) ==
+         tail_.load(std::memory_order_acquire);
+}
+
+template <typename T>
+void SpscRingBuffer<T>::Clear() {
+  head_.store(0, std::memory_order_relaxed);
+  tail_.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace pathfinder
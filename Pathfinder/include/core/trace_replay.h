@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "core/grid_map.h"
+#include "core/search_trace.h"
+
+namespace pathfinder {
+
+/**
+ * What the search of a query being replayed has done with a cell so far
+ */
+enum class ReplayCellState {
+  // The search hasn't reached the cell
+  kUnseen,
+
+  // The cell is in the queue
+  kOpen,
+
+  // The cell has been taken from the queue
+  kClosed,
+
+  // The cell is on the path that was found
+  kPath
+};
+
+/**
+ * Steps through the events of one query of a trace, in either direction and
+ * by any number of events at a time, so a search can be scrubbed through at
+ * any speed.
+ *
+ * When a query is selected, the first event that opened, closed and put each
+ * cell on the path is found, so the state of any cell at any position is a
+ * lookup, and moving the position only changes the cells of the events moved
+ * past.
+ */
+class TraceReplay {
+ public:
+  /**
+   * Constructor for a replay of a trace with no events
+   */
+  TraceReplay();
+
+  /**
+   * Constructor for a replay of the given trace, with its first query
+   * selected and no events applied
+   */
+  explicit TraceReplay(const SearchTrace& trace);
+
+  /**
+   * Getter method that returns the map the trace was recorded on
+   */
+  const GridMap& GetMap() const;
+
+  /**
+   * Getter method that returns the number of queries in the trace, each of
+   * which starts with a kStart event
+   */
+  size_t GetNumQueries() const;
+
+  /**
+   * Selects which query is replayed, and moves back to its first event
+   * @param query The query to replay, which has to be below GetNumQueries
+   */
+  void SelectQuery(size_t query);
+
+  /**
+   * Getter method that returns the query being replayed
+   */
+  size_t GetQuery() const;
+
+  /**
+   * Getter methods that return the start and goal of the query being
+   * replayed, or kNoCell if there are no queries
+   */
+  CellIndex GetStart() const;
+  CellIndex GetGoal() const;
+
+  /**
+   * Getter method that returns the number of events in the query
+   */
+  size_t GetNumSteps() const;
+
+  /**
+   * Getter method that returns how many of the query's events have been
+   * applied
+   */
+  size_t GetPosition() const;
+
+  /**
+   * Moves to a position, clamped to GetNumSteps
+   * @param position How many of the query's events should be applied
+   * @param changed Has the cells whose state may have changed added to it
+   */
+  void Seek(size_t position, std::vector<CellIndex>& changed);
+
+  /**
+   * Getter method that returns what the search had done with a cell at the
+   * current position
+   */
+  ReplayCellState GetCellState(CellIndex index) const;
+
+ private:
+  // Marks cells no event of the query applies to
+  static const size_t kNever = (size_t)-1;
+
+  GridMap map_;
+  std::vector<TraceEvent> events_;
+
+  // The index in events_ of the kStart event of each query
+  std::vector<size_t> query_starts_;
+  size_t query_ = 0;
+  size_t first_event_ = 0;
+  size_t end_event_ = 0;
+  size_t position_ = 0;
+
+  // The step of the query at which each cell was first opened, closed and
+  // put on the path, or kNever
+  std::vector<size_t> opened_at_;
+  std::vector<size_t> closed_at_;
+  std::vector<size_t> path_at_;
+};
+
+inline ReplayCellState TraceReplay::GetCellState(CellIndex index) const {
+  // A step is applied once the position has moved past it
+  if (path_at_[index] < position_) {
+    return ReplayCellState::kPath;
+  }
+  if (closed_at_[index] < position_) {
+    return ReplayCellState::kClosed;
+  }
+  if (opened_at_[index] < position_) {
+    return ReplayCellState::kOpen;
+  }
+  return ReplayCellState::kUnseen;
+}
+
+}  // namespace pathfinder
@@ -1,7 +1,15 @@
 #pragma once
 
 #include "cinder/gl/gl.h"
+#include "core/background_search.h"
+#include "core/flow_field.h"
+#include "core/grid_map.h"
 #include "core/pathfinder.h"
+#include "core/replanner.h"
+#include "core/search_state.h"
+#include "core/search_trace.h"
+#include "core/trace_replay.h"
+#include "visualizer/grid_renderer.h"
 
 namespace pathfinder {
 
@@ -32,8 +40,10 @@ class Grid {
 
   /**
    * Displays the current state of the sketchpad in the Cinder application.
+   * Only the cells marked dirty since the last frame are recolored, and
+   * renderer_ only uploads the rows whose colors changed.
    */
-  void Draw() const;
+  void Draw();
 
   /**
    * Update the current_cell that is being looked at
@@ -43,13 +53,35 @@ class Grid {
   /**
    * Shades in the sketchpad pixels whose centers are within brush_radius units
    * of the brush's location. (One unit is equal to the length of one sketchpad
-   * pixel.)
+   * pixel.) The pixel under the brush is always shaded. Only the rows and
+   * columns the brush covers are visited, so it costs the same on any size
+   * of map. This starts a new stroke.
    *
    * @param brush_screen_coords the screen coordinates at which the brush is
    *           located
    */
   void HandleBrush(const glm::vec2& brush_screen_coords);
 
+  /**
+   * Continues a stroke, shading in every sketchpad pixel the brush passed
+   * over on its way from where it last was, so a fast drag leaves no gaps
+   *
+   * @param brush_screen_coords the screen coordinates the brush moved to
+   */
+  void DragBrush(const glm::vec2& brush_screen_coords);
+
+  /**
+   * Setter method for the radius of the brush, which is kept between half a
+   * sketchpad pixel, covering only the pixel under the brush, and 32 pixels
+   * @param brush_radius The new radius in sketchpad pixels
+   */
+  void SetBrushRadius(double brush_radius);
+
+  /**
+   * Getter method that returns the radius of the brush in sketchpad pixels
+   */
+  double GetBrushRadius() const;
+
   /**
    * Set all of the cells to an empty state and clear different member variables
    */
@@ -61,6 +93,7 @@ class Grid {
    * 1 means drawing an start cell
    * 2 means drawing an end cell
    * 3 means drawing an obstacle
+   * 4 means drawing mud, which costs more to cross
    * @param state integer representing the current state of the cell
    */
   void SetDrawState(int state);
@@ -73,33 +106,255 @@ class Grid {
    */
   void SetState(bool pathfinding);
 
+  /**
+   * Setter method for how the pathfinder expands cells. With jump point
+   * search only the jump points are moved to, and they stay highlighted.
+   * @param mode The search mode to use from the next search on
+   */
+  void SetSearchMode(SearchMode mode);
+
+  /**
+   * Method that doubles how many steps of the search are shown each frame,
+   * until the whole search is shown as soon as it is done
+   */
+  void SpeedUp();
+
+  /**
+   * Method that halves how many steps of the search are shown each frame,
+   * down to one step a frame
+   */
+  void SlowDown();
+
+  /**
+   * Method that switches the pathfinder between the Manhattan distance and
+   * landmark distances for its H costs. Landmarks are built again every time
+   * a search starts, since the walls may have changed.
+   */
+  void ToggleLandmarks();
+
+  /**
+   * Method that switches between drawing the search and drawing a heat map
+   * of the distance from every cell to the end point, which is kept up to
+   * date as the brush changes the map
+   */
+  void ToggleFlowField();
+
+  /**
+   * Replaces the map with the one a trace was recorded on and shows its
+   * first query, with none of its events applied. The sketchpad takes as
+   * many pixels per side as the trace's map has rows or columns, whichever
+   * is more, in the same space on screen, and any pixels outside the map
+   * are walls. The brush and searches are off until the sketchpad is
+   * cleared, which keeps its new size.
+   * @param trace The trace to replay
+   */
+  void LoadTrace(const SearchTrace& trace);
+
+  /**
+   * Method that starts or pauses playing the trace being replayed, which
+   * shows as many events each frame as a live search shows steps. Playing
+   * from the end starts over.
+   */
+  void TogglePlayback();
+
+  /**
+   * Methods that move the trace being replayed forwards or backwards by as
+   * many events as a live search shows steps in a frame
+   */
+  void StepForward();
+  void StepBackward();
+
+  /**
+   * Method that replays the next query in the trace, or the first after the
+   * last one
+   */
+  void NextQuery();
+
  private:
   /**
-   * Helper method that will find the path based on the pathfinding state and
-   * if there is a start and end node
+   * Helper method that shows the steps the search has taken since the last
+   * frame, as many as the speed and the frame's time budget allow
    */
   void FindPath();
 
   /**
-   * Helper method that checks if a certain vector contains an element
-   * @param list The list that we want to check
-   * @param element The element that we are looking for
-   * @return true if the vector does contain the element, false if it doesn't
+   * Helper method that updates what is drawn for one step of the search
+   */
+  void HandleSearchEvent(const SearchEvent& event);
+
+  /**
+   * Helper method that shows one query of the trace being replayed from its
+   * first event
+   */
+  void ShowQuery(size_t query);
+
+  /**
+   * Helper method that moves the trace being replayed to the given event of
+   * its query and marks the cells whose state may have changed dirty
+   */
+  void SeekReplay(size_t position);
+
+  /**
+   * Helper method that returns how the trace being replayed has reached the
+   * cell at (row, col), which is kUnseen off the trace's map
+   */
+  ReplayCellState GetReplayState(size_t row, size_t col) const;
+
+  /**
+   * Helper method that returns the index in map_ of a cell of the trace's
+   * map
+   */
+  CellIndex GetReplayIndex(CellIndex trace_index) const;
+
+  /**
+   * Helper method that keeps a path that has been found up to date after the
+   * brush changes walls or moves the start or end, by repairing the search
+   * with replanner_ instead of starting it over
    */
-  bool ContainsElement(std::vector<Cell> list, Cell element) const;
+  void RepairPath();
+
+  /**
+   * Helper method that builds flow_field_ towards the end point, or with no
+   * goals if there is no end point
+   */
+  void BuildFlowField();
+
+  /**
+   * Helper method that converts screen coordinates to sketchpad coordinates,
+   * where one unit is the side of a sketchpad pixel
+   */
+  glm::vec2 ToSketchpadCoords(const glm::vec2& screen_coords) const;
+
+  /**
+   * Helper method that is called before the brush paints anything
+   */
+  void BeginStroke();
+
+  /**
+   * Helper method that paints every pixel whose center is within
+   * brush_radius_ of center, given in sketchpad coordinates
+   */
+  void PaintCircle(const glm::vec2& center);
+
+  /**
+   * Helper method that paints one pixel with the current draw state
+   */
+  void PaintCell(size_t row, size_t col);
+
+  /**
+   * Helper method that brings the path and the heat map up to date with
+   * what the brush has painted
+   */
+  void EndStroke();
+
+  /**
+   * Helper method that records that a cell may need to be drawn in a
+   * different color. Each cell is only recorded once between draws.
+   */
+  void MarkDirty(CellIndex index);
+
+  /**
+   * Helper method that records that every cell may need to be drawn in a
+   * different color, for changes that aren't local to a few cells
+   */
+  void MarkAllDirty();
+
+  /**
+   * Helper method that marks the start, end and current cells dirty
+   */
+  void MarkEndpointsDirty();
+
+  /**
+   * Helper method that marks every cell of the path being drawn dirty
+   */
+  void MarkPathDirty();
+
+  /**
+   * Helper method that returns the index of a cell in map_
+   */
+  CellIndex GetIndex(const Cell& cell) const;
+
+  /**
+   * Helper method that works out the color a cell is drawn in from its type,
+   * the search and the heat map
+   */
+  ci::Color8u GetCellColor(size_t row, size_t col) const;
+
+  /**
+   * Helper method that works out the heat map color of a cell, which goes
+   * from red next to the end point to blue at the cells farthest from it
+   */
+  ci::Color8u GetHeatColor(CellIndex index) const;
+
+  /**
+   * Helper method that works out what a cell should be drawn as from the map
+   * and the current start and end points
+   * @return The CellType of the cell at (row, col)
+   */
+  CellType GetCellType(size_t row, size_t col) const;
 
   glm::vec2 top_left_corner_;
   size_t num_pixels_per_side_;
   double pixel_side_length_;
   double brush_radius_;
 
-  std::vector<Cell> path_;
+  // Where the brush was last, in sketchpad coordinates, so a drag can paint
+  // the line between that and where it is now
+  glm::vec2 last_brush_coords_;
+
+  // The path found by the search, from the start to the end
+  std::vector<CellIndex> path_;
+  // What it costs to step onto a cell painted with mud
+  static const int kMudCost = 5;
+
+  CellSet path_cells_;
+
+  // Every cell the search has moved to, which are the jump points when
+  // searching with jump point search
+  CellSet expanded_cells_;
   Cell start_cell_ = Cell(CellType::kEmpty, 0, 0);
   Cell end_cell_ = Cell(CellType::kEmpty, 0, 0);
-  std::vector<std::vector<Cell>> cells_;
+  GridMap map_;
+  GridRenderer renderer_;
   Cell current_cell_ = Cell(CellType::kEmpty, 0, 0);
-  pathfinder::Pathfinder pathfinder_ =
-      Pathfinder(cells_, start_cell_, start_cell_);
+
+  // Runs the search on its own thread, on a copy of map_
+  BackgroundSearch search_;
+  SearchMode search_mode_ = SearchMode::kAStar;
+  bool use_landmarks_ = false;
+
+  // The most steps of the search shown in one frame, which doubles with each
+  // SpeedUp up to kMaxStepsPerFrame, and then becomes kUnlimitedSteps
+  static const size_t kMaxStepsPerFrame = 4096;
+  static const size_t kUnlimitedSteps = SIZE_MAX;
+  size_t steps_per_frame_ = 1;
+
+  // How many steps are shown between checks of the frame's time budget
+  static const size_t kStepsPerClockCheck = 64;
+
+  // Takes over from search_ once a path has been found, so that walls
+  // painted afterwards only repair the part of the search they affect
+  Replanner replanner_ = Replanner(map_);
+  std::vector<CellIndex> changed_cells_;
+  std::vector<CellIndex> replanned_path_;
+
+  // The cells whose colors may have changed since the last draw, so a frame
+  // only recolors what the brush or the search touched
+  CellSet dirty_cells_;
+  std::vector<CellIndex> dirty_list_;
+  bool all_dirty_ = true;
+
+  // The trace being replayed, which takes the place of the search while
+  // replaying_ is true. It moves forward by steps_per_frame_ events each
+  // frame while playing_ is true.
+  TraceReplay replay_;
+  std::vector<CellIndex> replay_changed_;
+  bool replaying_ = false;
+  bool playing_ = false;
+
+  // Only built while show_flow_field_ is true
+  FlowField flow_field_;
+  bool show_flow_field_ = false;
   int draw_state_ = 0;
   bool pathfinding_ = false;
   bool allowed_ = false;
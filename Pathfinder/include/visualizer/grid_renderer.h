@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "cinder/gl/gl.h"
+#include "core/grid_map.h"
+
+namespace pathfinder {
+
+namespace visualizer {
+
+/**
+ * Draws a grid of colored cells with a single quad. Each cell is one texel of
+ * a texture, stretched over the grid with nearest filtering, and the lines
+ * between cells are drawn by the fragment shader, so drawing costs the same
+ * number of calls whatever the size of the grid.
+ *
+ * Cell colors are kept in a buffer on the CPU, and only the rows that changed
+ * since the last draw are uploaded to the texture.
+ */
+class GridRenderer {
+ public:
+  /**
+   * Constructor for a renderer of a grid whose cells are all black. No GL
+   * objects are made until the first Draw, so it can be constructed before
+   * there is a GL context.
+   * @param num_rows The number of rows of cells
+   * @param num_cols The number of columns of cells
+   */
+  GridRenderer(size_t num_rows, size_t num_cols);
+
+  /**
+   * Setter method for the color a cell is drawn in. Setting the color a cell
+   * already has does nothing.
+   * @param index The row-major index of the cell
+   * @param color The new color of the cell
+   */
+  void SetColor(CellIndex index, const ci::Color8u& color);
+
+  /**
+   * Uploads the rows whose colors changed and draws the grid
+   * @param bounds Where on the screen the grid is drawn
+   */
+  void Draw(const ci::Rectf& bounds);
+
+ private:
+  /**
+   * Helper method that makes the texture and the shader the first time the
+   * grid is drawn
+   */
+  void CreateGlObjects();
+
+  // Each cell takes 4 bytes, so rows never need padding to be uploaded
+  static const size_t kBytesPerCell = 4;
+
+  size_t num_rows_;
+  size_t num_cols_;
+
+  // RGBA colors of the cells in row-major order
+  std::vector<uint8_t> colors_;
+
+  // The rows in [first_changed_row_, end_changed_row_) are out of date on
+  // the GPU
+  size_t first_changed_row_;
+  size_t end_changed_row_;
+
+  ci::gl::Texture2dRef texture_;
+  ci::gl::GlslProgRef program_;
+};
+
+}  // namespace visualizer
+
+}  // namespace pathfinder
@@ -24,6 +24,11 @@ class PathfinderApp : public ci::app::App {
   const size_t kImageDimension = 28;
 
  private:
+  /**
+   * Helper method that asks for a trace file and replays it
+   */
+  void LoadTrace();
+
   Grid grid_;
 };
 
@@ -0,0 +1,106 @@
+#include <core/background_search.h>
+
+#include <chrono>
+#include <vector>
+
+namespace pathfinder {
+
+const size_t BackgroundSearch::kDefaultCapacity;
+
+namespace {
+
+// How long the search waits before trying again when the buffer is full
+const std::chrono::milliseconds kFullWait(1);
+
+}  // namespace
+
+BackgroundSearch::BackgroundSearch(size_t capacity)
+    : events_(capacity),
+      stopping_(false),
+      pathfinder_(map_, Cell(CellType::kStart, 0, 0),
+                  Cell(CellType::kEnd, 0, 0)) {
+}
+
+BackgroundSearch::~BackgroundSearch() {
+  Stop();
+}
+
+void BackgroundSearch::Start(const GridMap& map, CellIndex start,
+                             CellIndex goal, SearchMode mode,
+                             bool use_landmarks) {
+  Stop();
+  map_ = map;
+  start_ = start;
+  goal_ = goal;
+  mode_ = mode;
+  use_landmarks_ = use_landmarks;
+  events_.Clear();
+  stopping_.store(false);
+  thread_ = std::thread(&BackgroundSearch::Run, this);
+}
+
+void BackgroundSearch::Stop() {
+  stopping_.store(true);
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+bool BackgroundSearch::Poll(SearchEvent& event) {
+  return events_.TryPop(event);
+}
+
+void BackgroundSearch::Run() {
+  // The map is set first, so the pathfinder's buffers, start and goal all
+  // match it before the mode and heuristic restart the search. Those only
+  // build a jump table or landmarks if the pathfinder wasn't already using
+  // them, since SetGrid rebuilds whatever is in use.
+  Cell start = Cell(CellType::kStart, map_.GetRow(start_), map_.GetCol(start_));
+  Cell end = Cell(CellType::kEnd, map_.GetRow(goal_), map_.GetCol(goal_));
+  pathfinder_.SetGrid(map_, start, end);
+  pathfinder_.SetSearchMode(mode_);
+  pathfinder_.SetUseLandmarks(use_landmarks_);
+
+  Cell current = start;
+  while (!pathfinder_.PathFound(current)) {
+    if (pathfinder_.IsExhausted()) {
+      Send(SearchEvent::Type::kFinished, kNoCell);
+      return;
+    }
+    current = pathfinder_.FindNextCell(current);
+    const CellPosition& position = current.GetPosition();
+    if (!Send(SearchEvent::Type::kExpand,
+              map_.GetIndex(position.row, position.col))) {
+      return;
+    }
+  }
+
+  // GetPath goes from the end back to the start
+  const std::vector<Cell>& path = pathfinder_.GetPath(end);
+  for (size_t i = path.size(); i > 0; i--) {
+    const CellPosition& position = path[i - 1].GetPosition();
+    if (!Send(SearchEvent::Type::kPath,
+              map_.GetIndex(position.row, position.col))) {
+      return;
+    }
+  }
+  Send(SearchEvent::Type::kFinished, goal_);
+}
+
+bool BackgroundSearch::Send(SearchEvent::Type type, CellIndex cell) {
+  SearchEvent event;
+  event.type = type;
+  event.cell = cell;
+
+  // A full buffer means the consumer is far behind, so the search sleeps
+  // rather than spinning until it catches up
+  while (!events_.TryPush(event)) {
+    if (stopping_.load(std::memory_order_relaxed)) {
+      return false;
+    }
+    std::this_thread::sleep_for(kFullWait);
+  }
+  return !stopping_.load(std::memory_order_relaxed);
+}
+
+}  // namespace pathfinder
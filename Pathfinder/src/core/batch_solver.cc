@@ -0,0 +1,149 @@
+#include <core/batch_solver.h>
+
+#include <algorithm>
+
+namespace pathfinder {
+
+const size_t BatchSolver::kChunkSize;
+
+BatchSolver::BatchSolver(const GridMap& map, size_t num_threads) : map_(map) {
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  for (size_t worker = 0; worker < num_threads; worker++) {
+    contexts_.emplace_back(new SearchContext(map_));
+    ranges_.emplace_back(new WorkRange());
+  }
+
+  // The thread calling Solve acts as worker 0, so it needs no thread of its own
+  for (size_t worker = 1; worker < num_threads; worker++) {
+    threads_.emplace_back(&BatchSolver::WorkerLoop, this, worker);
+  }
+}
+
+BatchSolver::~BatchSolver() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  batch_started_.notify_all();
+  for (std::thread& thread : threads_) {
+    thread.join();
+  }
+}
+
+size_t BatchSolver::GetNumThreads() const {
+  return contexts_.size();
+}
+
+void BatchSolver::Solve(const std::vector<Query>& queries,
+                        std::vector<SearchResult>& results) {
+  results.resize(queries.size());
+  if (queries.empty()) {
+    return;
+  }
+
+  // Split the batch into one contiguous range per worker
+  size_t num_workers = ranges_.size();
+  for (size_t worker = 0; worker < num_workers; worker++) {
+    std::lock_guard<std::mutex> lock(ranges_[worker]->mutex);
+    ranges_[worker]->begin = queries.size() * worker / num_workers;
+    ranges_[worker]->end = queries.size() * (worker + 1) / num_workers;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queries_ = &queries;
+    results_ = &results;
+    num_busy_threads_ = threads_.size();
+    batch_number_++;
+  }
+  batch_started_.notify_all();
+
+  SolveQueries(0);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  batch_finished_.wait(lock, [this] { return num_busy_threads_ == 0; });
+  queries_ = nullptr;
+  results_ = nullptr;
+}
+
+void BatchSolver::WorkerLoop(size_t worker) {
+  size_t last_batch = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      batch_started_.wait(lock, [this, last_batch] {
+        return stopping_ || batch_number_ != last_batch;
+      });
+      if (stopping_) {
+        return;
+      }
+      last_batch = batch_number_;
+    }
+
+    SolveQueries(worker);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    num_busy_threads_--;
+    if (num_busy_threads_ == 0) {
+      batch_finished_.notify_one();
+    }
+  }
+}
+
+void BatchSolver::SolveQueries(size_t worker) {
+  SearchContext& context = *contexts_[worker];
+  std::vector<CellIndex>& path = context.GetPathBuffer();
+  size_t begin;
+  size_t end;
+  while (TakeWork(worker, begin, end)) {
+    for (size_t query = begin; query < end; query++) {
+      (*results_)[query] = FindPath(context, (*queries_)[query].start,
+                                    (*queries_)[query].goal, path);
+    }
+  }
+}
+
+bool BatchSolver::TakeWork(size_t worker, size_t& begin, size_t& end) {
+  size_t num_workers = ranges_.size();
+  while (true) {
+    {
+      WorkRange& own = *ranges_[worker];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (own.begin < own.end) {
+        begin = own.begin;
+        end = std::min(own.end, own.begin + kChunkSize);
+        own.begin = end;
+        return true;
+      }
+    }
+
+    // Steal the back half of the first worker that still has queries left
+    bool stole = false;
+    for (size_t offset = 1; offset < num_workers && !stole; offset++) {
+      WorkRange& victim = *ranges_[(worker + offset) % num_workers];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (victim.begin < victim.end) {
+        size_t middle = victim.begin + (victim.end - victim.begin) / 2;
+        begin = middle;
+        end = victim.end;
+        victim.end = middle;
+        stole = true;
+      }
+    }
+    if (!stole) {
+      return false;
+    }
+
+    // Keep the stolen queries in this worker's range so they can be stolen
+    // again while it works through them
+    WorkRange& own = *ranges_[worker];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    own.begin = begin;
+    own.end = end;
+  }
+}
+
+}  // namespace pathfinder
@@ -0,0 +1,217 @@
+#include <core/bidirectional_search.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace pathfinder {
+
+namespace {
+
+// Number of cells each direction expands between comparisons of the two
+// frontiers when they run on separate threads
+const size_t kRoundSize = 256;
+
+/**
+ * Helper method that expands up to kRoundSize cells from one direction
+ * @return The number of cells that were expanded
+ */
+size_t ExpandRound(SearchContext& context, CellIndex target, bool backward,
+                   std::vector<CellIndex>& reached) {
+  SearchState& state = context.GetState();
+  OpenSet& open_set = context.GetOpenSet();
+  reached.clear();
+
+  size_t num_expanded = 0;
+  while (num_expanded < kRoundSize && !open_set.Empty()) {
+    CellIndex current = open_set.Pop();
+    state.Close(current);
+    ExpandFrontier(context, current, target, backward, reached);
+    num_expanded++;
+  }
+  return num_expanded;
+}
+
+}  // namespace
+
+void ExpandFrontier(SearchContext& context, CellIndex current, CellIndex target,
+                    bool backward, std::vector<CellIndex>& reached) {
+  const GridMap& map = context.GetMap();
+  const SearchState& state = context.GetState();
+  int row = map.GetRow(current);
+  int col = map.GetCol(current);
+  int current_cost = state.GetGCost(current);
+
+  const int kRowSteps[] = {-1, 0, 0, 1};
+  const int kColSteps[] = {0, -1, 1, 0};
+  for (int direction = 0; direction < 4; direction++) {
+    int neighbor_row = row + kRowSteps[direction];
+    int neighbor_col = col + kColSteps[direction];
+    if (!map.InBounds(neighbor_row, neighbor_col)) {
+      continue;
+    }
+    CellIndex neighbor = map.GetIndex(neighbor_row, neighbor_col);
+    if (!map.IsPassable(neighbor) || state.IsClosed(neighbor)) {
+      continue;
+    }
+
+    int g_cost = current_cost + map.GetCost(backward ? current : neighbor);
+    if (!state.IsVisited(neighbor) || g_cost < state.GetGCost(neighbor)) {
+      OpenCell(context, neighbor, current, g_cost, target);
+      reached.push_back(neighbor);
+    }
+  }
+}
+
+void MeetFrontiers(const SearchContext& context, const SearchContext& other,
+                   const std::vector<CellIndex>& reached, Meeting& meeting) {
+  const SearchState& state = context.GetState();
+  const SearchState& other_state = other.GetState();
+  for (CellIndex cell : reached) {
+    if (!other_state.IsVisited(cell)) {
+      continue;
+    }
+    int cost = state.GetGCost(cell) + other_state.GetGCost(cell);
+    if (cost < meeting.cost) {
+      meeting.cell = cell;
+      meeting.cost = cost;
+    }
+  }
+}
+
+bool FrontiersAreDone(const SearchContext& forward,
+                      const SearchContext& backward, const Meeting& meeting) {
+  const OpenSet& forward_open = forward.GetOpenSet();
+  const OpenSet& backward_open = backward.GetOpenSet();
+  if (forward_open.Empty() || backward_open.Empty()) {
+    return true;
+  }
+  return meeting.cell != kNoCell &&
+         (forward_open.GetTopFCost() >= meeting.cost ||
+          backward_open.GetTopFCost() >= meeting.cost);
+}
+
+size_t ReconstructBidirectionalPath(const SearchState& forward,
+                                    const SearchState& backward,
+                                    CellIndex start, CellIndex goal,
+                                    CellIndex meeting,
+                                    std::vector<CellIndex>& path) {
+  // The backward search's parents point towards the goal, so its half is
+  // already in order
+  ReconstructPath(forward, start, meeting, path);
+  for (CellIndex index = meeting; index != goal;) {
+    index = backward.GetParent(index);
+    path.push_back(index);
+  }
+  return path.size();
+}
+
+SearchResult FindBidirectionalPath(SearchContext& forward,
+                                   SearchContext& backward, CellIndex start,
+                                   CellIndex goal, std::vector<CellIndex>& path,
+                                   bool concurrent) {
+  SearchResult result;
+  result.found = false;
+  result.cost = 0;
+  result.path_length = 0;
+  result.num_expanded = 0;
+  path.clear();
+
+  const GridMap& map = forward.GetMap();
+  if (!map.IsPassable(start) || !map.IsPassable(goal)) {
+    return result;
+  }
+
+  StartSearch(forward, start, goal);
+  StartSearch(backward, goal, start);
+  Meeting meeting;
+  std::vector<CellIndex> forward_reached = {start};
+  std::vector<CellIndex> backward_reached;
+  MeetFrontiers(forward, backward, forward_reached, meeting);
+
+  if (!concurrent) {
+    while (!FrontiersAreDone(forward, backward, meeting)) {
+      // Expanding the smaller frontier keeps the two about the same size
+      bool use_forward =
+          forward.GetOpenSet().Size() <= backward.GetOpenSet().Size();
+      SearchContext& context = use_forward ? forward : backward;
+      SearchContext& other = use_forward ? backward : forward;
+      std::vector<CellIndex>& reached =
+          use_forward ? forward_reached : backward_reached;
+
+      CellIndex current = context.GetOpenSet().Pop();
+      context.GetState().Close(current);
+      reached.clear();
+      ExpandFrontier(context, current, use_forward ? goal : start,
+                     !use_forward, reached);
+      MeetFrontiers(context, other, reached, meeting);
+      result.num_expanded++;
+    }
+  } else {
+    // round is the number of the round the backward thread should run next,
+    // and finished the last round it has completed
+    std::mutex mutex;
+    std::condition_variable round_changed;
+    unsigned round = 0;
+    unsigned finished = 0;
+    bool stop = false;
+    size_t backward_expanded = 0;
+
+    std::thread backward_thread([&]() {
+      for (unsigned done = 0;;) {
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          round_changed.wait(lock, [&] { return round != done || stop; });
+          if (stop) {
+            return;
+          }
+          done = round;
+        }
+        backward_expanded +=
+            ExpandRound(backward, start, true, backward_reached);
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          finished = done;
+        }
+        round_changed.notify_all();
+      }
+    });
+
+    while (!FrontiersAreDone(forward, backward, meeting)) {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        round++;
+      }
+      round_changed.notify_all();
+      result.num_expanded += ExpandRound(forward, goal, false, forward_reached);
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        round_changed.wait(lock, [&] { return finished == round; });
+      }
+
+      // Both threads are waiting now, so the frontiers can be compared
+      MeetFrontiers(forward, backward, forward_reached, meeting);
+      MeetFrontiers(backward, forward, backward_reached, meeting);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    round_changed.notify_all();
+    backward_thread.join();
+    result.num_expanded += backward_expanded;
+  }
+
+  if (meeting.cell == kNoCell) {
+    return result;
+  }
+  result.found = true;
+  result.cost = meeting.cost;
+  result.path_length =
+      ReconstructBidirectionalPath(forward.GetState(), backward.GetState(),
+                                   start, goal, meeting.cell, path);
+  return result;
+}
+
+}  // namespace pathfinder
@@ -0,0 +1,78 @@
+#include <core/bit_scan.h>
+
+namespace pathfinder {
+
+namespace {
+
+const int kBitsPerWord = 64;
+
+/**
+ * Helper method that reads 64 cells of a row or column of the map, where line
+ * is the row or column and first is the position of the lowest bit along it
+ */
+uint64_t ReadLine(const GridMap& map, bool vertical, int line, int first) {
+  return vertical ? map.GetColumnBits(line, first)
+                  : map.GetRowBits(line, first);
+}
+
+/**
+ * Helper method that checks a single cell of a row or column of the map
+ */
+bool IsOpen(const GridMap& map, bool vertical, int line, int position) {
+  int row = vertical ? position : line;
+  int col = vertical ? line : position;
+  return map.InBounds(row, col) && map.IsPassable(map.GetIndex(row, col));
+}
+
+/**
+ * Helper method that finds the cells with a forced neighbor on one side of the
+ * line, for a scan that moves one cell along the line with every step. The
+ * cells one step back are the same word shifted by one, with a single cell
+ * from past the end of the window shifted in.
+ * @param side The row or column beside the line
+ * @param first The position of the lowest bit along the line
+ * @param step 1 when moving towards higher positions, -1 otherwise
+ */
+uint64_t FindForced(const GridMap& map, bool vertical, int side, int first,
+                    int step) {
+  uint64_t open = ReadLine(map, vertical, side, first);
+  uint64_t previous;
+  if (step > 0) {
+    previous = (open << 1) | IsOpen(map, vertical, side, first - 1);
+  } else {
+    previous = (open >> 1) |
+               ((uint64_t)IsOpen(map, vertical, side, first + kBitsPerWord)
+                << (kBitsPerWord - 1));
+  }
+  return open & ~previous;
+}
+
+}  // namespace
+
+int ScanLine(const GridMap& map, CellIndex from, Direction direction) {
+  bool vertical = direction == kUp || direction == kDown;
+  int line = vertical ? map.GetCol(from) : map.GetRow(from);
+  int position = vertical ? map.GetRow(from) : map.GetCol(from);
+  int step = direction == kDown || direction == kRight ? 1 : -1;
+
+  // Each pass reads the next 64 cells of the line, along with the lines on
+  // either side of it. The window always starts or ends right next to the
+  // cells already scanned, depending on the direction.
+  for (int next = position + step;; next += step * kBitsPerWord) {
+    int first = step > 0 ? next : next - (kBitsPerWord - 1);
+    uint64_t open = ReadLine(map, vertical, line, first);
+    uint64_t forced = FindForced(map, vertical, line - 1, first, step) |
+                      FindForced(map, vertical, line + 1, first, step);
+    uint64_t stops = ~open | forced;
+    if (stops == 0) {
+      continue;
+    }
+
+    int bit = step > 0 ? CountTrailingZeros(stops)
+                       : kBitsPerWord - 1 - CountLeadingZeros(stops);
+    int steps = (first + bit - position) * step;
+    return (open >> bit) & 1 ? steps : -(steps - 1);
+  }
+}
+
+}  // namespace pathfinder
@@ -0,0 +1,22 @@
+#include <core/bucket_queue.h>
+
+namespace pathfinder {
+
+void BucketQueue::Reset(size_t num_cells, int max_spread) {
+  size_t num_buckets = 1;
+  while (num_buckets <= (size_t)max_spread) {
+    num_buckets *= 2;
+  }
+  heads_.assign(num_buckets, kNoCell);
+  bucket_mask_ = (int)num_buckets - 1;
+  lowest_f_cost_ = 0;
+  size_ = 0;
+
+  if (f_costs_.size() != num_cells) {
+    f_costs_.assign(num_cells, 0);
+    next_.assign(num_cells, kNoCell);
+    previous_.assign(num_cells, kNoCell);
+  }
+}
+
+}  // namespace pathfinder
@@ -2,27 +2,20 @@
 
 namespace pathfinder {
 
-Cell::Cell(CellType type, int x_pos = 0, int y_pos = 0) {
+Cell::Cell(CellType type, size_t row, size_t col) {
   type_ = type;
-  kPosition_ = glm::vec2(x_pos, y_pos);
+  kPosition_.row = (uint16_t)row;
+  kPosition_.col = (uint16_t)col;
 }
 
 const CellType& Cell::GetType() const {
   return type_;
 }
 
-const glm::vec2& Cell::GetPosition() const {
+const CellPosition& Cell::GetPosition() const {
   return kPosition_;
 }
 
-void Cell::SetPreviousCell(Cell& previous_cell) {
-  previous_cell_ = &previous_cell;
-}
-
-const Cell * Cell::GetPreviousCell() {
-  return previous_cell_;
-}
-
 void Cell::SetGCost(const int new_cost) {
   g_cost_ = new_cost;
 }
@@ -39,6 +32,10 @@ const int Cell::GetGCost() const {
   return g_cost_;
 }
 
+const int Cell::GetHCost() const {
+  return h_cost_;
+}
+
 void Cell::SetType(const CellType& type) {
   type_ = type;
 }
@@ -0,0 +1,230 @@
+#include <core/flow_field.h>
+
+#include <algorithm>
+
+namespace pathfinder {
+
+const int FlowField::kUnreachable;
+const uint8_t FlowField::kNoDirection;
+const size_t FlowField::kMinParallelLevel;
+
+FlowField::FlowField(size_t num_threads) {
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  next_levels_.resize(num_threads);
+
+  // The thread calling Build acts as worker 0, so it needs no thread of its own
+  for (size_t worker = 1; worker < num_threads; worker++) {
+    threads_.emplace_back(&FlowField::WorkerLoop, this, worker);
+  }
+}
+
+FlowField::~FlowField() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  task_started_.notify_all();
+  for (std::thread& thread : threads_) {
+    thread.join();
+  }
+}
+
+size_t FlowField::GetNumThreads() const {
+  return next_levels_.size();
+}
+
+void FlowField::Build(const GridMap& map, const std::vector<CellIndex>& goals) {
+  map_ = &map;
+  if (map.GetNumCells() != num_cells_ || !distances_) {
+    num_cells_ = map.GetNumCells();
+    distances_.reset(new std::atomic<int>[num_cells_]);
+  }
+  for (size_t index = 0; index < num_cells_; index++) {
+    distances_[index].store(kUnreachable, std::memory_order_relaxed);
+  }
+  directions_.assign(num_cells_, kNoDirection);
+
+  CellIndex num_cols = (CellIndex)map.GetNumCols();
+  steps_[kUp] = 0 - num_cols;
+  steps_[kDown] = num_cols;
+  steps_[kLeft] = 0 - (CellIndex)1;
+  steps_[kRight] = 1;
+
+  level_.clear();
+  for (CellIndex goal : goals) {
+    if (map.IsPassable(goal) &&
+        distances_[goal].load(std::memory_order_relaxed) == kUnreachable) {
+      distances_[goal].store(0, std::memory_order_relaxed);
+      level_.push_back(goal);
+    }
+  }
+  level_distance_ = 0;
+  max_distance_ = level_.empty() ? kUnreachable : 0;
+
+  while (!level_.empty()) {
+    if (threads_.empty() || level_.size() < kMinParallelLevel) {
+      ExpandLevel(0, level_.size(), next_levels_[0]);
+    } else {
+      RunTask(Task::kExpand);
+    }
+
+    level_.clear();
+    for (std::vector<CellIndex>& next_level : next_levels_) {
+      level_.insert(level_.end(), next_level.begin(), next_level.end());
+      next_level.clear();
+    }
+    level_distance_++;
+    if (!level_.empty()) {
+      max_distance_ = level_distance_;
+    }
+  }
+
+  if (threads_.empty()) {
+    PointDirections(0, (CellIndex)num_cells_);
+  } else {
+    RunTask(Task::kPointDirections);
+  }
+  map_ = nullptr;
+}
+
+int FlowField::GetDistance(CellIndex index) const {
+  return distances_[index].load(std::memory_order_relaxed);
+}
+
+int FlowField::GetMaxDistance() const {
+  return max_distance_;
+}
+
+void FlowField::GetPath(CellIndex start, std::vector<CellIndex>& path) const {
+  path.clear();
+  if (GetDistance(start) == kUnreachable) {
+    return;
+  }
+  for (CellIndex index = start; index != kNoCell; index = GetNextCell(index)) {
+    path.push_back(index);
+  }
+}
+
+void FlowField::WorkerLoop(size_t worker) {
+  size_t last_task = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_started_.wait(lock, [this, last_task] {
+        return stopping_ || task_number_ != last_task;
+      });
+      if (stopping_) {
+        return;
+      }
+      last_task = task_number_;
+    }
+
+    DoTask(worker);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    num_busy_threads_--;
+    if (num_busy_threads_ == 0) {
+      task_finished_.notify_one();
+    }
+  }
+}
+
+void FlowField::RunTask(Task task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_ = task;
+    num_busy_threads_ = threads_.size();
+    task_number_++;
+  }
+  task_started_.notify_all();
+
+  DoTask(0);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  task_finished_.wait(lock, [this] { return num_busy_threads_ == 0; });
+}
+
+void FlowField::DoTask(size_t worker) {
+  size_t num_workers = next_levels_.size();
+  if (task_ == Task::kExpand) {
+    ExpandLevel(level_.size() * worker / num_workers,
+                level_.size() * (worker + 1) / num_workers,
+                next_levels_[worker]);
+  } else {
+    PointDirections((CellIndex)(num_cells_ * worker / num_workers),
+                    (CellIndex)(num_cells_ * (worker + 1) / num_workers));
+  }
+}
+
+void FlowField::ExpandLevel(size_t begin, size_t end,
+                            std::vector<CellIndex>& next_level) {
+  size_t num_rows = map_->GetNumRows();
+  size_t num_cols = map_->GetNumCols();
+  int next_distance = level_distance_ + 1;
+
+  for (size_t i = begin; i < end; i++) {
+    CellIndex current = level_[i];
+    size_t row = current / num_cols;
+    size_t col = current - row * num_cols;
+    CellIndex neighbors[4];
+    int num_neighbors = 0;
+    if (row > 0) {
+      neighbors[num_neighbors++] = current - num_cols;
+    }
+    if (row + 1 < num_rows) {
+      neighbors[num_neighbors++] = current + num_cols;
+    }
+    if (col > 0) {
+      neighbors[num_neighbors++] = current - 1;
+    }
+    if (col + 1 < num_cols) {
+      neighbors[num_neighbors++] = current + 1;
+    }
+
+    for (int j = 0; j < num_neighbors; j++) {
+      std::atomic<int>& distance = distances_[neighbors[j]];
+      if (distance.load(std::memory_order_relaxed) != kUnreachable ||
+          !map_->IsPassable(neighbors[j])) {
+        continue;
+      }
+
+      // Another thread may reach the same cell from its share of the level,
+      // in which case only one of them adds it
+      int expected = kUnreachable;
+      if (distance.compare_exchange_strong(expected, next_distance,
+                                           std::memory_order_relaxed)) {
+        next_level.push_back(neighbors[j]);
+      }
+    }
+  }
+}
+
+void FlowField::PointDirections(CellIndex begin, CellIndex end) {
+  size_t num_rows = map_->GetNumRows();
+  size_t num_cols = map_->GetNumCols();
+
+  for (CellIndex index = begin; index < end; index++) {
+    int distance = distances_[index].load(std::memory_order_relaxed);
+    if (distance <= 0) {
+      continue;
+    }
+
+    // Neighbors are checked in a fixed order, so ties always go the same way
+    size_t row = index / num_cols;
+    size_t col = index - row * num_cols;
+    const bool in_bounds[] = {row > 0, row + 1 < num_rows, col > 0,
+                              col + 1 < num_cols};
+    for (uint8_t direction = kUp; direction <= kRight; direction++) {
+      if (in_bounds[direction] &&
+          distances_[index + steps_[direction]].load(
+              std::memory_order_relaxed) == distance - 1) {
+        directions_[index] = direction;
+        break;
+      }
+    }
+  }
+}
+
+}  // namespace pathfinder
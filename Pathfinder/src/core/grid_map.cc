@@ -0,0 +1,55 @@
+#include <core/grid_map.h>
+
+#include <algorithm>
+
+namespace pathfinder {
+
+GridMap::GridMap(size_t num_rows, size_t num_cols)
+    : num_rows_(num_rows), num_cols_(num_cols) {
+  Clear();
+}
+
+const int GridMap::kMaxCost;
+const size_t GridMap::kBitsPerWord;
+
+void GridMap::SetPassable(CellIndex index, bool passable) {
+  size_t column_index = GetCol(index) * num_rows_ + GetRow(index);
+  uint64_t mask = (uint64_t)1 << (index % kBitsPerWord);
+  uint64_t column_mask = (uint64_t)1 << (column_index % kBitsPerWord);
+  if (passable) {
+    passable_bits_[index / kBitsPerWord] |= mask;
+    passable_columns_[column_index / kBitsPerWord] |= column_mask;
+  } else {
+    passable_bits_[index / kBitsPerWord] &= ~mask;
+    passable_columns_[column_index / kBitsPerWord] &= ~column_mask;
+  }
+}
+
+void GridMap::SetCost(CellIndex index, int cost) {
+  cost = std::min(std::max(cost, 1), kMaxCost);
+  if (costs_.empty()) {
+    if (cost == 1) {
+      return;
+    }
+    costs_.assign(GetNumCells(), 1);
+  }
+  costs_[index] = (uint8_t)cost;
+  max_cost_ = std::max(max_cost_, cost);
+}
+
+void GridMap::Clear() {
+  size_t num_cells = GetNumCells();
+  size_t num_words = (num_cells + kBitsPerWord - 1) / kBitsPerWord;
+  passable_bits_.assign(num_words, ~(uint64_t)0);
+
+  // Keep the bits past the last cell cleared so they never read as passable
+  if (num_cells % kBitsPerWord != 0) {
+    passable_bits_.back() = ((uint64_t)1 << (num_cells % kBitsPerWord)) - 1;
+  }
+  passable_bits_.push_back(0);
+  passable_columns_ = passable_bits_;
+  costs_.clear();
+  max_cost_ = 1;
+}
+
+}  // namespace pathfinder
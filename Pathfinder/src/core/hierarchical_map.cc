@@ -0,0 +1,407 @@
+#include <core/hierarchical_map.h>
+
+#include <algorithm>
+
+namespace pathfinder {
+
+namespace {
+
+// Stretches of open border at least this long get an entrance at each end
+// instead of a single one in the middle, so routes that cross near either end
+// don't have to detour through the middle
+const size_t kMinDoubleEntranceLength = 6;
+
+}  // namespace
+
+const size_t HierarchicalMap::kDefaultClusterSize;
+
+HierarchicalMap::HierarchicalMap(const GridMap& map, size_t cluster_size)
+    : map_(map),
+      cluster_size_(std::max<size_t>(cluster_size, 1)),
+      num_cluster_rows_((map.GetNumRows() + cluster_size_ - 1) /
+                        cluster_size_),
+      num_cluster_cols_((map.GetNumCols() + cluster_size_ - 1) /
+                        cluster_size_),
+      context_(map) {
+  size_t num_clusters = num_cluster_rows_ * num_cluster_cols_;
+  bottom_transitions_.resize(num_clusters);
+  right_transitions_.resize(num_clusters);
+  clusters_.resize(num_clusters);
+  local_costs_.resize(cluster_size_ * cluster_size_);
+  local_parents_.resize(cluster_size_ * cluster_size_);
+  local_queue_.reserve(cluster_size_ * cluster_size_);
+  Rebuild();
+}
+
+void HierarchicalMap::Rebuild() {
+  for (size_t cluster = 0; cluster < clusters_.size(); cluster++) {
+    BuildBorder(cluster, false);
+    BuildBorder(cluster, true);
+  }
+  for (size_t cluster = 0; cluster < clusters_.size(); cluster++) {
+    BuildCluster(cluster);
+  }
+  num_rebuilt_clusters_ = clusters_.size();
+}
+
+void HierarchicalMap::UpdateCells(const std::vector<CellIndex>& cells) {
+  rebuilt_clusters_.clear();
+  for (CellIndex cell : cells) {
+    size_t cluster = GetCluster(cell);
+    size_t cluster_row = cluster / num_cluster_cols_;
+    size_t cluster_col = cluster % num_cluster_cols_;
+    size_t row = map_.GetRow(cell) - cluster_row * cluster_size_;
+    size_t col = map_.GetCol(cell) - cluster_col * cluster_size_;
+    rebuilt_clusters_.push_back(cluster);
+
+    // A cell on the edge of a cluster can change the entrances of that
+    // border, which are shared with the cluster on the other side
+    if (row == 0 && cluster_row > 0) {
+      BuildBorder(cluster - num_cluster_cols_, false);
+      rebuilt_clusters_.push_back(cluster - num_cluster_cols_);
+    }
+    if (row == cluster_size_ - 1 && cluster_row + 1 < num_cluster_rows_) {
+      BuildBorder(cluster, false);
+      rebuilt_clusters_.push_back(cluster + num_cluster_cols_);
+    }
+    if (col == 0 && cluster_col > 0) {
+      BuildBorder(cluster - 1, true);
+      rebuilt_clusters_.push_back(cluster - 1);
+    }
+    if (col == cluster_size_ - 1 && cluster_col + 1 < num_cluster_cols_) {
+      BuildBorder(cluster, true);
+      rebuilt_clusters_.push_back(cluster + 1);
+    }
+  }
+
+  std::sort(rebuilt_clusters_.begin(), rebuilt_clusters_.end());
+  rebuilt_clusters_.erase(
+      std::unique(rebuilt_clusters_.begin(), rebuilt_clusters_.end()),
+      rebuilt_clusters_.end());
+  for (size_t cluster : rebuilt_clusters_) {
+    BuildCluster(cluster);
+  }
+  num_rebuilt_clusters_ = rebuilt_clusters_.size();
+}
+
+SearchResult HierarchicalMap::FindPath(CellIndex start, CellIndex goal,
+                                       std::vector<CellIndex>& path) {
+  SearchResult result;
+  result.found = false;
+  result.cost = 0;
+  result.path_length = 0;
+  result.num_expanded = 0;
+  path.clear();
+
+  if (!map_.IsPassable(start) || !map_.IsPassable(goal)) {
+    return result;
+  }
+
+  // The start and goal are joined to the entrances of their own clusters for
+  // the length of this query only
+  size_t start_cluster = GetCluster(start);
+  size_t goal_cluster = GetCluster(goal);
+  const Cluster& first = clusters_[start_cluster];
+  const Cluster& last = clusters_[goal_cluster];
+
+  SearchCluster(goal);
+  goal_costs_.clear();
+  for (CellIndex entrance : last.entrances) {
+    goal_costs_.push_back(local_costs_[GetLocalIndex(entrance)]);
+  }
+  int direct_cost =
+      start_cluster == goal_cluster ? local_costs_[GetLocalIndex(start)] : -1;
+
+  SearchCluster(start);
+  start_costs_.clear();
+  for (CellIndex entrance : first.entrances) {
+    start_costs_.push_back(local_costs_[GetLocalIndex(entrance)]);
+  }
+
+  StartSearch(context_, start, goal);
+  SearchState& state = context_.GetState();
+  OpenSet& open_set = context_.GetOpenSet();
+  while (!open_set.Empty()) {
+    CellIndex current = open_set.Pop();
+    state.Close(current);
+    if (current == goal) {
+      result.found = true;
+      break;
+    }
+    result.num_expanded++;
+
+    int g_cost = state.GetGCost(current);
+    if (current == start) {
+      for (size_t i = 0; i < first.entrances.size(); i++) {
+        if (start_costs_[i] >= 0 && !state.IsClosed(first.entrances[i])) {
+          OpenCell(context_, first.entrances[i], current,
+                   g_cost + start_costs_[i], goal);
+        }
+      }
+      if (direct_cost >= 0) {
+        OpenCell(context_, goal, current, g_cost + direct_cost, goal);
+      }
+    }
+
+    // Everything else on the open set is an entrance, which leads to the
+    // other entrances of its cluster and across the border it lies on. The
+    // start can be an entrance too.
+    size_t cluster = GetCluster(current);
+    const Cluster& entrances = clusters_[cluster];
+    size_t num_entrances = entrances.entrances.size();
+    size_t slot = std::find(entrances.entrances.begin(),
+                            entrances.entrances.end(), current) -
+                  entrances.entrances.begin();
+    if (slot == num_entrances) {
+      continue;
+    }
+
+    for (size_t other = 0; other < num_entrances; other++) {
+      int distance = entrances.distances[slot * num_entrances + other];
+      CellIndex entrance = entrances.entrances[other];
+      if (distance > 0 && !state.IsClosed(entrance)) {
+        OpenCell(context_, entrance, current, g_cost + distance, goal);
+      }
+    }
+    for (size_t link = 0; link < entrances.link_cells.size(); link++) {
+      CellIndex cell = entrances.link_cells[link];
+      if (entrances.link_entrances[link] == slot && !state.IsClosed(cell)) {
+        OpenCell(context_, cell, current, g_cost + 1, goal);
+      }
+    }
+    if (cluster == goal_cluster && goal_costs_[slot] >= 0) {
+      OpenCell(context_, goal, current, g_cost + goal_costs_[slot], goal);
+    }
+  }
+
+  if (!result.found) {
+    return result;
+  }
+  result.cost = state.GetGCost(goal);
+
+  // Fill in the cells between each pair of entrances on the abstract path.
+  // Pairs in different clusters are the two sides of a border, so they are
+  // already next to each other.
+  abstract_path_.clear();
+  for (CellIndex index = goal; index != start; index = state.GetParent(index)) {
+    abstract_path_.push_back(index);
+  }
+  path.push_back(start);
+  for (size_t i = abstract_path_.size(); i > 0; i--) {
+    CellIndex from = path.back();
+    CellIndex to = abstract_path_[i - 1];
+    if (GetCluster(from) == GetCluster(to)) {
+      AppendClusterRoute(from, to, path);
+    } else {
+      path.push_back(to);
+    }
+  }
+  result.path_length = path.size();
+  return result;
+}
+
+size_t HierarchicalMap::GetClusterSize() const {
+  return cluster_size_;
+}
+
+size_t HierarchicalMap::GetNumClusters() const {
+  return clusters_.size();
+}
+
+size_t HierarchicalMap::GetNumEntrances() const {
+  size_t num_entrances = 0;
+  for (const Cluster& cluster : clusters_) {
+    num_entrances += cluster.entrances.size();
+  }
+  return num_entrances;
+}
+
+size_t HierarchicalMap::GetNumRebuiltClusters() const {
+  return num_rebuilt_clusters_;
+}
+
+size_t HierarchicalMap::GetCluster(CellIndex index) const {
+  return (map_.GetRow(index) / cluster_size_) * num_cluster_cols_ +
+         map_.GetCol(index) / cluster_size_;
+}
+
+void HierarchicalMap::BuildBorder(size_t cluster, bool vertical) {
+  std::vector<Transition>& transitions =
+      vertical ? right_transitions_[cluster] : bottom_transitions_[cluster];
+  transitions.clear();
+
+  // Clusters on the last row or column have nothing below or right of them
+  size_t cluster_row = cluster / num_cluster_cols_;
+  size_t cluster_col = cluster % num_cluster_cols_;
+  if (vertical ? cluster_col + 1 >= num_cluster_cols_
+               : cluster_row + 1 >= num_cluster_rows_) {
+    return;
+  }
+
+  size_t first_row = cluster_row * cluster_size_;
+  size_t first_col = cluster_col * cluster_size_;
+  size_t length = vertical
+                      ? std::min(cluster_size_, map_.GetNumRows() - first_row)
+                      : std::min(cluster_size_, map_.GetNumCols() - first_col);
+
+  // Returns the pair of cells at the given offset along the border
+  auto transition_at = [&](size_t offset) -> Transition {
+    Transition transition;
+    if (vertical) {
+      size_t col = first_col + cluster_size_ - 1;
+      transition.inside = map_.GetIndex(first_row + offset, col);
+      transition.outside = map_.GetIndex(first_row + offset, col + 1);
+    } else {
+      size_t row = first_row + cluster_size_ - 1;
+      transition.inside = map_.GetIndex(row, first_col + offset);
+      transition.outside = map_.GetIndex(row + 1, first_col + offset);
+    }
+    return transition;
+  };
+
+  size_t segment_start = 0;
+  size_t segment_length = 0;
+  for (size_t offset = 0; offset <= length; offset++) {
+    if (offset < length) {
+      Transition transition = transition_at(offset);
+      if (map_.IsPassable(transition.inside) &&
+          map_.IsPassable(transition.outside)) {
+        if (segment_length == 0) {
+          segment_start = offset;
+        }
+        segment_length++;
+        continue;
+      }
+    }
+
+    // A stretch of open border has just ended
+    if (segment_length == 0) {
+      continue;
+    }
+    if (segment_length < kMinDoubleEntranceLength) {
+      transitions.push_back(transition_at(segment_start + segment_length / 2));
+    } else {
+      transitions.push_back(transition_at(segment_start));
+      transitions.push_back(transition_at(segment_start + segment_length - 1));
+    }
+    segment_length = 0;
+  }
+}
+
+void HierarchicalMap::BuildCluster(size_t cluster) {
+  Cluster& built = clusters_[cluster];
+  built.entrances.clear();
+  built.link_entrances.clear();
+  built.link_cells.clear();
+
+  // Adds a transition out of the cluster, sharing the entrance with any
+  // other transition from the same cell
+  auto add_link = [&built](CellIndex inside, CellIndex outside) {
+    size_t slot =
+        std::find(built.entrances.begin(), built.entrances.end(), inside) -
+        built.entrances.begin();
+    if (slot == built.entrances.size()) {
+      built.entrances.push_back(inside);
+    }
+    built.link_entrances.push_back(slot);
+    built.link_cells.push_back(outside);
+  };
+
+  for (const Transition& transition : bottom_transitions_[cluster]) {
+    add_link(transition.inside, transition.outside);
+  }
+  for (const Transition& transition : right_transitions_[cluster]) {
+    add_link(transition.inside, transition.outside);
+  }
+  if (cluster >= num_cluster_cols_) {
+    for (const Transition& transition :
+         bottom_transitions_[cluster - num_cluster_cols_]) {
+      add_link(transition.outside, transition.inside);
+    }
+  }
+  if (cluster % num_cluster_cols_ > 0) {
+    for (const Transition& transition : right_transitions_[cluster - 1]) {
+      add_link(transition.outside, transition.inside);
+    }
+  }
+
+  // Routes inside a cluster can be walked either way, so each search only
+  // has to fill in the distances to the entrances after its own
+  size_t num_entrances = built.entrances.size();
+  built.distances.assign(num_entrances * num_entrances, -1);
+  for (size_t from = 0; from < num_entrances; from++) {
+    built.distances[from * num_entrances + from] = 0;
+    if (from + 1 == num_entrances) {
+      break;
+    }
+    SearchCluster(built.entrances[from]);
+    for (size_t to = from + 1; to < num_entrances; to++) {
+      int distance = local_costs_[GetLocalIndex(built.entrances[to])];
+      built.distances[from * num_entrances + to] = distance;
+      built.distances[to * num_entrances + from] = distance;
+    }
+  }
+}
+
+void HierarchicalMap::SearchCluster(CellIndex source) {
+  size_t cluster = GetCluster(source);
+  local_first_row_ = (cluster / num_cluster_cols_) * cluster_size_;
+  local_first_col_ = (cluster % num_cluster_cols_) * cluster_size_;
+  int num_rows = std::min(cluster_size_, map_.GetNumRows() - local_first_row_);
+  int num_cols = std::min(cluster_size_, map_.GetNumCols() - local_first_col_);
+
+  size_t first = GetLocalIndex(source);
+  std::fill(local_costs_.begin(), local_costs_.end(), -1);
+  local_queue_.clear();
+  local_queue_.push_back(first);
+  local_costs_[first] = 0;
+  local_parents_[first] = first;
+
+  // Every step costs the same, so a breadth first search reaches each cell
+  // by a shortest route. The queue holds positions inside the cluster, so
+  // moving between cells is a matter of adding to the row or column.
+  const int kRowSteps[] = {-1, 1, 0, 0};
+  const int kColSteps[] = {0, 0, -1, 1};
+  for (size_t next = 0; next < local_queue_.size(); next++) {
+    size_t current = local_queue_[next];
+    int row = current / cluster_size_;
+    int col = current % cluster_size_;
+    int cost = local_costs_[current] + 1;
+    for (int direction = 0; direction < 4; direction++) {
+      int neighbor_row = row + kRowSteps[direction];
+      int neighbor_col = col + kColSteps[direction];
+      if (neighbor_row < 0 || neighbor_row >= num_rows || neighbor_col < 0 ||
+          neighbor_col >= num_cols) {
+        continue;
+      }
+
+      size_t local = neighbor_row * cluster_size_ + neighbor_col;
+      if (local_costs_[local] != -1 ||
+          !map_.IsPassable(map_.GetIndex(local_first_row_ + neighbor_row,
+                                         local_first_col_ + neighbor_col))) {
+        continue;
+      }
+      local_costs_[local] = cost;
+      local_parents_[local] = current;
+      local_queue_.push_back(local);
+    }
+  }
+}
+
+size_t HierarchicalMap::GetLocalIndex(CellIndex index) const {
+  return (map_.GetRow(index) - local_first_row_) * cluster_size_ +
+         (map_.GetCol(index) - local_first_col_);
+}
+
+void HierarchicalMap::AppendClusterRoute(CellIndex from, CellIndex to,
+                                         std::vector<CellIndex>& path) {
+  // Searching back from to means following parents walks forward from from
+  SearchCluster(to);
+  for (size_t local = GetLocalIndex(from); local_costs_[local] > 0;) {
+    local = local_parents_[local];
+    path.push_back(map_.GetIndex(local_first_row_ + local / cluster_size_,
+                                 local_first_col_ + local % cluster_size_));
+  }
+}
+
+}  // namespace pathfinder
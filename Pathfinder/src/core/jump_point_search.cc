@@ -0,0 +1,295 @@
+#include <core/jump_point_search.h>
+
+#include <core/bit_scan.h>
+
+namespace pathfinder {
+
+namespace {
+
+// How a single step in each Direction changes the row and column
+const int kRowSteps[] = {-1, 1, 0, 0};
+const int kColSteps[] = {0, 0, -1, 1};
+
+/**
+ * Helper method that checks whether (row, col) is inside the map and passable
+ */
+bool IsOpen(const GridMap& map, int row, int col) {
+  return map.InBounds(row, col) && map.IsPassable(map.GetIndex(row, col));
+}
+
+/**
+ * Helper method that checks whether a cell entered in the given direction has
+ * a forced neighbor: a cell beside it that is open while the cell beside the
+ * previous one is a wall. Routes that turn into a forced neighbor can't take
+ * a shorter way around, so the jump has to stop there.
+ */
+bool HasForcedNeighbor(const GridMap& map, int row, int col,
+                       Direction direction) {
+  int row_step = kRowSteps[direction];
+  int col_step = kColSteps[direction];
+  if (row_step == 0) {
+    return (IsOpen(map, row - 1, col) &&
+            !IsOpen(map, row - 1, col - col_step)) ||
+           (IsOpen(map, row + 1, col) && !IsOpen(map, row + 1, col - col_step));
+  }
+  return (IsOpen(map, row, col - 1) && !IsOpen(map, row - row_step, col - 1)) ||
+         (IsOpen(map, row, col + 1) && !IsOpen(map, row - row_step, col + 1));
+}
+
+/**
+ * Helper method that returns the cell the given number of steps away from a
+ * cell in a direction
+ */
+CellIndex Step(const GridMap& map, CellIndex index, Direction direction,
+               int steps) {
+  return map.GetIndex(map.GetRow(index) + steps * kRowSteps[direction],
+                      map.GetCol(index) + steps * kColSteps[direction]);
+}
+
+}  // namespace
+
+void JumpTable::Build(const GridMap& map) {
+  distances_.assign(4 * map.GetNumCells(), 0);
+  int num_rows = map.GetNumRows();
+  int num_cols = map.GetNumCols();
+
+  // Each sweep runs against the direction of the jump, so the distance of the
+  // next cell along is always known. Horizontal distances come first because
+  // vertical jumps stop wherever a horizontal jump would find a jump point.
+  for (int row = 0; row < num_rows; row++) {
+    for (int col = num_cols - 1; col >= 0; col--) {
+      int next_col = col + 1;
+      int& distance = distances_[4 * map.GetIndex(row, col) + kRight];
+      if (!IsOpen(map, row, next_col)) {
+        distance = 0;
+      } else if (HasForcedNeighbor(map, row, next_col, kRight)) {
+        distance = 1;
+      } else {
+        int next = GetDistance(map.GetIndex(row, next_col), kRight);
+        distance = next > 0 ? next + 1 : next - 1;
+      }
+    }
+    for (int col = 0; col < num_cols; col++) {
+      int next_col = col - 1;
+      int& distance = distances_[4 * map.GetIndex(row, col) + kLeft];
+      if (!IsOpen(map, row, next_col)) {
+        distance = 0;
+      } else if (HasForcedNeighbor(map, row, next_col, kLeft)) {
+        distance = 1;
+      } else {
+        int next = GetDistance(map.GetIndex(row, next_col), kLeft);
+        distance = next > 0 ? next + 1 : next - 1;
+      }
+    }
+  }
+
+  for (int col = 0; col < num_cols; col++) {
+    for (int pass = 0; pass < 2; pass++) {
+      Direction direction = pass == 0 ? kDown : kUp;
+      int row_step = kRowSteps[direction];
+      int first_row = row_step > 0 ? num_rows - 1 : 0;
+      for (int row = first_row; row >= 0 && row < num_rows; row -= row_step) {
+        int next_row = row + row_step;
+        int& distance = distances_[4 * map.GetIndex(row, col) + direction];
+        if (!IsOpen(map, next_row, col)) {
+          distance = 0;
+          continue;
+        }
+
+        CellIndex next = map.GetIndex(next_row, col);
+        if (HasForcedNeighbor(map, next_row, col, direction) ||
+            GetDistance(next, kLeft) > 0 || GetDistance(next, kRight) > 0) {
+          distance = 1;
+        } else {
+          int next_distance = GetDistance(next, direction);
+          distance =
+              next_distance > 0 ? next_distance + 1 : next_distance - 1;
+        }
+      }
+    }
+  }
+}
+
+int JumpTable::GetDistance(CellIndex index, Direction direction) const {
+  return distances_[4 * index + direction];
+}
+
+CellIndex Jump(const GridMap& map, CellIndex from, Direction direction,
+               CellIndex goal) {
+  int row = map.GetRow(from);
+  int col = map.GetCol(from);
+
+  // Most jumps on crowded maps run straight into a wall, which is cheaper to
+  // check for on its own than with a scan
+  if (!IsOpen(map, row + kRowSteps[direction], col + kColSteps[direction])) {
+    return kNoCell;
+  }
+  int distance = ScanLine(map, from, direction);
+  int reach = distance > 0 ? distance : -distance;
+  int goal_row = map.GetRow(goal);
+  int goal_col = map.GetCol(goal);
+
+  if (kRowSteps[direction] == 0) {
+    int steps = (goal_col - col) * kColSteps[direction];
+    if (goal_row == row && steps > 0 && steps <= reach) {
+      return goal;
+    }
+    return distance > 0 ? Step(map, from, direction, distance) : kNoCell;
+  }
+
+  // Optimal routes are straightened so that they only turn from vertical to
+  // horizontal at a jump point, which is any cell a horizontal jump leads
+  // somewhere from. Those can't be found from the line itself, so each cell
+  // before the next forced neighbor gets its own horizontal scans.
+  int last_step = distance > 0 ? distance - 1 : reach;
+  for (int steps = 1; steps <= last_step; steps++) {
+    CellIndex index = Step(map, from, direction, steps);
+    if (index == goal || Jump(map, index, kLeft, goal) != kNoCell ||
+        Jump(map, index, kRight, goal) != kNoCell) {
+      return index;
+    }
+  }
+  return distance > 0 ? Step(map, from, direction, distance) : kNoCell;
+}
+
+CellIndex Jump(const GridMap& map, const JumpTable& table, CellIndex from,
+               Direction direction, CellIndex goal) {
+  int distance = table.GetDistance(from, direction);
+  int reach = distance > 0 ? distance : -distance;
+  int row = map.GetRow(from);
+  int col = map.GetCol(from);
+  int goal_row = map.GetRow(goal);
+  int goal_col = map.GetCol(goal);
+
+  // The table knows nothing about the goal, so check whether the jump passes
+  // it, or passes the cell where a vertical jump should turn towards it
+  if (kRowSteps[direction] == 0) {
+    int steps = (goal_col - col) * kColSteps[direction];
+    if (goal_row == row && steps > 0 && steps <= reach) {
+      return goal;
+    }
+  } else {
+    int steps = (goal_row - row) * kRowSteps[direction];
+    if (steps > 0 && steps <= reach) {
+      CellIndex turn = map.GetIndex(goal_row, col);
+      if (turn == goal) {
+        return goal;
+      }
+      Direction across = goal_col < col ? kLeft : kRight;
+      int across_distance = table.GetDistance(turn, across);
+      int across_steps = goal_col < col ? col - goal_col : goal_col - col;
+      if (across_steps <= (across_distance > 0 ? across_distance
+                                               : -across_distance)) {
+        return turn;
+      }
+    }
+  }
+
+  return distance > 0 ? Step(map, from, direction, distance) : kNoCell;
+}
+
+void FindJumpPoints(SearchContext& context, CellIndex current, CellIndex goal,
+                    const JumpTable* table) {
+  const GridMap& map = context.GetMap();
+  const SearchState& state = context.GetState();
+  if (!map.HasUniformCosts()) {
+    FindNeighbors(context, current, goal);
+    return;
+  }
+
+  // The start has no parent, so every direction is followed from it.
+  // Otherwise the search keeps going the way it came or turns to either side,
+  // since going back can't be part of a shortest route.
+  Direction directions[] = {kUp, kDown, kLeft, kRight};
+  size_t num_directions = 4;
+  CellIndex parent = state.GetParent(current);
+  if (parent != kNoCell) {
+    num_directions = 3;
+    if (map.GetRow(parent) == map.GetRow(current)) {
+      directions[0] = map.GetCol(parent) < map.GetCol(current) ? kRight : kLeft;
+      directions[1] = kUp;
+      directions[2] = kDown;
+    } else {
+      directions[0] = map.GetRow(parent) < map.GetRow(current) ? kDown : kUp;
+      directions[1] = kLeft;
+      directions[2] = kRight;
+    }
+  }
+
+  for (size_t i = 0; i < num_directions; i++) {
+    CellIndex jump_point =
+        table == nullptr ? Jump(map, current, directions[i], goal)
+                         : Jump(map, *table, current, directions[i], goal);
+    if (jump_point == kNoCell || state.IsClosed(jump_point)) {
+      continue;
+    }
+    int g_cost =
+        state.GetGCost(current) + ManhattanDistance(map, current, jump_point);
+    OpenCell(context, jump_point, current, g_cost, goal);
+  }
+}
+
+size_t ReconstructJumpPath(const GridMap& map, const SearchState& state,
+                           CellIndex start, CellIndex goal,
+                           std::vector<CellIndex>& path) {
+  // Jump points are joined by straight lines, so the cells between two of
+  // them are as many as the Manhattan distance
+  size_t length = 1;
+  for (CellIndex index = goal; index != start; index = state.GetParent(index)) {
+    length += ManhattanDistance(map, index, state.GetParent(index));
+  }
+
+  path.resize(length);
+  size_t next = length;
+  path[--next] = goal;
+  for (CellIndex index = goal; index != start;) {
+    CellIndex parent = state.GetParent(index);
+    size_t stride = map.GetRow(parent) == map.GetRow(index)
+                        ? 1
+                        : map.GetNumCols();
+    while (index != parent) {
+      index = parent > index ? index + stride : index - stride;
+      path[--next] = index;
+    }
+  }
+  return length;
+}
+
+SearchResult FindJumpPointPath(SearchContext& context, CellIndex start,
+                               CellIndex goal, std::vector<CellIndex>& path,
+                               const JumpTable* table) {
+  SearchResult result;
+  result.found = false;
+  result.cost = 0;
+  result.path_length = 0;
+  result.num_expanded = 0;
+  path.clear();
+
+  const GridMap& map = context.GetMap();
+  if (!map.IsPassable(start) || !map.IsPassable(goal)) {
+    return result;
+  }
+
+  StartSearch(context, start, goal);
+  SearchState& state = context.GetState();
+  OpenSet& open_set = context.GetOpenSet();
+  while (!open_set.Empty()) {
+    CellIndex current = open_set.Pop();
+    state.Close(current);
+    if (current == goal) {
+      result.found = true;
+      break;
+    }
+    FindJumpPoints(context, current, goal, table);
+    result.num_expanded++;
+  }
+
+  if (!result.found) {
+    return result;
+  }
+  result.cost = state.GetGCost(goal);
+  result.path_length = ReconstructJumpPath(map, state, start, goal, path);
+  return result;
+}
+
+}  // namespace pathfinder
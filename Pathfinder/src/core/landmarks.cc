@@ -0,0 +1,280 @@
+#include <core/landmarks.h>
+
+#include <algorithm>
+
+namespace pathfinder {
+
+namespace {
+
+// Written at the start of every saved table
+const char kMagic[4] = {'P', 'F', 'L', 'M'};
+
+/**
+ * Helper method that writes a number as 4 little endian bytes, so saved
+ * tables can be read on any machine
+ */
+void WriteUint32(std::ostream& output, uint32_t value) {
+  char bytes[4];
+  for (int i = 0; i < 4; i++) {
+    bytes[i] = (char)((value >> (8 * i)) & 0xFF);
+  }
+  output.write(bytes, 4);
+}
+
+/**
+ * Helper method that reads a number written by WriteUint32
+ */
+bool ReadUint32(std::istream& input, uint32_t& value) {
+  unsigned char bytes[4];
+  if (!input.read((char*)bytes, 4)) {
+    return false;
+  }
+  value = 0;
+  for (int i = 0; i < 4; i++) {
+    value |= (uint32_t)bytes[i] << (8 * i);
+  }
+  return true;
+}
+
+/**
+ * Helper method that sums up which cells of a map are walls with the 32 bit
+ * FNV-1a hash, so a saved table can't be loaded for a map whose walls have
+ * changed since
+ */
+uint32_t HashWalls(const GridMap& map) {
+  uint32_t hash = 2166136261u;
+  for (CellIndex index = 0; index < map.GetNumCells(); index++) {
+    hash ^= map.IsPassable(index) ? 1u : 0u;
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/**
+ * Helper method that checks whether a stream has at least the given number
+ * of bytes left, so a corrupt size can be rejected before it is allocated.
+ * Streams that can't seek are assumed to have enough.
+ */
+bool HasBytesLeft(std::istream& input, uint64_t num_bytes) {
+  std::streampos position = input.tellg();
+  if (position == std::streampos(-1)) {
+    return true;
+  }
+  input.seekg(0, std::ios::end);
+  std::streampos end = input.tellg();
+  input.seekg(position);
+  return end != std::streampos(-1) && input &&
+         (uint64_t)(end - position) >= num_bytes;
+}
+
+}  // namespace
+
+const size_t LandmarkTable::kDefaultNumLandmarks;
+const uint16_t LandmarkTable::kUnreachable;
+const uint16_t LandmarkTable::kMaxDistance;
+
+void LandmarkTable::Build(const GridMap& map, size_t num_landmarks) {
+  num_rows_ = map.GetNumRows();
+  num_cols_ = map.GetNumCols();
+  wall_hash_ = HashWalls(map);
+  landmarks_.clear();
+  distances_.clear();
+
+  size_t num_cells = map.GetNumCells();
+  CellIndex first_open = 0;
+  while (first_open < num_cells && !map.IsPassable(first_open)) {
+    first_open++;
+  }
+  if (first_open == num_cells || num_landmarks == 0) {
+    return;
+  }
+
+  landmarks_.assign(num_landmarks, first_open);
+  distances_.assign(num_cells * num_landmarks, kUnreachable);
+  std::vector<CellIndex> queue;
+  queue.reserve(num_cells);
+  std::vector<uint16_t> field;
+
+  // A breadth first search visits cells in order of distance, so the last
+  // one it reaches is the farthest from where it started
+  SearchFrom(map, 0, queue, field);
+  landmarks_[0] = queue.back();
+
+  // The distance from each cell to the nearest landmark picked so far
+  std::vector<uint16_t> nearest(num_cells, kUnreachable);
+  size_t num_found = 0;
+  for (size_t landmark = 0; landmark < num_landmarks; landmark++) {
+    if (landmark > 0) {
+      CellIndex farthest = kNoCell;
+      uint16_t farthest_distance = 0;
+      for (CellIndex index = 0; index < num_cells; index++) {
+        if (nearest[index] != kUnreachable &&
+            nearest[index] > farthest_distance) {
+          farthest = index;
+          farthest_distance = nearest[index];
+        }
+      }
+
+      // Every reachable cell is a landmark already
+      if (farthest == kNoCell) {
+        break;
+      }
+      landmarks_[landmark] = farthest;
+    }
+
+    SearchFrom(map, landmark, queue, field);
+    for (CellIndex index : queue) {
+      if (nearest[index] == kUnreachable || field[index] < nearest[index]) {
+        nearest[index] = field[index];
+      }
+    }
+    num_found++;
+  }
+
+  // Tiny maps can run out of cells to pick, which leaves gaps to close up
+  if (num_found < num_landmarks) {
+    std::vector<uint16_t> packed(num_cells * num_found);
+    for (CellIndex index = 0; index < num_cells; index++) {
+      for (size_t landmark = 0; landmark < num_found; landmark++) {
+        packed[index * num_found + landmark] =
+            distances_[index * num_landmarks + landmark];
+      }
+    }
+    distances_.swap(packed);
+    landmarks_.resize(num_found);
+  }
+}
+
+bool LandmarkTable::Save(std::ostream& output) const {
+  output.write(kMagic, sizeof(kMagic));
+  WriteUint32(output, (uint32_t)num_rows_);
+  WriteUint32(output, (uint32_t)num_cols_);
+  WriteUint32(output, wall_hash_);
+  WriteUint32(output, (uint32_t)landmarks_.size());
+  for (CellIndex landmark : landmarks_) {
+    WriteUint32(output, landmark);
+  }
+
+  std::vector<char> bytes(distances_.size() * 2);
+  for (size_t i = 0; i < distances_.size(); i++) {
+    bytes[2 * i] = (char)(distances_[i] & 0xFF);
+    bytes[2 * i + 1] = (char)(distances_[i] >> 8);
+  }
+  output.write(bytes.data(), bytes.size());
+  return (bool)output;
+}
+
+bool LandmarkTable::IsBuiltFor(const GridMap& map) const {
+  return num_rows_ == map.GetNumRows() && num_cols_ == map.GetNumCols() &&
+         wall_hash_ == HashWalls(map);
+}
+
+bool LandmarkTable::Load(std::istream& input, const GridMap& map) {
+  landmarks_.clear();
+  distances_.clear();
+  num_rows_ = map.GetNumRows();
+  num_cols_ = map.GetNumCols();
+  wall_hash_ = HashWalls(map);
+
+  char magic[sizeof(kMagic)];
+  uint32_t num_rows = 0;
+  uint32_t num_cols = 0;
+  uint32_t wall_hash = 0;
+  uint32_t num_landmarks = 0;
+  if (!input.read(magic, sizeof(magic)) ||
+      !std::equal(magic, magic + sizeof(magic), kMagic) ||
+      !ReadUint32(input, num_rows) || !ReadUint32(input, num_cols) ||
+      !ReadUint32(input, wall_hash) || !ReadUint32(input, num_landmarks) ||
+      num_rows != num_rows_ || num_cols != num_cols_ ||
+      wall_hash != wall_hash_) {
+    return false;
+  }
+
+  // Build never picks more landmarks than there are cells, and the file
+  // has to hold every landmark and its distance to every cell
+  uint64_t num_cells = map.GetNumCells();
+  if (num_landmarks > num_cells ||
+      !HasBytesLeft(input, num_landmarks * (4 + 2 * num_cells))) {
+    return false;
+  }
+
+  std::vector<CellIndex> landmarks(num_landmarks);
+  for (CellIndex& landmark : landmarks) {
+    if (!ReadUint32(input, landmark) || landmark >= map.GetNumCells()) {
+      return false;
+    }
+  }
+
+  std::vector<unsigned char> bytes(map.GetNumCells() * num_landmarks * 2);
+  if (!input.read((char*)bytes.data(), bytes.size())) {
+    return false;
+  }
+  distances_.resize(bytes.size() / 2);
+  for (size_t i = 0; i < distances_.size(); i++) {
+    distances_[i] = (uint16_t)(bytes[2 * i] | (bytes[2 * i + 1] << 8));
+  }
+  landmarks_.swap(landmarks);
+  return true;
+}
+
+const std::vector<CellIndex>& LandmarkTable::GetLandmarks() const {
+  return landmarks_;
+}
+
+int LandmarkTable::GetDistance(size_t landmark, CellIndex index) const {
+  uint16_t distance = distances_[index * landmarks_.size() + landmark];
+  return distance == kUnreachable ? -1 : distance;
+}
+
+void LandmarkTable::SearchFrom(const GridMap& map, size_t landmark,
+                               std::vector<CellIndex>& queue,
+                               std::vector<uint16_t>& field) {
+  // The search runs on a field of its own, since the table keeps each
+  // cell's distances together and writing one of them at a time would touch
+  // a new cache line for nearly every cell
+  size_t num_cells = map.GetNumCells();
+  field.assign(num_cells, kUnreachable);
+  CellIndex source = landmarks_[landmark];
+  field[source] = 0;
+  queue.clear();
+  queue.push_back(source);
+
+  for (size_t next = 0; next < queue.size(); next++) {
+    CellIndex current = queue[next];
+    uint16_t distance = field[current];
+    uint16_t neighbor_distance =
+        distance < kMaxDistance ? distance + 1 : kMaxDistance;
+
+    size_t row = current / num_cols_;
+    size_t col = current - row * num_cols_;
+    CellIndex neighbors[4];
+    int num_neighbors = 0;
+    if (row > 0) {
+      neighbors[num_neighbors++] = current - num_cols_;
+    }
+    if (row + 1 < num_rows_) {
+      neighbors[num_neighbors++] = current + num_cols_;
+    }
+    if (col > 0) {
+      neighbors[num_neighbors++] = current - 1;
+    }
+    if (col + 1 < num_cols_) {
+      neighbors[num_neighbors++] = current + 1;
+    }
+
+    for (int i = 0; i < num_neighbors; i++) {
+      uint16_t& neighbor = field[neighbors[i]];
+      if (neighbor == kUnreachable && map.IsPassable(neighbors[i])) {
+        neighbor = neighbor_distance;
+        queue.push_back(neighbors[i]);
+      }
+    }
+  }
+
+  size_t num_landmarks = landmarks_.size();
+  for (CellIndex index = 0; index < num_cells; index++) {
+    distances_[index * num_landmarks + landmark] = field[index];
+  }
+}
+
+}  // namespace pathfinder
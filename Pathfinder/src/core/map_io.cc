@@ -0,0 +1,126 @@
+#include <core/map_io.h>
+
+#include <sstream>
+
+namespace pathfinder {
+
+namespace {
+
+/**
+ * Helper method that reads the next line, dropping the carriage return left
+ * by files written on Windows
+ */
+bool ReadLine(std::istream& input, std::string& line) {
+  if (!std::getline(input, line)) {
+    return false;
+  }
+  if (!line.empty() && line[line.size() - 1] == '\r') {
+    line.erase(line.size() - 1);
+  }
+  return true;
+}
+
+/**
+ * Helper method that writes one row of a map file into the map
+ */
+void SetRow(GridMap& map, size_t row, const std::string& line) {
+  for (size_t col = 0; col < line.size(); col++) {
+    if (!IsPassableTerrain(line[col])) {
+      map.SetPassable(map.GetIndex(row, col), false);
+    }
+  }
+}
+
+/**
+ * Helper method that reads the rest of a Moving AI .map file once its "type"
+ * line has been read
+ */
+bool LoadMovingAiMap(std::istream& input, GridMap& map) {
+  size_t height = 0;
+  size_t width = 0;
+  std::string line;
+  while (ReadLine(input, line) && line != "map") {
+    std::istringstream header(line);
+    std::string key;
+    header >> key;
+    if (key == "height") {
+      header >> height;
+    } else if (key == "width") {
+      header >> width;
+    }
+  }
+  if (line != "map" || height == 0 || width == 0) {
+    return false;
+  }
+
+  map = GridMap(height, width);
+  for (size_t row = 0; row < height; row++) {
+    if (!ReadLine(input, line) || line.size() != width) {
+      return false;
+    }
+    SetRow(map, row, line);
+  }
+  return true;
+}
+
+}  // namespace
+
+bool LoadMap(std::istream& input, GridMap& map) {
+  std::vector<std::string> rows;
+  std::string line;
+  while (ReadLine(input, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    if (rows.empty() && line.compare(0, 5, "type ") == 0) {
+      return LoadMovingAiMap(input, map);
+    }
+    if (!rows.empty() && line.size() != rows[0].size()) {
+      return false;
+    }
+    rows.push_back(line);
+  }
+  if (rows.empty()) {
+    return false;
+  }
+
+  // Plain maps don't say how many rows they have, so they are read in full
+  // before the map is sized
+  map = GridMap(rows.size(), rows[0].size());
+  for (size_t row = 0; row < rows.size(); row++) {
+    SetRow(map, row, rows[row]);
+  }
+  return true;
+}
+
+bool LoadScenarios(std::istream& input, std::vector<Scenario>& scenarios) {
+  scenarios.clear();
+  std::string line;
+  if (!ReadLine(input, line) || line.compare(0, 7, "version") != 0) {
+    return false;
+  }
+
+  while (ReadLine(input, line)) {
+    if (line.empty()) {
+      continue;
+    }
+
+    // Coordinates in .scen files are (x, y), which is (col, row) here
+    std::istringstream fields(line);
+    Scenario scenario;
+    if (!(fields >> scenario.bucket >> scenario.map_name >>
+          scenario.map_width >> scenario.map_height >> scenario.start_col >>
+          scenario.start_row >> scenario.goal_col >> scenario.goal_row >>
+          scenario.optimal_length)) {
+      return false;
+    }
+    scenarios.push_back(scenario);
+  }
+  return true;
+}
+
+bool IsPassableTerrain(char terrain) {
+  return terrain == '.' || terrain == 'G' || terrain == 'S';
+}
+
+}  // namespace pathfinder
@@ -0,0 +1,139 @@
+#include <core/open_set.h>
+
+namespace pathfinder {
+
+OpenSet::OpenSet(size_t num_cells) {
+  Reset(num_cells);
+}
+
+void OpenSet::Reset(size_t num_cells) {
+  heap_.clear();
+  heap_.reserve(num_cells);
+  positions_.resize(num_cells);
+}
+
+bool OpenSet::Empty() const {
+  return heap_.empty();
+}
+
+size_t OpenSet::Size() const {
+  return heap_.size();
+}
+
+bool OpenSet::Contains(CellIndex index) const {
+  return index < positions_.size() && positions_[index] < heap_.size() &&
+         heap_[positions_[index]].index == index;
+}
+
+void OpenSet::Push(CellIndex index, int f_cost, int h_cost) {
+  Entry entry = {f_cost, h_cost, index};
+  heap_.push_back(entry);
+  positions_[index] = (uint32_t)heap_.size() - 1;
+  SiftUp((uint32_t)heap_.size() - 1);
+}
+
+void OpenSet::DecreaseKey(CellIndex index, int f_cost, int h_cost) {
+  uint32_t position = positions_[index];
+  heap_[position].f_cost = f_cost;
+  heap_[position].h_cost = h_cost;
+  SiftUp(position);
+}
+
+CellIndex OpenSet::Top() const {
+  return heap_.front().index;
+}
+
+int OpenSet::GetTopFCost() const {
+  return heap_.front().f_cost;
+}
+
+int OpenSet::GetTopHCost() const {
+  return heap_.front().h_cost;
+}
+
+CellIndex OpenSet::Pop() {
+  CellIndex top = heap_.front().index;
+  Remove(top);
+  return top;
+}
+
+void OpenSet::Remove(CellIndex index) {
+  if (!Contains(index)) {
+    return;
+  }
+
+  uint32_t position = positions_[index];
+  Entry last = heap_.back();
+  heap_.pop_back();
+
+  // The removed entry was the last one, so there is nothing to fill the gap
+  if (position == heap_.size()) {
+    return;
+  }
+
+  Place(last, position);
+  if (position > 0 && Precedes(last, heap_[(position - 1) / 2])) {
+    SiftUp(position);
+  } else {
+    SiftDown(position);
+  }
+}
+
+std::vector<CellIndex> OpenSet::GetIndices() const {
+  std::vector<CellIndex> indices;
+  indices.reserve(heap_.size());
+  for (const Entry& entry : heap_) {
+    indices.push_back(entry.index);
+  }
+  return indices;
+}
+
+bool OpenSet::Precedes(const Entry& a, const Entry& b) {
+  if (a.f_cost != b.f_cost) {
+    return a.f_cost < b.f_cost;
+  }
+  if (a.h_cost != b.h_cost) {
+    return a.h_cost < b.h_cost;
+  }
+  return a.index < b.index;
+}
+
+void OpenSet::SiftUp(uint32_t position) {
+  Entry entry = heap_[position];
+  while (position > 0) {
+    uint32_t parent = (position - 1) / 2;
+    if (!Precedes(entry, heap_[parent])) {
+      break;
+    }
+    Place(heap_[parent], position);
+    position = parent;
+  }
+  Place(entry, position);
+}
+
+void OpenSet::SiftDown(uint32_t position) {
+  Entry entry = heap_[position];
+  size_t size = heap_.size();
+  while (true) {
+    size_t child = 2 * (size_t)position + 1;
+    if (child >= size) {
+      break;
+    }
+    if (child + 1 < size && Precedes(heap_[child + 1], heap_[child])) {
+      child++;
+    }
+    if (!Precedes(heap_[child], entry)) {
+      break;
+    }
+    Place(heap_[child], position);
+    position = (uint32_t)child;
+  }
+  Place(entry, position);
+}
+
+void OpenSet::Place(const Entry& entry, uint32_t position) {
+  heap_[position] = entry;
+  positions_[entry.index] = position;
+}
+
+}  // namespace pathfinder
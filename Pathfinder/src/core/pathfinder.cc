@@ -1,132 +1,105 @@
 #include <core/pathfinder.h>
-#include <math.h>
 
 namespace pathfinder {
 
-Pathfinder::Pathfinder(const std::vector<std::vector<Cell>>& cells, Cell& start,
-                       Cell& end) {
-  cells_ = cells;
-
-  // Populates start_ and goal_ cell variables
-  for (const std::vector<Cell>& row : cells_) {
-    for (Cell cell : row) {
-      if (cell.GetType() == CellType::kStart) {
-        start_ = cell;
-      } else if (cell.GetType() == CellType::kEnd) {
-        goal_ = cell;
+GridMap MakeGridMap(const std::vector<std::vector<Cell>>& cells) {
+  GridMap map = GridMap(cells.size(), cells.empty() ? 0 : cells[0].size());
+  for (size_t row = 0; row < map.GetNumRows(); row++) {
+    for (size_t col = 0; col < map.GetNumCols(); col++) {
+      if (cells[row][col].GetType() == CellType::kWall) {
+        map.SetPassable(map.GetIndex(row, col), false);
       }
     }
   }
-  start_.SetGCost(0);
-  start_.SetHCost(CalculateHCost(start_));
-  open_set_.push_back(start_);
+  return map;
 }
 
-Cell Pathfinder::FindNextCell(Cell& current_cell) {
-  Cell next_cell = CalculateNextCell(current_cell);
-  next_cell.SetPreviousCell(current_cell);
-
-  if (open_set_.empty() || next_cell.GetPosition() == goal_.GetPosition()) {
-    return next_cell;
-  } else {
-    current_cell = next_cell;
-    return current_cell;
-  }
+Pathfinder::Pathfinder(const GridMap& map, const Cell& start, const Cell& end)
+    : context_(map), backward_context_(map) {
+  SetGrid(map, start, end);
 }
 
-Cell Pathfinder::CalculateNextCell(const Cell& current_cell) {
-  FindNeighbors(current_cell);
-  int lowest_index = 0;
+Cell Pathfinder::FindNextCell(const Cell& current_cell) {
+  return MakeCell(Step(GetIndex(current_cell)));
+}
 
-  // Find Cell in the open_set_ with the lowest F_Cost to move to
-  for (size_t neighbor = 0; neighbor < open_set_.size(); neighbor++) {
-    open_set_[neighbor].SetGCost(CalculateGCost(open_set_[neighbor]));
-    open_set_[neighbor].SetHCost(CalculateHCost(open_set_[neighbor]));
-    if (open_set_[neighbor].GetFCost() < open_set_[lowest_index].GetFCost()) {
-      if (open_set_[neighbor].GetPosition() != current_cell.GetPosition()) {
-        lowest_index = neighbor;
-      }
-    }
+CellIndex Pathfinder::Step(CellIndex current) {
+  if (mode_ == SearchMode::kBidirectional) {
+    return StepBidirectional(current);
   }
 
-  // Checks to see if we are at the end node
-  if (open_set_[lowest_index].GetType() == CellType::kEnd) {
-    return open_set_[lowest_index];
-  }
+  // The current cell is being expanded, so it can't be moved to again
+  context_.GetOpenSet().Remove(current);
+  context_.GetState().Close(current);
 
-  Cell current = open_set_[lowest_index];
+  switch (mode_) {
+    case SearchMode::kAStar:
+      AStarSearch(context_).Expand(current, goal_);
+      break;
 
-  open_set_ = RemoveElement(open_set_, current);
-  closed_set_.push_back(current);
-  return current;
-}
+    case SearchMode::kJumpPoint:
+      FindJumpPoints(context_, current, goal_);
+      break;
+
+    case SearchMode::kJumpPointPlus:
+      FindJumpPoints(context_, current, goal_, &jump_table_);
+      break;
 
-void Pathfinder::FindNeighbors(const Cell& current_cell) {
-  if (current_cell.GetPosition() == start_.GetPosition()) {
-    closed_set_.push_back(start_);
+    case SearchMode::kBidirectional:
+      break;
   }
-  size_t x = current_cell.GetPosition().x;
-  size_t y = current_cell.GetPosition().y;
 
-  //-1 to 1 in order to check the 8 cells surrounding current_cell
-  for (int row = -1; row <= 1; row++) {
-    for (int col = -1; col <= 1; col++) {
-      // Make sure we aren't considering the current cell as a neighbor
-      if (row == 0 && col == 0) {
-        col++;
-      }
-      int x_coord = x + row;
-      int y_coord = y + col;
-      bool valid_spot;
-
-      // Checks to see if the spot we are looking at is one that we can actually
-      // move to
-      if ((x_coord < 0 || y_coord < 0) ||
-          (x_coord > cells_.size() - 1 || y_coord > cells_.size() - 1) ||
-          (row != 0 && col != 0)) {
-        valid_spot = false;
-      } else {
-        valid_spot = true;
-      }
+  // The next cell is the open cell with the lowest F cost, ties broken on
+  // the lower H cost
+  OpenSet& open_set = context_.GetOpenSet();
+  if (open_set.Empty()) {
+    exhausted_ = true;
+    return current;
+  }
+  CellIndex next = open_set.Pop();
+  context_.GetState().Close(next);
+  return next;
+}
 
-      if (valid_spot) {
-        Cell neighbor = cells_[x_coord][y_coord];
-        if (!(neighbor.GetType() == CellType::kWall ||
-              ContainsElement(closed_set_, neighbor))) {
-          int temp_g = current_cell.GetGCost() + 1;
-          if (ContainsElement(open_set_, neighbor)) {
-            if (temp_g < neighbor.GetGCost()) {
-              neighbor.SetGCost(temp_g);
-            }
-          } else {
-            neighbor.SetGCost(temp_g);
-            neighbor.SetHCost(CalculateHCost(neighbor));
-            open_set_.push_back(neighbor);
-          }
-        }
-      }
-    }
+CellIndex Pathfinder::StepBidirectional(CellIndex current) {
+  SearchContext& context = current_is_forward_ ? context_ : backward_context_;
+  SearchContext& other = current_is_forward_ ? backward_context_ : context_;
+  context.GetOpenSet().Remove(current);
+  context.GetState().Close(current);
+
+  reached_.clear();
+  ExpandFrontier(context, current, current_is_forward_ ? goal_ : start_,
+                 !current_is_forward_, reached_);
+  MeetFrontiers(context, other, reached_, meeting_);
+
+  if (FrontiersAreDone(context_, backward_context_, meeting_)) {
+    exhausted_ = meeting_.cell == kNoCell;
+    return current;
   }
+
+  current_is_forward_ = context_.GetOpenSet().Size() <=
+                        backward_context_.GetOpenSet().Size();
+  SearchContext& next_context =
+      current_is_forward_ ? context_ : backward_context_;
+  CellIndex next = next_context.GetOpenSet().Pop();
+  next_context.GetState().Close(next);
+  return next;
 }
 
-int Pathfinder::CalculateGCost(const Cell& cell) {
-  double x_distance = std::abs(start_.GetPosition().x - cell.GetPosition().x);
-  double y_distance = std::abs(start_.GetPosition().y - cell.GetPosition().y);
-  return x_distance + y_distance;
+int Pathfinder::CalculateHCost(CellIndex index) const {
+  return LandmarkHeuristic::Estimate(context_, index, goal_);
 }
 
-int Pathfinder::CalculateHCost(const Cell& cell) {
-  double x_distance = std::abs(goal_.GetPosition().x - cell.GetPosition().x);
-  double y_distance = std::abs(goal_.GetPosition().y - cell.GetPosition().y);
-  return x_distance + y_distance;
+bool Pathfinder::PathFound(const Cell& current_cell) const {
+  return IsPathFound(GetIndex(current_cell));
 }
 
-bool Pathfinder::PathFound(Cell& current_cell) {
-  if ((current_cell.GetPosition() == goal_.GetPosition()) &&
-      current_cell.GetType() == CellType::kEnd) {
-    return true;
+bool Pathfinder::IsPathFound(CellIndex current) const {
+  if (mode_ == SearchMode::kBidirectional) {
+    return meeting_.cell != kNoCell &&
+           FrontiersAreDone(context_, backward_context_, meeting_);
   }
-  return false;
+  return current == goal_;
 }
 
 bool Pathfinder::ContainsElement(const std::vector<Cell>& vec,
@@ -139,49 +112,163 @@ bool Pathfinder::ContainsElement(const std::vector<Cell>& vec,
   return false;
 }
 
-std::vector<Cell> Pathfinder::RemoveElement(std::vector<Cell>& list,
-                                            const Cell& element) {
-  std::vector<Cell> temp_array;
-  for (const Cell& cell : list) {
-    if (cell.GetPosition() == element.GetPosition()) {
-      continue;
-    } else {
-      temp_array.push_back(cell);
+std::vector<Cell>& Pathfinder::GetPath(const Cell& end_cell) {
+  const GridMap& map = context_.GetMap();
+  const SearchState& state = context_.GetState();
+  CellIndex index = GetIndex(end_cell);
+  path_.clear();
+
+  // Both halves are joined first, then written out from the end
+  if (mode_ == SearchMode::kBidirectional) {
+    if (meeting_.cell != kNoCell) {
+      ReconstructBidirectionalPath(state, backward_context_.GetState(), start_,
+                                   goal_, meeting_.cell, path_indices_);
+      for (size_t i = path_indices_.size(); i > 0; i--) {
+        path_.push_back(MakeCell(path_indices_[i - 1]));
+      }
     }
+    return path_;
   }
 
-  return temp_array;
-}
+  path_.push_back(MakeCell(index));
 
-std::vector<Cell>& Pathfinder::GetPath(Cell& end_cell) {
-  Cell temp_cell = end_cell;
-  path_.push_back(temp_cell);
+  while (state.GetParent(index) != kNoCell && index != start_) {
+    CellIndex parent = state.GetParent(index);
 
-  while (temp_cell.GetPreviousCell() != nullptr &&
-         (temp_cell.GetPosition().x > 0 && temp_cell.GetPosition().y > 0)) {
-    path_.push_back(*temp_cell.GetPreviousCell());
-    temp_cell = *temp_cell.GetPreviousCell();
+    // Jump points can be a straight line apart from their parent, so the
+    // cells in between are filled in one step at a time
+    size_t stride =
+        map.GetRow(parent) == map.GetRow(index) ? 1 : map.GetNumCols();
+    while (index != parent) {
+      index = parent > index ? index + stride : index - stride;
+      path_.push_back(MakeCell(index));
+    }
   }
 
   return path_;
 }
 
 void Pathfinder::FindPath() {
-  Cell current_cell = start_;
-  while (current_cell.GetPosition() != goal_.GetPosition()) {
-    current_cell = FindNextCell(current_cell);
+  CellIndex current = start_;
+  while (!IsPathFound(current) && !exhausted_) {
+    current = Step(current);
   }
 }
 
-void Pathfinder::SetGrid(std::vector<std::vector<Cell>>& new_grid, Cell& start,
-                         Cell& end) {
-  cells_ = new_grid;
-  start_ = start;
-  goal_ = end;
+void Pathfinder::SetGrid(const GridMap& new_grid, const Cell& start,
+                         const Cell& end) {
+  context_.SetMap(new_grid);
+  backward_context_.SetMap(new_grid);
+  if (new_grid.GetNumCells() == 0) {
+    start_ = kNoCell;
+    goal_ = kNoCell;
+  } else {
+    start_ = GetIndex(start);
+    goal_ = GetIndex(end);
+  }
+  if (mode_ == SearchMode::kJumpPointPlus) {
+    jump_table_.Build(new_grid);
+  }
+  // Landmarks take a breadth first search each, so they are only rebuilt
+  // when the walls have changed
+  if (use_landmarks_ && !landmarks_.IsBuiltFor(new_grid)) {
+    landmarks_.Build(new_grid);
+  }
+  UpdateLandmarks();
+  ResetSearch();
+}
+
+void Pathfinder::SetSearchMode(SearchMode mode) {
+  // SetGrid keeps the jump table up to date while it is in use, so it is
+  // only built when switching to JPS+
+  if (mode == SearchMode::kJumpPointPlus && mode_ != mode) {
+    jump_table_.Build(context_.GetMap());
+  }
+  mode_ = mode;
+  ResetSearch();
+}
+
+SearchMode Pathfinder::GetSearchMode() const {
+  return mode_;
+}
+
+void Pathfinder::SetUseLandmarks(bool use_landmarks) {
+  // Like the jump table, the landmarks are kept up to date by SetGrid while
+  // they are in use
+  if (use_landmarks && !use_landmarks_ &&
+      !landmarks_.IsBuiltFor(context_.GetMap())) {
+    landmarks_.Build(context_.GetMap());
+  }
+  use_landmarks_ = use_landmarks;
+  UpdateLandmarks();
+  ResetSearch();
+}
+
+bool Pathfinder::GetUseLandmarks() const {
+  return use_landmarks_;
 }
 
 std::vector<Cell> Pathfinder::GetOpenSet() const {
-  return open_set_;
+  std::vector<Cell> open_cells;
+  for (CellIndex index : context_.GetOpenSet().GetIndices()) {
+    open_cells.push_back(MakeCell(index));
+  }
+  if (mode_ == SearchMode::kBidirectional) {
+    for (CellIndex index : backward_context_.GetOpenSet().GetIndices()) {
+      open_cells.push_back(MakeCell(index));
+    }
+  }
+  return open_cells;
+}
+
+bool Pathfinder::IsExhausted() const {
+  return exhausted_;
+}
+
+void Pathfinder::UpdateLandmarks() {
+  const LandmarkTable* landmarks = use_landmarks_ ? &landmarks_ : nullptr;
+  context_.SetLandmarks(landmarks);
+  backward_context_.SetLandmarks(landmarks);
+}
+
+void Pathfinder::ResetSearch() {
+  exhausted_ = false;
+  meeting_ = Meeting();
+  current_is_forward_ = true;
+  if (start_ == kNoCell) {
+    context_.Reset();
+    backward_context_.Reset();
+    return;
+  }
+
+  AStarSearch(context_).Start(start_, goal_);
+  if (mode_ == SearchMode::kBidirectional) {
+    AStarSearch(backward_context_).Start(goal_, start_);
+    reached_.assign(1, start_);
+    MeetFrontiers(context_, backward_context_, reached_, meeting_);
+  }
+}
+
+CellIndex Pathfinder::GetIndex(const Cell& cell) const {
+  const CellPosition& position = cell.GetPosition();
+  return context_.GetMap().GetIndex(position.row, position.col);
+}
+
+Cell Pathfinder::MakeCell(CellIndex index) const {
+  const GridMap& map = context_.GetMap();
+  CellType type = CellType::kEmpty;
+  if (index == start_) {
+    type = CellType::kStart;
+  } else if (index == goal_) {
+    type = CellType::kEnd;
+  } else if (!map.IsPassable(index)) {
+    type = CellType::kWall;
+  }
+
+  Cell cell = Cell(type, map.GetRow(index), map.GetCol(index));
+  cell.SetGCost(context_.GetState().GetGCost(index));
+  cell.SetHCost(CalculateHCost(index));
+  return cell;
 }
 
-}  // namespace pathfinder
\ No newline at end of file
+}  // namespace pathfinder
@@ -0,0 +1,212 @@
+#include <core/replanner.h>
+
+#include <algorithm>
+
+namespace pathfinder {
+
+const int Replanner::kInfinity;
+
+Replanner::Replanner(const GridMap& map) : map_(map) {
+}
+
+void Replanner::Reset(CellIndex start, CellIndex goal) {
+  size_t num_cells = map_.GetNumCells();
+  start_ = start;
+  goal_ = goal;
+  key_offset_ = 0;
+  g_costs_.assign(num_cells, kInfinity);
+  rhs_costs_.assign(num_cells, kInfinity);
+  open_set_.Reset(num_cells);
+  touched_.Resize(num_cells);
+  num_touched_ = 0;
+
+  // The search grows backwards from the goal
+  rhs_costs_[goal_] = 0;
+  open_set_.Push(goal_, ManhattanDistance(map_, start_, goal_), 0);
+  Touch(goal_);
+}
+
+void Replanner::SetStart(CellIndex start) {
+  key_offset_ += ManhattanDistance(map_, start_, start);
+  start_ = start;
+  touched_.Clear();
+  num_touched_ = 0;
+}
+
+void Replanner::UpdateCells(const std::vector<CellIndex>& cells) {
+  touched_.Clear();
+  num_touched_ = 0;
+
+  // A wall or a cost only changes the RHS cost of the cell itself and of
+  // the cells next to it. Any change beyond those is found by FindPath as the
+  // open set is expanded.
+  for (CellIndex cell : cells) {
+    UpdateCell(cell);
+    CellIndex neighbors[4];
+    int num_neighbors = GetNeighbors(cell, neighbors);
+    for (int i = 0; i < num_neighbors; i++) {
+      UpdateCell(neighbors[i]);
+    }
+  }
+}
+
+SearchResult Replanner::FindPath(std::vector<CellIndex>& path) {
+  SearchResult result;
+  result.found = false;
+  result.cost = 0;
+  result.path_length = 0;
+  result.num_expanded = 0;
+  path.clear();
+  if (start_ == kNoCell) {
+    return result;
+  }
+
+  while (!StartIsSettled()) {
+    CellIndex current = open_set_.Top();
+    int g_cost = g_costs_[current];
+    int rhs_cost = rhs_costs_[current];
+    int key_h = std::min(g_cost, rhs_cost);
+    int key_f = key_h + ManhattanDistance(map_, start_, current) + key_offset_;
+
+    // Keys from before the start moved are too small, so the cell goes back
+    // with its real key before it is expanded
+    if (open_set_.GetTopFCost() < key_f ||
+        (open_set_.GetTopFCost() == key_f && open_set_.GetTopHCost() < key_h)) {
+      open_set_.Remove(current);
+      open_set_.Push(current, key_f, key_h);
+      continue;
+    }
+
+    // A cell whose RHS cost dropped is settled at it. A cell whose RHS cost
+    // rose loses its G cost and is looked at again with its new RHS cost.
+    result.num_expanded++;
+    if (g_cost > rhs_cost) {
+      g_costs_[current] = rhs_cost;
+    } else {
+      g_costs_[current] = kInfinity;
+    }
+    UpdateCell(current);
+
+    CellIndex neighbors[4];
+    int num_neighbors = GetNeighbors(current, neighbors);
+    for (int i = 0; i < num_neighbors; i++) {
+      UpdateCell(neighbors[i]);
+    }
+  }
+
+  if (rhs_costs_[start_] >= kInfinity) {
+    return result;
+  }
+
+  // Every cell on a shortest path is closer to the goal than the cell before
+  // it by the cost of stepping onto it
+  path.push_back(start_);
+  for (CellIndex current = start_; current != goal_;) {
+    CellIndex neighbors[4];
+    int num_neighbors = GetNeighbors(current, neighbors);
+    CellIndex next = kNoCell;
+    int next_cost = kInfinity;
+    for (int i = 0; i < num_neighbors; i++) {
+      int cost = g_costs_[neighbors[i]] + map_.GetCost(neighbors[i]);
+      if (cost < next_cost) {
+        next = neighbors[i];
+        next_cost = cost;
+      }
+    }
+    if (next == kNoCell) {
+      path.clear();
+      return result;
+    }
+    path.push_back(next);
+    current = next;
+  }
+
+  result.found = true;
+  result.cost = rhs_costs_[start_];
+  result.path_length = path.size();
+  return result;
+}
+
+CellIndex Replanner::GetStart() const {
+  return start_;
+}
+
+CellIndex Replanner::GetGoal() const {
+  return goal_;
+}
+
+size_t Replanner::GetNumTouched() const {
+  return num_touched_;
+}
+
+int Replanner::CalculateRhs(CellIndex index) const {
+  if (index == goal_) {
+    return 0;
+  }
+  if (!map_.IsPassable(index)) {
+    return kInfinity;
+  }
+
+  int rhs_cost = kInfinity;
+  CellIndex neighbors[4];
+  int num_neighbors = GetNeighbors(index, neighbors);
+  for (int i = 0; i < num_neighbors; i++) {
+    rhs_cost = std::min(rhs_cost,
+                        g_costs_[neighbors[i]] + map_.GetCost(neighbors[i]));
+  }
+  return rhs_cost;
+}
+
+void Replanner::UpdateCell(CellIndex index) {
+  Touch(index);
+  rhs_costs_[index] = CalculateRhs(index);
+
+  open_set_.Remove(index);
+  int g_cost = g_costs_[index];
+  int rhs_cost = rhs_costs_[index];
+  if (g_cost != rhs_cost) {
+    int key_h = std::min(g_cost, rhs_cost);
+    open_set_.Push(index,
+                   key_h + ManhattanDistance(map_, start_, index) + key_offset_,
+                   key_h);
+  }
+}
+
+bool Replanner::StartIsSettled() const {
+  int g_cost = g_costs_[start_];
+  int rhs_cost = rhs_costs_[start_];
+  if (rhs_cost > g_cost) {
+    return false;
+  }
+  if (open_set_.Empty()) {
+    return true;
+  }
+
+  int key_h = std::min(g_cost, rhs_cost);
+  int key_f = key_h + key_offset_;
+  return open_set_.GetTopFCost() > key_f ||
+         (open_set_.GetTopFCost() == key_f && open_set_.GetTopHCost() >= key_h);
+}
+
+int Replanner::GetNeighbors(CellIndex index, CellIndex neighbors[4]) const {
+  const int kRowSteps[] = {-1, 1, 0, 0};
+  const int kColSteps[] = {0, 0, -1, 1};
+  int row = map_.GetRow(index);
+  int col = map_.GetCol(index);
+
+  int num_neighbors = 0;
+  for (int direction = 0; direction < 4; direction++) {
+    int neighbor_row = row + kRowSteps[direction];
+    int neighbor_col = col + kColSteps[direction];
+    if (!map_.InBounds(neighbor_row, neighbor_col)) {
+      continue;
+    }
+    CellIndex neighbor = map_.GetIndex(neighbor_row, neighbor_col);
+    if (map_.IsPassable(neighbor)) {
+      neighbors[num_neighbors++] = neighbor;
+    }
+  }
+  return num_neighbors;
+}
+
+}  // namespace pathfinder
@@ -0,0 +1,114 @@
+#include <core/search.h>
+
+#include <core/basic_search.h>
+
+#include <type_traits>
+
+namespace pathfinder {
+
+const int FourConnected::kStraightCost;
+const int FourConnected::kMaxStepCost;
+
+int ManhattanDistance(const GridMap& map, CellIndex from, CellIndex to) {
+  return FourConnected::Distance(map, from, to);
+}
+
+int EstimateCost(const SearchContext& context, CellIndex from, CellIndex to) {
+  return LandmarkHeuristic::Estimate(context, from, to);
+}
+
+void FindNeighbors(SearchContext& context, CellIndex current, CellIndex goal) {
+  AStarSearch(context).Expand(current, goal);
+}
+
+void OpenCell(SearchContext& context, CellIndex cell, CellIndex parent,
+              int g_cost, CellIndex goal) {
+  AStarSearch(context).Open(cell, parent, g_cost, goal);
+}
+
+void StartSearch(SearchContext& context, CellIndex start, CellIndex goal) {
+  AStarSearch(context).Start(start, goal);
+}
+
+size_t ReconstructPath(const SearchState& state, CellIndex start,
+                       CellIndex goal, std::vector<CellIndex>& path) {
+  // Count the cells first so the path can be written from the back without
+  // reversing it afterwards
+  size_t length = 1;
+  for (CellIndex index = goal; index != start; index = state.GetParent(index)) {
+    length++;
+  }
+  path.resize(length);
+  size_t next = length;
+  for (CellIndex index = goal; next > 0; index = state.GetParent(index)) {
+    path[--next] = index;
+  }
+  return length;
+}
+
+namespace {
+
+/**
+ * The H cost a search with the given connectivity uses when nothing more is
+ * known about the map: its own distance
+ */
+template <typename Connectivity>
+struct DefaultHeuristic {
+  typedef DistanceHeuristic<Connectivity> Type;
+};
+
+// Only searches along edges can use landmarks
+template <>
+struct DefaultHeuristic<FourConnected> {
+  typedef LandmarkHeuristic Type;
+};
+
+}  // namespace
+
+SearchResult FindPath(SearchContext& context, CellIndex start, CellIndex goal,
+                      std::vector<CellIndex>& path) {
+  return FindPath<FourConnected>(context, start, goal, path);
+}
+
+template <typename Connectivity>
+SearchResult FindPath(SearchContext& context, CellIndex start, CellIndex goal,
+                      std::vector<CellIndex>& path) {
+  typedef typename DefaultHeuristic<Connectivity>::Type Heuristic;
+  typedef DistanceHeuristic<Connectivity> Distance;
+
+  // Large cell costs spread the F costs in the queue too far apart for
+  // buckets. Otherwise the search is picked once for the whole query, so
+  // maps without landmarks or costs don't check for them at every cell.
+  const GridMap& map = context.GetMap();
+  if (map.GetMaxCost() > kMaxBucketCost) {
+    return BasicSearch<Heuristic, Connectivity, OpenSet, CellCost>(context)
+        .FindPath(start, goal, path);
+  }
+  bool has_landmarks = std::is_same<Heuristic, LandmarkHeuristic>::value &&
+                       context.GetLandmarks() != nullptr;
+  if (has_landmarks) {
+    return BasicSearch<Heuristic, Connectivity, BucketQueue, CellCost>(context)
+        .FindPath(start, goal, path);
+  }
+  if (!map.HasUniformCosts()) {
+    return BasicSearch<Distance, Connectivity, BucketQueue, CellCost>(context)
+        .FindPath(start, goal, path);
+  }
+  return BasicSearch<Distance, Connectivity, BucketQueue, UniformCost>(context)
+      .FindPath(start, goal, path);
+}
+
+template SearchResult FindPath<FourConnected>(SearchContext& context,
+                                              CellIndex start, CellIndex goal,
+                                              std::vector<CellIndex>& path);
+template SearchResult FindPath<EightConnected<CornerCutting::kAlways>>(
+    SearchContext& context, CellIndex start, CellIndex goal,
+    std::vector<CellIndex>& path);
+template SearchResult FindPath<EightConnected<CornerCutting::kOneSideOpen>>(
+    SearchContext& context, CellIndex start, CellIndex goal,
+    std::vector<CellIndex>& path);
+template SearchResult FindPath<EightConnected<CornerCutting::kNever>>(
+    SearchContext& context, CellIndex start, CellIndex goal,
+    std::vector<CellIndex>& path);
+
+}  // namespace pathfinder
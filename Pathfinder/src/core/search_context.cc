@@ -0,0 +1,36 @@
+#include <core/search_context.h>
+
+namespace pathfinder {
+
+SearchContext::SearchContext(const GridMap& map) : map_(nullptr) {
+  SetMap(map);
+}
+
+void SearchContext::SetMap(const GridMap& map) {
+  map_ = &map;
+  size_t num_cells = map_->GetNumCells();
+  open_set_.Reset(num_cells);
+  bucket_queue_.Reset(num_cells, map_->GetMaxCost() + 1);
+  state_.Reset(num_cells);
+  path_buffer_.clear();
+  path_buffer_.reserve(num_cells);
+}
+
+void SearchContext::SetLandmarks(const LandmarkTable* landmarks) {
+  landmarks_ = landmarks;
+}
+
+void SearchContext::SetTrace(TraceWriter* trace) {
+  trace_ = trace;
+}
+
+void SearchContext::Reset() {
+  open_set_.Reset(map_->GetNumCells());
+  state_.Reset(map_->GetNumCells());
+}
+
+std::vector<CellIndex>& SearchContext::GetPathBuffer() {
+  return path_buffer_;
+}
+
+}  // namespace pathfinder
@@ -0,0 +1,40 @@
+#include <core/search_state.h>
+
+namespace pathfinder {
+
+const uint32_t SearchState::kMaxGeneration;
+
+SearchState::SearchState(size_t num_cells) : generation_(0) {
+  Reset(num_cells);
+}
+
+void SearchState::Reset(size_t num_cells) {
+  generation_++;
+
+  // Stamps of 0 mean "never visited", so they are only written when the
+  // arrays are first sized or the generation has run out of bits
+  if (num_cells != stamps_.size() || generation_ > kMaxGeneration) {
+    stamps_.assign(num_cells, 0);
+    g_costs_.resize(num_cells);
+    parents_.resize(num_cells);
+    generation_ = 1;
+  }
+}
+
+CellSet::CellSet(size_t num_cells) : generation_(0) {
+  Resize(num_cells);
+}
+
+void CellSet::Resize(size_t num_cells) {
+  stamps_.assign(num_cells, 0);
+  generation_ = 1;
+}
+
+void CellSet::Clear() {
+  generation_++;
+  if (generation_ == UINT32_MAX) {
+    Resize(stamps_.size());
+  }
+}
+
+}  // namespace pathfinder
@@ -0,0 +1,179 @@
+#include <core/search_trace.h>
+
+#include <algorithm>
+
+namespace pathfinder {
+
+namespace {
+
+// Written at the start of every trace
+const char kMagic[4] = {'P', 'F', 'T', 'R'};
+
+// Changes whenever the format does
+const uint32_t kVersion = 1;
+
+// Cells store their row and column in 16 bits, so no map has more rows or
+// columns than this
+const uint32_t kMaxSide = UINT16_MAX;
+
+// The largest type in TraceEventType
+const uint32_t kLastType = (uint32_t)TraceEventType::kPath;
+
+/**
+ * Helper method that writes a number as 4 little endian bytes, so traces
+ * can be read on any machine
+ */
+void WriteUint32(std::ostream& output, uint32_t value) {
+  char bytes[4];
+  for (int i = 0; i < 4; i++) {
+    bytes[i] = (char)((value >> (8 * i)) & 0xFF);
+  }
+  output.write(bytes, 4);
+}
+
+/**
+ * Helper method that reads a number written by WriteUint32 from bytes
+ */
+uint32_t DecodeUint32(const unsigned char* bytes) {
+  uint32_t value = 0;
+  for (int i = 0; i < 4; i++) {
+    value |= (uint32_t)bytes[i] << (8 * i);
+  }
+  return value;
+}
+
+/**
+ * Helper method that reads a number written by WriteUint32
+ */
+bool ReadUint32(std::istream& input, uint32_t& value) {
+  unsigned char bytes[4];
+  if (!input.read((char*)bytes, 4)) {
+    return false;
+  }
+  value = DecodeUint32(bytes);
+  return true;
+}
+
+/**
+ * Helper method that checks whether a stream has at least the given number
+ * of bytes left, so a corrupt header can be rejected before the map it
+ * describes is allocated. Streams that can't seek are assumed to have
+ * enough.
+ */
+bool HasBytesLeft(std::istream& input, uint64_t num_bytes) {
+  std::streampos position = input.tellg();
+  if (position == std::streampos(-1)) {
+    return true;
+  }
+  input.seekg(0, std::ios::end);
+  std::streampos end = input.tellg();
+  input.seekg(position);
+  return end != std::streampos(-1) && input &&
+         (uint64_t)(end - position) >= num_bytes;
+}
+
+}  // namespace
+
+const int TraceEvent::kMaxCost;
+const size_t TraceWriter::kBufferSize;
+
+TraceWriter::TraceWriter(std::ostream& output)
+    : output_(output), num_events_(0) {
+  buffer_.reserve(kBufferSize);
+}
+
+TraceWriter::~TraceWriter() {
+  Flush();
+}
+
+bool TraceWriter::WriteHeader(const GridMap& map) {
+  output_.write(kMagic, sizeof(kMagic));
+  WriteUint32(output_, kVersion);
+  WriteUint32(output_, (uint32_t)map.GetNumRows());
+  WriteUint32(output_, (uint32_t)map.GetNumCols());
+
+  std::vector<char> cells(map.GetNumCells());
+  for (CellIndex index = 0; index < map.GetNumCells(); index++) {
+    cells[index] = map.IsPassable(index) ? (char)map.GetCost(index) : 0;
+  }
+  output_.write(cells.data(), cells.size());
+  return (bool)output_;
+}
+
+bool TraceWriter::Flush() {
+  output_.write(buffer_.data(), buffer_.size());
+  buffer_.clear();
+  output_.flush();
+  return (bool)output_;
+}
+
+size_t TraceWriter::GetNumEvents() const {
+  return num_events_;
+}
+
+bool LoadTrace(std::istream& input, SearchTrace& trace) {
+  trace.map = GridMap();
+  trace.events.clear();
+
+  char magic[sizeof(kMagic)];
+  uint32_t version = 0;
+  uint32_t num_rows = 0;
+  uint32_t num_cols = 0;
+  if (!input.read(magic, sizeof(magic)) ||
+      !std::equal(magic, magic + sizeof(magic), kMagic) ||
+      !ReadUint32(input, version) || version != kVersion ||
+      !ReadUint32(input, num_rows) || !ReadUint32(input, num_cols)) {
+    return false;
+  }
+
+  // Both sides are capped, so their product can't overflow
+  if (num_rows > kMaxSide || num_cols > kMaxSide ||
+      !HasBytesLeft(input, (uint64_t)num_rows * num_cols)) {
+    return false;
+  }
+
+  GridMap map = GridMap(num_rows, num_cols);
+  std::vector<unsigned char> cells(map.GetNumCells());
+  if (!input.read((char*)cells.data(), cells.size())) {
+    return false;
+  }
+  for (CellIndex index = 0; index < map.GetNumCells(); index++) {
+    if (cells[index] == 0) {
+      map.SetPassable(index, false);
+    } else {
+      map.SetCost(index, cells[index]);
+    }
+  }
+
+  // Events are read in blocks until the end of the stream
+  std::vector<TraceEvent> events;
+  std::vector<unsigned char> block(1 << 16);
+  size_t num_buffered = 0;
+  while (input) {
+    input.read((char*)block.data() + num_buffered,
+               block.size() - num_buffered);
+    num_buffered += (size_t)input.gcount();
+    size_t num_events = num_buffered / 8;
+    for (size_t i = 0; i < num_events; i++) {
+      TraceEvent event;
+      event.cell = DecodeUint32(&block[8 * i]);
+      event.type_and_cost = DecodeUint32(&block[8 * i + 4]);
+      if (event.cell >= map.GetNumCells() ||
+          (event.type_and_cost >> 24) > kLastType) {
+        return false;
+      }
+      events.push_back(event);
+    }
+
+    // A partial event is kept for the next block
+    std::copy(block.begin() + 8 * num_events, block.begin() + num_buffered,
+              block.begin());
+    num_buffered -= 8 * num_events;
+  }
+
+  trace.map = map;
+  trace.events.swap(events);
+  return true;
+}
+
+}  // namespace pathfinder
@@ -0,0 +1,108 @@
+#include <core/trace_replay.h>
+
+#include <algorithm>
+
+namespace pathfinder {
+
+const size_t TraceReplay::kNever;
+
+TraceReplay::TraceReplay() {
+}
+
+TraceReplay::TraceReplay(const SearchTrace& trace)
+    : map_(trace.map), events_(trace.events) {
+  for (size_t i = 0; i < events_.size(); i++) {
+    if (events_[i].GetType() == TraceEventType::kStart) {
+      query_starts_.push_back(i);
+    }
+  }
+  opened_at_.assign(map_.GetNumCells(), kNever);
+  closed_at_.assign(map_.GetNumCells(), kNever);
+  path_at_.assign(map_.GetNumCells(), kNever);
+  if (!query_starts_.empty()) {
+    SelectQuery(0);
+  }
+}
+
+const GridMap& TraceReplay::GetMap() const {
+  return map_;
+}
+
+size_t TraceReplay::GetNumQueries() const {
+  return query_starts_.size();
+}
+
+void TraceReplay::SelectQuery(size_t query) {
+  // Only the cells the old query touched need to be forgotten
+  for (size_t i = first_event_; i < end_event_; i++) {
+    CellIndex cell = events_[i].cell;
+    opened_at_[cell] = kNever;
+    closed_at_[cell] = kNever;
+    path_at_[cell] = kNever;
+  }
+
+  query_ = query;
+  first_event_ = query_starts_[query];
+  end_event_ = query + 1 < query_starts_.size() ? query_starts_[query + 1]
+                                                : events_.size();
+  position_ = 0;
+  for (size_t i = first_event_; i < end_event_; i++) {
+    size_t step = i - first_event_;
+    CellIndex cell = events_[i].cell;
+    switch (events_[i].GetType()) {
+      case TraceEventType::kPush:
+      case TraceEventType::kDecreaseKey:
+        opened_at_[cell] = std::min(opened_at_[cell], step);
+        break;
+
+      case TraceEventType::kPop:
+        closed_at_[cell] = std::min(closed_at_[cell], step);
+        break;
+
+      case TraceEventType::kPath:
+        path_at_[cell] = std::min(path_at_[cell], step);
+        break;
+
+      case TraceEventType::kStart:
+      case TraceEventType::kGoal:
+        break;
+    }
+  }
+}
+
+size_t TraceReplay::GetQuery() const {
+  return query_;
+}
+
+CellIndex TraceReplay::GetStart() const {
+  return query_starts_.empty() ? kNoCell : events_[first_event_].cell;
+}
+
+CellIndex TraceReplay::GetGoal() const {
+  // kGoal comes right after kStart
+  if (first_event_ + 1 >= end_event_ ||
+      events_[first_event_ + 1].GetType() != TraceEventType::kGoal) {
+    return kNoCell;
+  }
+  return events_[first_event_ + 1].cell;
+}
+
+size_t TraceReplay::GetNumSteps() const {
+  return end_event_ - first_event_;
+}
+
+size_t TraceReplay::GetPosition() const {
+  return position_;
+}
+
+void TraceReplay::Seek(size_t position, std::vector<CellIndex>& changed) {
+  position = std::min(position, GetNumSteps());
+  size_t begin = std::min(position, position_);
+  size_t end = std::max(position, position_);
+  for (size_t step = begin; step < end; step++) {
+    changed.push_back(events_[first_event_ + step].cell);
+  }
+  position_ = position;
+}
+
+}  // namespace pathfinder
@@ -1,132 +1,147 @@
 #include <visualizer/grid.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
 namespace pathfinder {
 
 namespace visualizer {
 
 using glm::vec2;
 
+const size_t Grid::kMaxStepsPerFrame;
+const size_t Grid::kUnlimitedSteps;
+const size_t Grid::kStepsPerClockCheck;
+
+namespace {
+
+// How long a frame may spend showing the search's steps, which leaves time
+// to draw at 60 frames a second
+const std::chrono::milliseconds kFrameBudget(8);
+
+// The colors cells are drawn in, the same ones the grid was drawn in when
+// each cell was its own rectangle
+const ci::Color8u kEmptyColor(255, 255, 255);
+const ci::Color8u kMudColor(153, 102, 51);
+const ci::Color8u kWallColor(0, 0, 0);
+const ci::Color8u kStartColor(255, 0, 0);
+const ci::Color8u kEndColor(0, 0, 255);
+const ci::Color8u kExpandedColor(255, 255, 0);
+const ci::Color8u kOpenColor(255, 200, 120);
+const ci::Color8u kPathColor(0, 128, 0);
+const ci::Color8u kUnreachableColor(128, 128, 128);
+
+// The brush always covers the cell under it, and can grow to cover a circle
+// of this many cells around it
+const double kMinBrushRadius = 0.5;
+const double kMaxBrushRadius = 32;
+
+}  // namespace
+
 Grid::Grid(const vec2& top_left_corner, size_t num_cells_per_side,
            double map_size, double brush_radius)
     : top_left_corner_(top_left_corner),
       num_pixels_per_side_(num_cells_per_side),
       pixel_side_length_(map_size / num_cells_per_side),
-      brush_radius_(brush_radius) {
-  cells_.resize(num_pixels_per_side_);
-  for (size_t row = 0; row < num_pixels_per_side_; row++) {
-    for (size_t col = 0; col < num_pixels_per_side_; col++) {
-      Cell new_cell = Cell(CellType::kEmpty, row, col);
-      cells_[row].push_back(new_cell);
-    }
-  }
-  cells_.resize(num_pixels_per_side_ * num_pixels_per_side_);
-  pathfinder_ = Pathfinder(cells_, cells_[0][0],
-                           cells_[cells_.size() - 1][cells_.size() - 1]);
+      brush_radius_(brush_radius),
+      map_(num_cells_per_side, num_cells_per_side),
+      renderer_(num_cells_per_side, num_cells_per_side) {
+  path_cells_.Resize(map_.GetNumCells());
+  expanded_cells_.Resize(map_.GetNumCells());
+  dirty_cells_.Resize(map_.GetNumCells());
 }
 
-void Grid::Draw() const {
-  for (size_t row = 0; row < num_pixels_per_side_; ++row) {
-    for (size_t col = 0; col < num_pixels_per_side_; ++col) {
-      switch (cells_[row][col].GetType()) {
-        case CellType::kEmpty:
-          ci::gl::color(ci::Color("white"));
-          break;
-
-        case CellType::kWall:
-          ci::gl::color(ci::Color("black"));
-          break;
-
-        case CellType::kStart:
-          ci::gl::color(ci::Color("red"));
-          break;
-
-        case CellType::kEnd:
-          ci::gl::color(ci::Color("blue"));
-      }
-
-      // If the cell is apart of the path found from the pathfinder or
-      // the cell that is currently being looked at, it will be colored
-      // green instead
-      if (path_found_) {
-        if (ContainsElement(path_, cells_[row][col])) {
-          ci::gl::color(ci::Color("green"));
-        }
-      } else {
-        if (current_cell_.GetPosition().x == row &&
-            current_cell_.GetPosition().y == col) {
-          ci::gl::color(ci::Color("green"));
-        }
+void Grid::Draw() {
+  if (all_dirty_) {
+    for (size_t row = 0; row < num_pixels_per_side_; ++row) {
+      for (size_t col = 0; col < num_pixels_per_side_; ++col) {
+        renderer_.SetColor(map_.GetIndex(row, col), GetCellColor(row, col));
       }
-
-      vec2 pixel_top_left = top_left_corner_ + vec2(col * pixel_side_length_,
-                                                    row * pixel_side_length_);
-
-      vec2 pixel_bottom_right =
-          pixel_top_left + vec2(pixel_side_length_, pixel_side_length_);
-      ci::Rectf pixel_bounding_box(pixel_top_left, pixel_bottom_right);
-
-      ci::gl::drawSolidRect(pixel_bounding_box);
-
-      ci::gl::color(ci::Color("black"));
-      ci::gl::drawStrokedRect(pixel_bounding_box);
+    }
+  } else {
+    for (CellIndex index : dirty_list_) {
+      renderer_.SetColor(index,
+                         GetCellColor(map_.GetRow(index), map_.GetCol(index)));
     }
   }
+  all_dirty_ = false;
+  dirty_cells_.Clear();
+  dirty_list_.clear();
+
+  vec2 bottom_right =
+      top_left_corner_ + vec2(num_pixels_per_side_ * pixel_side_length_,
+                              num_pixels_per_side_ * pixel_side_length_);
+  renderer_.Draw(ci::Rectf(top_left_corner_, bottom_right));
 }
 
 void Grid::Update() {
   if (pathfinding_) {
     FindPath();
   }
+  if (replaying_ && playing_) {
+    StepForward();
+    playing_ = replay_.GetPosition() < replay_.GetNumSteps();
+  }
 }
 
 void Grid::HandleBrush(const vec2& brush_screen_coords) {
-  vec2 brush_sketchpad_coords =
-      (brush_screen_coords - top_left_corner_) / (float)pixel_side_length_;
-
-  for (size_t row = 0; row < num_pixels_per_side_; ++row) {
-    for (size_t col = 0; col < num_pixels_per_side_; ++col) {
-      vec2 pixel_center = {col + 0.5, row + 0.5};
-
-      // Whenever the user draws a cell, it will change the state of that cell
-      // based on the current draw_state
-      if (glm::distance(brush_sketchpad_coords, pixel_center) <=
-          brush_radius_) {
-        switch (draw_state_) {
-          case 0:
-            cells_[row][col] = Cell(CellType::kEmpty, row, col);
-            break;
-
-          case 1:
-            cells_[row][col] = Cell(CellType::kStart, row, col);
-            start_point = true;
-            current_cell_ = cells_[row][col];
-            start_cell_ = cells_[row][col];
-            break;
-
-          case 2:
-            cells_[row][col] = Cell(CellType::kEnd, row, col);
-            end_point = true;
-            end_cell_ = cells_[row][col];
-            break;
-
-          case 3:
-            cells_[row][col] = Cell(CellType::kWall, row, col);
-            break;
-        }
-      }
-    }
+  if (replaying_) {
+    return;
   }
-  allowed_ = start_point && end_point;
+  vec2 brush_sketchpad_coords = ToSketchpadCoords(brush_screen_coords);
+  BeginStroke();
+  PaintCircle(brush_sketchpad_coords);
+  EndStroke();
+  last_brush_coords_ = brush_sketchpad_coords;
+}
+
+void Grid::DragBrush(const vec2& brush_screen_coords) {
+  if (replaying_) {
+    return;
+  }
+  vec2 brush_sketchpad_coords = ToSketchpadCoords(brush_screen_coords);
+  BeginStroke();
+
+  // Circles are painted along the segment from the last position at most
+  // half a radius apart, so a fast drag leaves no gaps
+  float distance = glm::distance(last_brush_coords_, brush_sketchpad_coords);
+  float spacing = std::max((float)brush_radius_, 1.0f) / 2;
+  int num_steps = (int)std::ceil(distance / spacing);
+  for (int step = 1; step <= num_steps; step++) {
+    float t = (float)step / num_steps;
+    PaintCircle(last_brush_coords_ +
+                (brush_sketchpad_coords - last_brush_coords_) * t);
+  }
+  if (num_steps == 0) {
+    PaintCircle(brush_sketchpad_coords);
+  }
+
+  EndStroke();
+  last_brush_coords_ = brush_sketchpad_coords;
+}
+
+void Grid::SetBrushRadius(double brush_radius) {
+  brush_radius_ = std::min(std::max(brush_radius, kMinBrushRadius),
+                           kMaxBrushRadius);
+}
+
+double Grid::GetBrushRadius() const {
+  return brush_radius_;
 }
 
 void Grid::Clear() {
-  cells_.clear();
-  cells_.resize(num_pixels_per_side_);
-  for (size_t row = 0; row < num_pixels_per_side_; row++) {
-    for (size_t col = 0; col < num_pixels_per_side_; col++) {
-      Cell new_cell = Cell(CellType::kEmpty, row, col);
-      cells_[row].push_back(new_cell);
-    }
+  map_.Clear();
+  start_point = false;
+  end_point = false;
+  allowed_ = false;
+  path_found_ = false;
+  replaying_ = false;
+  playing_ = false;
+  expanded_cells_.Clear();
+  MarkAllDirty();
+  if (show_flow_field_) {
+    BuildFlowField();
   }
 }
 
@@ -135,37 +150,495 @@ void Grid::SetDrawState(int state) {
 }
 
 void Grid::SetState(bool pathfinding) {
-  pathfinding_ = pathfinding;
+  // allowed_ ensures there is a start and end point, meaning a path can be
+  // found
+  pathfinding_ = pathfinding && allowed_;
   if (pathfinding_) {
-    pathfinder_.SetGrid(cells_, start_cell_, end_cell_);
-  } else if (!pathfinding) {
+    search_.Start(map_, GetIndex(start_cell_), GetIndex(end_cell_),
+                  search_mode_, use_landmarks_);
+    current_cell_ = start_cell_;
+    path_found_ = false;
+    path_.clear();
+    path_cells_.Clear();
+    expanded_cells_.Clear();
+  } else {
+    search_.Stop();
     path_.clear();
+    path_cells_.Clear();
+    expanded_cells_.Clear();
+  }
+  MarkAllDirty();
+}
+
+void Grid::SetSearchMode(SearchMode mode) {
+  search_mode_ = mode;
+
+  // A search that is already running starts over in the new mode
+  if (pathfinding_) {
+    SetState(true);
+  }
+}
+
+void Grid::ToggleLandmarks() {
+  use_landmarks_ = !use_landmarks_;
+  if (pathfinding_) {
+    SetState(true);
+  }
+}
+
+void Grid::ToggleFlowField() {
+  show_flow_field_ = !show_flow_field_;
+  MarkAllDirty();
+  if (show_flow_field_) {
+    BuildFlowField();
+  }
+}
+
+void Grid::SpeedUp() {
+  if (steps_per_frame_ >= kMaxStepsPerFrame) {
+    steps_per_frame_ = kUnlimitedSteps;
+  } else {
+    steps_per_frame_ *= 2;
+  }
+}
+
+void Grid::SlowDown() {
+  if (steps_per_frame_ == kUnlimitedSteps) {
+    steps_per_frame_ = kMaxStepsPerFrame;
+  } else {
+    steps_per_frame_ = std::max(steps_per_frame_ / 2, (size_t)1);
+  }
+}
+
+void Grid::LoadTrace(const SearchTrace& trace) {
+  SetState(false);
+  path_found_ = false;
+  replay_ = TraceReplay(trace);
+  replaying_ = true;
+  playing_ = false;
+
+  // The sketchpad keeps its size on screen, so bigger maps get smaller
+  // pixels
+  double map_size = num_pixels_per_side_ * pixel_side_length_;
+  num_pixels_per_side_ = std::max(
+      std::max(trace.map.GetNumRows(), trace.map.GetNumCols()), (size_t)1);
+  pixel_side_length_ = map_size / num_pixels_per_side_;
+  map_ = GridMap(num_pixels_per_side_, num_pixels_per_side_);
+  renderer_ = GridRenderer(num_pixels_per_side_, num_pixels_per_side_);
+  path_cells_.Resize(map_.GetNumCells());
+  expanded_cells_.Resize(map_.GetNumCells());
+  dirty_cells_.Resize(map_.GetNumCells());
+  dirty_list_.clear();
+  for (CellIndex index = 0; index < map_.GetNumCells(); index++) {
+    map_.SetPassable(index, false);
+  }
+  for (CellIndex index = 0; index < trace.map.GetNumCells(); index++) {
+    CellIndex grid_index = GetReplayIndex(index);
+    map_.SetPassable(grid_index, trace.map.IsPassable(index));
+    map_.SetCost(grid_index, trace.map.GetCost(index));
+  }
+
+  // The old start and end may be off the new map, and every pixel is drawn
+  // again anyway
+  start_point = false;
+  end_point = false;
+  allowed_ = false;
+  start_cell_ = Cell(CellType::kEmpty, 0, 0);
+  end_cell_ = Cell(CellType::kEmpty, 0, 0);
+  current_cell_ = Cell(CellType::kEmpty, 0, 0);
+  if (replay_.GetNumQueries() > 0) {
+    ShowQuery(0);
+  }
+  MarkAllDirty();
+  if (show_flow_field_) {
+    BuildFlowField();
+  }
+}
+
+void Grid::TogglePlayback() {
+  if (!replaying_) {
+    return;
+  }
+  if (!playing_ && replay_.GetPosition() == replay_.GetNumSteps()) {
+    SeekReplay(0);
+  }
+  playing_ = !playing_;
+}
+
+void Grid::StepForward() {
+  if (!replaying_) {
+    return;
+  }
+  size_t position = replay_.GetPosition();
+  size_t remaining = replay_.GetNumSteps() - position;
+  SeekReplay(steps_per_frame_ >= remaining ? replay_.GetNumSteps()
+                                           : position + steps_per_frame_);
+}
+
+void Grid::StepBackward() {
+  if (!replaying_) {
+    return;
+  }
+  size_t position = replay_.GetPosition();
+  SeekReplay(steps_per_frame_ >= position ? 0 : position - steps_per_frame_);
+}
+
+void Grid::NextQuery() {
+  if (replaying_ && replay_.GetNumQueries() > 0) {
+    ShowQuery((replay_.GetQuery() + 1) % replay_.GetNumQueries());
+  }
+}
+
+void Grid::ShowQuery(size_t query) {
+  MarkEndpointsDirty();
+  SeekReplay(0);
+  replay_.SelectQuery(query);
+  playing_ = false;
+
+  // The start and end drawn are the query's
+  const GridMap& trace_map = replay_.GetMap();
+  CellIndex start = replay_.GetStart();
+  CellIndex goal = replay_.GetGoal();
+  start_point = start != kNoCell;
+  end_point = goal != kNoCell;
+  if (start_point) {
+    start_cell_ = Cell(CellType::kStart, trace_map.GetRow(start),
+                       trace_map.GetCol(start));
+  }
+  if (end_point) {
+    end_cell_ = Cell(CellType::kEnd, trace_map.GetRow(goal),
+                     trace_map.GetCol(goal));
+  }
+  current_cell_ = start_cell_;
+  MarkEndpointsDirty();
+  if (show_flow_field_) {
+    BuildFlowField();
+  }
+}
+
+void Grid::SeekReplay(size_t position) {
+  replay_changed_.clear();
+  replay_.Seek(position, replay_changed_);
+  for (CellIndex index : replay_changed_) {
+    MarkDirty(GetReplayIndex(index));
+  }
+}
+
+ReplayCellState Grid::GetReplayState(size_t row, size_t col) const {
+  const GridMap& trace_map = replay_.GetMap();
+  if (row >= trace_map.GetNumRows() || col >= trace_map.GetNumCols()) {
+    return ReplayCellState::kUnseen;
   }
+  return replay_.GetCellState(trace_map.GetIndex(row, col));
+}
+
+CellIndex Grid::GetReplayIndex(CellIndex trace_index) const {
+  const GridMap& trace_map = replay_.GetMap();
+  return map_.GetIndex(trace_map.GetRow(trace_index),
+                       trace_map.GetCol(trace_index));
 }
 
 void Grid::FindPath() {
-  /*
-   * allowed_ ensures there is a start and end point, meaning a path can be
-   * found pathfinding_ checks to see if the user wants to pathfind
-   */
-  if (allowed_ && pathfinding_) {
-    if (current_cell_.GetPosition() != end_cell_.GetPosition()) {
-      current_cell_ = pathfinder_.FindNextCell(current_cell_);
-    } else {
+  // The search runs on search_'s thread, and each frame shows as many of its
+  // steps as the speed allows and there is time for
+  std::chrono::steady_clock::time_point deadline =
+      std::chrono::steady_clock::now() + kFrameBudget;
+  size_t num_steps = 0;
+  SearchEvent event;
+  while (pathfinding_ && num_steps < steps_per_frame_ && search_.Poll(event)) {
+    if (event.type == SearchEvent::Type::kExpand) {
+      num_steps++;
+    }
+    HandleSearchEvent(event);
+
+    // The clock is only read every so often, since an event takes far less
+    // time to handle than reading it
+    if (num_steps % kStepsPerClockCheck == 0 &&
+        std::chrono::steady_clock::now() > deadline) {
+      break;
+    }
+  }
+}
+
+void Grid::HandleSearchEvent(const SearchEvent& event) {
+  switch (event.type) {
+    case SearchEvent::Type::kExpand:
+      // Only the cell the search left and the one it moved to change color
+      MarkDirty(GetIndex(current_cell_));
+      current_cell_ = Cell(CellType::kEmpty, map_.GetRow(event.cell),
+                           map_.GetCol(event.cell));
+      expanded_cells_.Insert(event.cell);
+      MarkDirty(event.cell);
+      break;
+
+    case SearchEvent::Type::kPath:
+      path_.push_back(event.cell);
+      path_cells_.Insert(event.cell);
+      MarkDirty(event.cell);
+      break;
+
+    case SearchEvent::Type::kFinished:
+      // With no path, every reachable cell has been expanded without finding
+      // end_cell_
       pathfinding_ = false;
-      path_ = pathfinder_.GetPath(end_cell_);
-      path_found_ = true;
+      if (event.cell != kNoCell) {
+        path_found_ = true;
+        MarkDirty(GetIndex(current_cell_));
+        replanner_.Reset(GetIndex(start_cell_), GetIndex(end_cell_));
+      }
+      break;
+  }
+}
+
+void Grid::RepairPath() {
+  // The old path has to be drawn over, whether or not there is a new one.
+  // From here on the path drawn is the repaired one.
+  MarkPathDirty();
+  path_.clear();
+  replanned_path_.clear();
+  path_cells_.Clear();
+  if (!allowed_) {
+    path_found_ = false;
+    return;
+  }
+
+  CellIndex start = GetIndex(start_cell_);
+  CellIndex goal = GetIndex(end_cell_);
+
+  // The search grows from the goal, so only moving the goal starts it over
+  if (goal != replanner_.GetGoal()) {
+    replanner_.Reset(start, goal);
+  } else {
+    if (start != replanner_.GetStart()) {
+      replanner_.SetStart(start);
+    }
+    replanner_.UpdateCells(changed_cells_);
+  }
+
+  replanner_.FindPath(replanned_path_);
+  for (CellIndex index : replanned_path_) {
+    path_cells_.Insert(index);
+  }
+  MarkPathDirty();
+}
+
+void Grid::BuildFlowField() {
+  std::vector<CellIndex> goals;
+  if (end_point) {
+    goals.push_back(GetIndex(end_cell_));
+  }
+  flow_field_.Build(map_, goals);
+
+  // Moving the end point or a wall can change the distance of every cell
+  MarkAllDirty();
+}
+
+ci::Color8u Grid::GetCellColor(size_t row, size_t col) const {
+  CellIndex index = map_.GetIndex(row, col);
+  CellType type = GetCellType(row, col);
+
+  // The heat map takes the place of the search
+  if (show_flow_field_) {
+    if (type == CellType::kEmpty) {
+      return GetHeatColor(index);
+    }
+  } else if (replaying_) {
+    // The path of the query being replayed covers its start and end, as the
+    // path of a live search does
+    if (GetReplayState(row, col) == ReplayCellState::kPath) {
+      return kPathColor;
+    }
+  } else if (path_found_) {
+    // Cells on the path found by the pathfinder are colored green
+    if (path_cells_.Contains(index)) {
+      return kPathColor;
+    }
+  } else if (current_cell_.GetPosition().row == row &&
+             current_cell_.GetPosition().col == col) {
+    // So is the cell that is currently being looked at
+    return kPathColor;
+  }
+
+  switch (type) {
+    case CellType::kWall:
+      return kWallColor;
+
+    case CellType::kStart:
+      return kStartColor;
+
+    case CellType::kEnd:
+      return kEndColor;
+
+    case CellType::kEmpty:
+      break;
+  }
+
+  // Cells the search has moved to are colored yellow. When replaying, so are
+  // the cells taken from the queue, and the cells still in it are orange.
+  if (!show_flow_field_ && replaying_) {
+    ReplayCellState state = GetReplayState(row, col);
+    if (state == ReplayCellState::kClosed) {
+      return kExpandedColor;
+    } else if (state == ReplayCellState::kOpen) {
+      return kOpenColor;
     }
+  } else if (!show_flow_field_ && expanded_cells_.Contains(index)) {
+    return kExpandedColor;
   }
+  return map_.GetCost(index) > 1 ? kMudColor : kEmptyColor;
 }
 
-bool Grid::ContainsElement(std::vector<Cell> list, Cell element) const {
-  for (Cell cell : list) {
-    if (cell.GetPosition() == element.GetPosition()) {
-      return true;
+ci::Color8u Grid::GetHeatColor(CellIndex index) const {
+  int distance = flow_field_.GetDistance(index);
+  if (distance < 0) {
+    return kUnreachableColor;
+  }
+  float heat = (float)distance / std::max(flow_field_.GetMaxDistance(), 1);
+  return ci::Color8u((uint8_t)(255 * (1 - heat)), 0, (uint8_t)(255 * heat));
+}
+
+vec2 Grid::ToSketchpadCoords(const vec2& screen_coords) const {
+  return (screen_coords - top_left_corner_) / (float)pixel_side_length_;
+}
+
+void Grid::BeginStroke() {
+  // The start, end and current cells are marked before and after painting,
+  // which covers them moving
+  MarkEndpointsDirty();
+}
+
+void Grid::PaintCircle(const vec2& center) {
+  // A cell is painted when its center is within brush_radius_ of the brush,
+  // so the rows painted are the ones whose centers are within the radius
+  // vertically, and each row covers the columns within the circle's width
+  // at that row
+  double radius = brush_radius_;
+  double last = (double)num_pixels_per_side_ - 1;
+  double first_row = std::max(std::ceil(center.y - radius - 0.5), 0.0);
+  double last_row = std::min(std::floor(center.y + radius - 0.5), last);
+  for (double row = first_row; row <= last_row; row++) {
+    double y_distance = row + 0.5 - center.y;
+    double half_width =
+        std::sqrt(std::max(radius * radius - y_distance * y_distance, 0.0));
+    double first_col = std::max(std::ceil(center.x - half_width - 0.5), 0.0);
+    double last_col = std::min(std::floor(center.x + half_width - 0.5), last);
+    for (double col = first_col; col <= last_col; col++) {
+      PaintCell((size_t)row, (size_t)col);
     }
   }
-  return false;
+
+  // The pixel under the brush is painted even if the brush is nearer one of
+  // its corners than its center
+  if (center.x >= 0 && center.y >= 0 && center.x < last + 1 &&
+      center.y < last + 1) {
+    PaintCell((size_t)center.y, (size_t)center.x);
+  }
+}
+
+void Grid::PaintCell(size_t row, size_t col) {
+  // Whenever the user draws a cell, it will change the state of that cell
+  // based on the current draw_state
+  CellIndex index = map_.GetIndex(row, col);
+  bool was_passable = map_.IsPassable(index);
+  int old_cost = map_.GetCost(index);
+  MarkDirty(index);
+
+  // Painting over the start or end point removes it
+  if (GetCellType(row, col) == CellType::kStart) {
+    start_point = false;
+  } else if (GetCellType(row, col) == CellType::kEnd) {
+    end_point = false;
+  }
+
+  switch (draw_state_) {
+    case 0:
+      map_.SetPassable(index, true);
+      map_.SetCost(index, 1);
+      break;
+
+    case 1:
+      map_.SetPassable(index, true);
+      start_point = true;
+      start_cell_ = Cell(CellType::kStart, row, col);
+      current_cell_ = start_cell_;
+      break;
+
+    case 2:
+      map_.SetPassable(index, true);
+      end_point = true;
+      end_cell_ = Cell(CellType::kEnd, row, col);
+      break;
+
+    case 3:
+      map_.SetPassable(index, false);
+      break;
+
+    case 4:
+      map_.SetPassable(index, true);
+      map_.SetCost(index, kMudCost);
+      break;
+  }
+  if (map_.IsPassable(index) != was_passable ||
+      map_.GetCost(index) != old_cost) {
+    changed_cells_.push_back(index);
+  }
+}
+
+void Grid::EndStroke() {
+  allowed_ = start_point && end_point;
+  MarkEndpointsDirty();
+
+  if (path_found_) {
+    RepairPath();
+  }
+  if (show_flow_field_) {
+    BuildFlowField();
+  }
+  changed_cells_.clear();
+}
+
+void Grid::MarkDirty(CellIndex index) {
+  if (!dirty_cells_.Contains(index)) {
+    dirty_cells_.Insert(index);
+    dirty_list_.push_back(index);
+  }
+}
+
+void Grid::MarkAllDirty() {
+  all_dirty_ = true;
+}
+
+void Grid::MarkEndpointsDirty() {
+  MarkDirty(GetIndex(start_cell_));
+  MarkDirty(GetIndex(end_cell_));
+  MarkDirty(GetIndex(current_cell_));
+}
+
+void Grid::MarkPathDirty() {
+  // The path drawn is either the one the pathfinder found or a repaired one
+  for (CellIndex index : path_) {
+    MarkDirty(index);
+  }
+  for (CellIndex index : replanned_path_) {
+    MarkDirty(index);
+  }
+}
+
+CellIndex Grid::GetIndex(const Cell& cell) const {
+  return map_.GetIndex(cell.GetPosition().row, cell.GetPosition().col);
+}
+
+CellType Grid::GetCellType(size_t row, size_t col) const {
+  if (start_point && start_cell_.GetPosition().row == row &&
+      start_cell_.GetPosition().col == col) {
+    return CellType::kStart;
+  } else if (end_point && end_cell_.GetPosition().row == row &&
+             end_cell_.GetPosition().col == col) {
+    return CellType::kEnd;
+  } else if (!map_.IsPassable(map_.GetIndex(row, col))) {
+    return CellType::kWall;
+  }
+  return CellType::kEmpty;
 }
 
 }  // namespace visualizer
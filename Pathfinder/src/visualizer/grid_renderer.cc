@@ -0,0 +1,122 @@
+#include <visualizer/grid_renderer.h>
+
+#include <algorithm>
+
+namespace pathfinder {
+
+namespace visualizer {
+
+namespace {
+
+const char* kVertexShader = R"(
+  #version 150
+
+  uniform mat4 ciModelViewProjection;
+  in vec4 ciPosition;
+  in vec2 ciTexCoord0;
+  out vec2 vTexCoord;
+
+  void main() {
+    vTexCoord = ciTexCoord0;
+    gl_Position = ciModelViewProjection * ciPosition;
+  }
+)";
+
+// A fragment within half a screen pixel of the edge of a cell is part of
+// the line around it. Cells only a few pixels wide, as on the large maps of
+// traces, have no lines, which would cover them.
+const char* kFragmentShader = R"(
+  #version 150
+
+  uniform sampler2D uCellColors;
+  uniform vec2 uNumCells;
+  in vec2 vTexCoord;
+  out vec4 oColor;
+
+  void main() {
+    vec2 cell = vTexCoord * uNumCells;
+    vec2 cell_size = 1.0 / fwidth(cell);
+    vec2 edge = min(fract(cell), 1.0 - fract(cell)) * cell_size;
+    if (min(cell_size.x, cell_size.y) > 4.0 && min(edge.x, edge.y) < 0.5) {
+      oColor = vec4(0.0, 0.0, 0.0, 1.0);
+    } else {
+      oColor = texture(uCellColors, vTexCoord);
+    }
+  }
+)";
+
+}  // namespace
+
+const size_t GridRenderer::kBytesPerCell;
+
+GridRenderer::GridRenderer(size_t num_rows, size_t num_cols)
+    : num_rows_(num_rows),
+      num_cols_(num_cols),
+      colors_(num_rows * num_cols * kBytesPerCell, 0),
+      first_changed_row_(0),
+      end_changed_row_(num_rows) {
+  for (size_t i = kBytesPerCell - 1; i < colors_.size(); i += kBytesPerCell) {
+    colors_[i] = 255;
+  }
+}
+
+void GridRenderer::SetColor(CellIndex index, const ci::Color8u& color) {
+  uint8_t* texel = &colors_[index * kBytesPerCell];
+  if (texel[0] == color.r && texel[1] == color.g && texel[2] == color.b) {
+    return;
+  }
+  texel[0] = color.r;
+  texel[1] = color.g;
+  texel[2] = color.b;
+
+  size_t row = index / num_cols_;
+  first_changed_row_ = std::min(first_changed_row_, row);
+  end_changed_row_ = std::max(end_changed_row_, row + 1);
+}
+
+void GridRenderer::Draw(const ci::Rectf& bounds) {
+  if (num_rows_ == 0 || num_cols_ == 0) {
+    return;
+  }
+  if (!texture_) {
+    CreateGlObjects();
+  }
+
+  // The changed rows are contiguous in the buffer, so they go up in one call
+  if (first_changed_row_ < end_changed_row_) {
+    texture_->update(&colors_[first_changed_row_ * num_cols_ * kBytesPerCell],
+                     GL_RGBA, GL_UNSIGNED_BYTE, 0, (int)num_cols_,
+                     (int)(end_changed_row_ - first_changed_row_),
+                     glm::ivec2(0, (int)first_changed_row_));
+    first_changed_row_ = num_rows_;
+    end_changed_row_ = 0;
+  }
+
+  ci::gl::ScopedGlslProg scoped_program(program_);
+  ci::gl::ScopedTextureBind scoped_texture(texture_, 0);
+  program_->uniform("uCellColors", 0);
+  program_->uniform("uNumCells", glm::vec2(num_cols_, num_rows_));
+
+  // Row 0 is the first row of the texture, so it goes at the top
+  ci::gl::drawSolidRect(bounds, glm::vec2(0, 0), glm::vec2(1, 1));
+}
+
+void GridRenderer::CreateGlObjects() {
+  texture_ = ci::gl::Texture2d::create(
+      (int)num_cols_, (int)num_rows_,
+      ci::gl::Texture2d::Format()
+          .internalFormat(GL_RGBA8)
+          .minFilter(GL_NEAREST)
+          .magFilter(GL_NEAREST));
+  program_ = ci::gl::GlslProg::create(ci::gl::GlslProg::Format()
+                                          .vertex(kVertexShader)
+                                          .fragment(kFragmentShader));
+
+  // The whole buffer goes up with the first draw
+  first_changed_row_ = 0;
+  end_changed_row_ = num_rows_;
+}
+
+}  // namespace visualizer
+
+}  // namespace pathfinder
@@ -1,5 +1,8 @@
 #include <visualizer/pathfinder_app.h>
 
+#include <fstream>
+#include <iostream>
+
 namespace pathfinder {
 
 namespace visualizer {
@@ -26,7 +29,7 @@ void PathfinderApp::mouseDown(ci::app::MouseEvent event) {
 }
 
 void PathfinderApp::mouseDrag(ci::app::MouseEvent event) {
-  grid_.HandleBrush(event.getPos());
+  grid_.DragBrush(event.getPos());
 }
 
 void PathfinderApp::keyDown(ci::app::KeyEvent event) {
@@ -55,7 +58,86 @@ void PathfinderApp::keyDown(ci::app::KeyEvent event) {
     case ci::app::KeyEvent::KEY_3:
       grid_.SetDrawState(3);
       break;
+
+    case ci::app::KeyEvent::KEY_4:
+      grid_.SetDrawState(4);
+      break;
+
+    case ci::app::KeyEvent::KEY_a:
+      grid_.SetSearchMode(SearchMode::kAStar);
+      break;
+
+    case ci::app::KeyEvent::KEY_j:
+      grid_.SetSearchMode(SearchMode::kJumpPoint);
+      break;
+
+    case ci::app::KeyEvent::KEY_p:
+      grid_.SetSearchMode(SearchMode::kJumpPointPlus);
+      break;
+
+    case ci::app::KeyEvent::KEY_b:
+      grid_.SetSearchMode(SearchMode::kBidirectional);
+      break;
+
+    case ci::app::KeyEvent::KEY_l:
+      grid_.ToggleLandmarks();
+      break;
+
+    case ci::app::KeyEvent::KEY_f:
+      grid_.ToggleFlowField();
+      break;
+
+    case ci::app::KeyEvent::KEY_MINUS:
+      grid_.SlowDown();
+      break;
+
+    case ci::app::KeyEvent::KEY_EQUALS:
+      grid_.SpeedUp();
+      break;
+
+    case ci::app::KeyEvent::KEY_LEFTBRACKET:
+      grid_.SetBrushRadius(grid_.GetBrushRadius() - 1);
+      break;
+
+    case ci::app::KeyEvent::KEY_RIGHTBRACKET:
+      grid_.SetBrushRadius(grid_.GetBrushRadius() + 1);
+      break;
+
+    case ci::app::KeyEvent::KEY_t:
+      LoadTrace();
+      break;
+
+    case ci::app::KeyEvent::KEY_SPACE:
+      grid_.TogglePlayback();
+      break;
+
+    case ci::app::KeyEvent::KEY_RIGHT:
+      grid_.StepForward();
+      break;
+
+    case ci::app::KeyEvent::KEY_LEFT:
+      grid_.StepBackward();
+      break;
+
+    case ci::app::KeyEvent::KEY_n:
+      grid_.NextQuery();
+      break;
+  }
+}
+
+void PathfinderApp::LoadTrace() {
+  ci::fs::path path = getOpenFilePath();
+  if (path.empty()) {
+    return;
+  }
+
+  std::ifstream trace_file(path.string(), std::ios::binary);
+  SearchTrace trace;
+  if (!trace_file || !pathfinder::LoadTrace(trace_file, trace)) {
+    std::cerr << "Could not load trace " << path.string() << std::endl;
+    return;
   }
+  grid_.LoadTrace(trace);
 }
 
 }  // namespace visualizer
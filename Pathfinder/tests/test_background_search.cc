@@ -0,0 +1,170 @@
+#include <core/background_search.h>
+
+#include <catch2/catch.hpp>
+#include <random>
+#include <thread>
+#include <vector>
+
+using pathfinder::BackgroundSearch;
+using pathfinder::Cell;
+using pathfinder::CellIndex;
+using pathfinder::CellType;
+using pathfinder::GridMap;
+using pathfinder::SearchEvent;
+using pathfinder::SearchMode;
+
+namespace {
+
+/**
+ * Helper method that polls events until the search finishes, sorting them
+ * into the cells it moved to and the path
+ * @return The cell of the kFinished event
+ */
+CellIndex PollUntilFinished(BackgroundSearch& search,
+                            std::vector<CellIndex>& expanded,
+                            std::vector<CellIndex>& path) {
+  SearchEvent event;
+  while (true) {
+    if (!search.Poll(event)) {
+      std::this_thread::yield();
+    } else if (event.type == SearchEvent::Type::kExpand) {
+      expanded.push_back(event.cell);
+    } else if (event.type == SearchEvent::Type::kPath) {
+      path.push_back(event.cell);
+    } else {
+      return event.cell;
+    }
+  }
+}
+
+/**
+ * Helper method that steps a Pathfinder on the UI thread, the way the
+ * visualizer did before searches ran in the background
+ */
+void StepPathfinder(const GridMap& map, CellIndex start, CellIndex goal,
+                    SearchMode mode, std::vector<CellIndex>& expanded,
+                    std::vector<CellIndex>& path) {
+  Cell start_cell = Cell(CellType::kStart, map.GetRow(start),
+                         map.GetCol(start));
+  Cell end_cell = Cell(CellType::kEnd, map.GetRow(goal), map.GetCol(goal));
+  pathfinder::Pathfinder pathfinder =
+      pathfinder::Pathfinder(map, start_cell, end_cell);
+  pathfinder.SetSearchMode(mode);
+
+  Cell current = start_cell;
+  while (!pathfinder.PathFound(current) && !pathfinder.IsExhausted()) {
+    current = pathfinder.FindNextCell(current);
+    expanded.push_back(
+        map.GetIndex(current.GetPosition().row, current.GetPosition().col));
+  }
+  if (pathfinder.PathFound(current)) {
+    for (const Cell& cell : pathfinder.GetPath(end_cell)) {
+      path.insert(path.begin(), map.GetIndex(cell.GetPosition().row,
+                                             cell.GetPosition().col));
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("Test BackgroundSearch") {
+  // A small buffer makes the search wait for the test to catch up
+  BackgroundSearch search(16);
+  std::vector<CellIndex> expanded;
+  std::vector<CellIndex> path;
+
+  SECTION("Test that the events match stepping a Pathfinder") {
+    GridMap map = GridMap(20, 30);
+    std::mt19937 random(3);
+    std::bernoulli_distribution is_wall(0.25);
+    for (CellIndex index = 0; index < map.GetNumCells(); index++) {
+      map.SetPassable(index, !is_wall(random));
+    }
+    CellIndex start = map.GetIndex(0, 0);
+    CellIndex goal = map.GetIndex(19, 29);
+    map.SetPassable(start, true);
+    map.SetPassable(goal, true);
+
+    SearchMode modes[] = {SearchMode::kAStar, SearchMode::kJumpPoint,
+                          SearchMode::kBidirectional};
+    for (SearchMode mode : modes) {
+      std::vector<CellIndex> expected_expanded;
+      std::vector<CellIndex> expected_path;
+      StepPathfinder(map, start, goal, mode, expected_expanded,
+                     expected_path);
+
+      expanded.clear();
+      path.clear();
+      search.Start(map, start, goal, mode, false);
+      CellIndex finished = PollUntilFinished(search, expanded, path);
+      REQUIRE(expanded == expected_expanded);
+      REQUIRE(path == expected_path);
+      REQUIRE(finished == (path.empty() ? pathfinder::kNoCell : goal));
+    }
+  }
+
+  SECTION("Test a search with no path") {
+    // . # .
+    // . # .
+    GridMap map = GridMap(2, 3);
+    map.SetPassable(map.GetIndex(0, 1), false);
+    map.SetPassable(map.GetIndex(1, 1), false);
+    search.Start(map, map.GetIndex(0, 0), map.GetIndex(0, 2),
+                 SearchMode::kAStar, false);
+    REQUIRE(PollUntilFinished(search, expanded, path) == pathfinder::kNoCell);
+    REQUIRE(path.empty());
+  }
+
+  SECTION("Test that the search runs on a copy of the map") {
+    GridMap map = GridMap(1, 5);
+    search.Start(map, map.GetIndex(0, 0), map.GetIndex(0, 4),
+                 SearchMode::kAStar, false);
+    map.SetPassable(map.GetIndex(0, 2), false);
+    REQUIRE(PollUntilFinished(search, expanded, path) == map.GetIndex(0, 4));
+    REQUIRE(path.size() == 5);
+  }
+
+  SECTION("Test a search on a smaller map than the last one") {
+    // The pathfinder is reused, so the new map has to be set before the
+    // search restarts with the new mode and landmarks
+    GridMap big_map = GridMap(40, 40);
+    search.Start(big_map, big_map.GetIndex(39, 39), big_map.GetIndex(0, 0),
+                 SearchMode::kAStar, false);
+    PollUntilFinished(search, expanded, path);
+
+    GridMap small_map = GridMap(3, 3);
+    SearchMode modes[] = {SearchMode::kJumpPointPlus, SearchMode::kAStar};
+    for (SearchMode mode : modes) {
+      expanded.clear();
+      path.clear();
+      search.Start(small_map, small_map.GetIndex(0, 0),
+                   small_map.GetIndex(2, 2), mode, true);
+      REQUIRE(PollUntilFinished(search, expanded, path) ==
+              small_map.GetIndex(2, 2));
+      REQUIRE(path.size() == 5);
+      search.Start(big_map, big_map.GetIndex(39, 39), big_map.GetIndex(0, 0),
+                   mode, true);
+      PollUntilFinished(search, expanded, path);
+    }
+  }
+
+  SECTION("Test that starting again drops the old search's events") {
+    GridMap map = GridMap(64, 64);
+    search.Start(map, map.GetIndex(0, 0), map.GetIndex(63, 63),
+                 SearchMode::kAStar, false);
+    search.Start(map, map.GetIndex(0, 0), map.GetIndex(0, 2),
+                 SearchMode::kAStar, false);
+    REQUIRE(PollUntilFinished(search, expanded, path) == map.GetIndex(0, 2));
+    REQUIRE(expanded.size() == 2);
+    REQUIRE(path.size() == 3);
+
+    // A stopped search sends nothing more
+    search.Start(map, map.GetIndex(0, 0), map.GetIndex(63, 63),
+                 SearchMode::kAStar, false);
+    search.Stop();
+    SearchEvent event;
+    while (search.Poll(event)) {
+      REQUIRE(event.type != SearchEvent::Type::kFinished);
+    }
+  }
+}
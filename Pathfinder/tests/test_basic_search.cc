@@ -0,0 +1,97 @@
+#include <core/basic_search.h>
+
+#include <catch2/catch.hpp>
+#include <random>
+#include <vector>
+
+#include "test_maps.h"
+
+using pathfinder::AStarSearch;
+using pathfinder::BasicSearch;
+using pathfinder::BucketQueue;
+using pathfinder::CellCost;
+using pathfinder::CellIndex;
+using pathfinder::FourConnected;
+using pathfinder::GridMap;
+using pathfinder::ManhattanHeuristic;
+using pathfinder::OpenSet;
+using pathfinder::SearchContext;
+using pathfinder::SearchResult;
+using pathfinder::UniformCost;
+using pathfinder::testing::MakeRandomMap;
+
+namespace {
+
+typedef BasicSearch<ManhattanHeuristic, FourConnected, BucketQueue, CellCost>
+    BucketSearch;
+typedef BasicSearch<ManhattanHeuristic, FourConnected, OpenSet, UniformCost>
+    UniformSearch;
+
+}  // namespace
+
+TEST_CASE("Test BasicSearch") {
+  std::vector<CellIndex> path;
+  std::vector<CellIndex> expected_path;
+
+  SECTION("Test that every queue finds the same costs as FindPath") {
+    for (unsigned seed = 0; seed < 10; seed++) {
+      GridMap map = MakeRandomMap(21, 28, 0.2, seed < 5 ? 1 : 9, seed);
+      SearchContext context = SearchContext(map);
+      std::mt19937 random(seed);
+      std::uniform_int_distribution<CellIndex> cell(0, map.GetNumCells() - 1);
+      for (int query = 0; query < 40; query++) {
+        CellIndex start = cell(random);
+        CellIndex goal = cell(random);
+        SearchResult expected =
+            pathfinder::FindPath(context, start, goal, expected_path);
+        SearchResult heap = AStarSearch(context).FindPath(start, goal, path);
+        REQUIRE(heap.found == expected.found);
+        REQUIRE(heap.cost == expected.cost);
+        SearchResult bucket = BucketSearch(context).FindPath(start, goal, path);
+        REQUIRE(bucket.found == expected.found);
+        REQUIRE(bucket.cost == expected.cost);
+        REQUIRE(path == expected_path);
+      }
+    }
+  }
+
+  SECTION("Test that UniformCost ignores the map's costs") {
+    // Crossing the middle column costs 9 a cell, which only the search that
+    // reads the costs goes around
+    GridMap map = GridMap(5, 5);
+    for (size_t row = 0; row < 4; row++) {
+      map.SetCost(map.GetIndex(row, 2), 9);
+    }
+    SearchContext context = SearchContext(map);
+    CellIndex start = map.GetIndex(0, 0);
+    CellIndex goal = map.GetIndex(0, 4);
+    REQUIRE(UniformSearch(context).FindPath(start, goal, path).cost == 4);
+    REQUIRE(AStarSearch(context).FindPath(start, goal, path).cost == 12);
+  }
+
+  SECTION("Test stepping through a search by hand") {
+    // . . .
+    // . # .
+    GridMap map = GridMap(2, 3);
+    map.SetPassable(map.GetIndex(1, 1), false);
+    SearchContext context = SearchContext(map);
+    AStarSearch search = AStarSearch(context);
+    CellIndex start = map.GetIndex(1, 0);
+    CellIndex goal = map.GetIndex(1, 2);
+
+    search.Start(start, goal);
+    OpenSet& open_set = context.GetOpenSet();
+    REQUIRE(open_set.Pop() == start);
+    context.GetState().Close(start);
+    search.Expand(start, goal);
+    REQUIRE(open_set.Size() == 1);
+    REQUIRE(open_set.Top() == map.GetIndex(0, 0));
+
+    // A cheaper route lowers the G cost of an open cell
+    search.Open(map.GetIndex(0, 2), map.GetIndex(0, 0), 5, goal);
+    search.Open(map.GetIndex(0, 2), map.GetIndex(0, 1), 3, goal);
+    REQUIRE(context.GetState().GetGCost(map.GetIndex(0, 2)) == 3);
+    REQUIRE(context.GetState().GetParent(map.GetIndex(0, 2)) ==
+            map.GetIndex(0, 1));
+  }
+}
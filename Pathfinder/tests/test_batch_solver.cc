@@ -0,0 +1,74 @@
+#include <core/batch_solver.h>
+
+#include <catch2/catch.hpp>
+#include <cstdlib>
+#include <vector>
+
+TEST_CASE("Test BatchSolver") {
+  // 48x48 map with rows of walls that have a gap at alternating ends
+  const size_t kMapSize = 48;
+  pathfinder::GridMap map = pathfinder::GridMap(kMapSize, kMapSize);
+  for (size_t row = 3; row < kMapSize; row += 6) {
+    for (size_t col = 0; col < kMapSize - 1; col++) {
+      size_t wall_col = (row / 6) % 2 == 0 ? col : col + 1;
+      map.SetPassable(map.GetIndex(row, wall_col), false);
+    }
+  }
+
+  std::vector<pathfinder::Query> queries;
+  std::srand(7);
+  while (queries.size() < 500) {
+    pathfinder::Query query;
+    query.start = std::rand() % map.GetNumCells();
+    query.goal = std::rand() % map.GetNumCells();
+    queries.push_back(query);
+  }
+
+  // Solve every query one at a time for reference
+  pathfinder::SearchContext context = pathfinder::SearchContext(map);
+  std::vector<pathfinder::SearchResult> expected;
+  for (const pathfinder::Query& query : queries) {
+    expected.push_back(pathfinder::FindPath(context, query.start, query.goal,
+                                            context.GetPathBuffer()));
+  }
+
+  SECTION("Test that results match FindPath for any number of threads") {
+    for (size_t num_threads = 1; num_threads <= 4; num_threads++) {
+      pathfinder::BatchSolver solver(map, num_threads);
+      REQUIRE(solver.GetNumThreads() == num_threads);
+
+      std::vector<pathfinder::SearchResult> results;
+      solver.Solve(queries, results);
+      REQUIRE(results.size() == queries.size());
+      for (size_t query = 0; query < queries.size(); query++) {
+        REQUIRE(results[query].found == expected[query].found);
+        REQUIRE(results[query].cost == expected[query].cost);
+        REQUIRE(results[query].path_length == expected[query].path_length);
+        REQUIRE(results[query].num_expanded == expected[query].num_expanded);
+      }
+    }
+  }
+
+  SECTION("Test that a solver can be reused for several batches") {
+    pathfinder::BatchSolver solver(map, 3);
+    std::vector<pathfinder::SearchResult> results;
+    for (size_t batch = 0; batch < 5; batch++) {
+      solver.Solve(queries, results);
+      REQUIRE(results.size() == queries.size());
+      REQUIRE(results[batch].cost == expected[batch].cost);
+    }
+  }
+
+  SECTION("Test that an empty batch gives no results") {
+    pathfinder::BatchSolver solver(map, 2);
+    std::vector<pathfinder::Query> no_queries;
+    std::vector<pathfinder::SearchResult> results(3);
+    solver.Solve(no_queries, results);
+    REQUIRE(results.empty());
+  }
+
+  SECTION("Test that 0 threads uses at least one thread") {
+    pathfinder::BatchSolver solver(map);
+    REQUIRE(solver.GetNumThreads() >= 1);
+  }
+}
@@ -0,0 +1,133 @@
+#include <core/bidirectional_search.h>
+
+#include <catch2/catch.hpp>
+#include <random>
+
+#include "test_maps.h"
+
+using pathfinder::CellIndex;
+using pathfinder::GridMap;
+using pathfinder::SearchContext;
+using pathfinder::SearchResult;
+using pathfinder::testing::IsValidPath;
+using pathfinder::testing::MakeRandomMap;
+
+TEST_CASE("Test FindBidirectionalPath") {
+  std::vector<CellIndex> path;
+
+  // Every section runs with the backward direction on the same thread and
+  // then on its own thread
+  const bool kConcurrent[] = {false, true};
+
+  SECTION("Test a path around a wall") {
+    for (bool concurrent : kConcurrent) {
+      // . . # . .
+      // . . # . .
+      // . . . . .
+      GridMap map = GridMap(3, 5);
+      map.SetPassable(map.GetIndex(0, 2), false);
+      map.SetPassable(map.GetIndex(1, 2), false);
+      SearchContext forward = SearchContext(map);
+      SearchContext backward = SearchContext(map);
+      CellIndex start = map.GetIndex(0, 0);
+      CellIndex goal = map.GetIndex(0, 4);
+
+      SearchResult result = pathfinder::FindBidirectionalPath(
+          forward, backward, start, goal, path, concurrent);
+      REQUIRE(result.found);
+      REQUIRE(result.cost == 8);
+      REQUIRE(result.path_length == 9);
+      REQUIRE(IsValidPath(map, path, start, goal));
+    }
+  }
+
+  SECTION("Test that the start and goal can be the same cell") {
+    for (bool concurrent : kConcurrent) {
+      GridMap map = GridMap(4, 4);
+      SearchContext forward = SearchContext(map);
+      SearchContext backward = SearchContext(map);
+      CellIndex cell = map.GetIndex(2, 1);
+      SearchResult result = pathfinder::FindBidirectionalPath(
+          forward, backward, cell, cell, path, concurrent);
+      REQUIRE(result.found);
+      REQUIRE(result.cost == 0);
+      REQUIRE(path == std::vector<CellIndex>{cell});
+    }
+  }
+
+  SECTION("Test that a walled off goal is not found") {
+    for (bool concurrent : kConcurrent) {
+      // . # .
+      // # . .
+      GridMap map = GridMap(2, 3);
+      map.SetPassable(map.GetIndex(0, 1), false);
+      map.SetPassable(map.GetIndex(1, 0), false);
+      SearchContext forward = SearchContext(map);
+      SearchContext backward = SearchContext(map);
+      SearchResult result = pathfinder::FindBidirectionalPath(
+          forward, backward, map.GetIndex(1, 2), map.GetIndex(0, 0), path,
+          concurrent);
+      REQUIRE(!result.found);
+      REQUIRE(path.empty());
+    }
+  }
+
+  SECTION("Test that paths cost the same as A* on random maps") {
+    for (bool concurrent : kConcurrent) {
+      for (unsigned seed = 0; seed < 20; seed++) {
+        GridMap map = MakeRandomMap(24, 31, 0.1 + 0.02 * seed, seed);
+        SearchContext forward = SearchContext(map);
+        SearchContext backward = SearchContext(map);
+        std::vector<CellIndex> a_star_path;
+
+        std::mt19937 random(seed);
+        std::uniform_int_distribution<CellIndex> cell(0, map.GetNumCells() - 1);
+        for (int query = 0; query < 50; query++) {
+          CellIndex start = cell(random);
+          CellIndex goal = cell(random);
+          SearchResult a_star =
+              pathfinder::FindPath(forward, start, goal, a_star_path);
+          SearchResult result = pathfinder::FindBidirectionalPath(
+              forward, backward, start, goal, path, concurrent);
+          REQUIRE(result.found == a_star.found);
+          REQUIRE(result.cost == a_star.cost);
+          REQUIRE(result.path_length == path.size());
+          if (a_star.found) {
+            REQUIRE(IsValidPath(map, path, start, goal));
+          }
+        }
+      }
+    }
+  }
+
+  SECTION("Test that paths cost the same as A* on maps with cell costs") {
+    for (bool concurrent : kConcurrent) {
+      for (unsigned seed = 0; seed < 10; seed++) {
+        GridMap map = MakeRandomMap(24, 31, 0.15, seed);
+        std::mt19937 random(seed);
+        std::uniform_int_distribution<int> terrain(1, 9);
+        for (CellIndex index = 0; index < map.GetNumCells(); index++) {
+          map.SetCost(index, terrain(random));
+        }
+        SearchContext forward = SearchContext(map);
+        SearchContext backward = SearchContext(map);
+        std::vector<CellIndex> a_star_path;
+
+        std::uniform_int_distribution<CellIndex> cell(0, map.GetNumCells() - 1);
+        for (int query = 0; query < 50; query++) {
+          CellIndex start = cell(random);
+          CellIndex goal = cell(random);
+          SearchResult a_star =
+              pathfinder::FindPath(forward, start, goal, a_star_path);
+          SearchResult result = pathfinder::FindBidirectionalPath(
+              forward, backward, start, goal, path, concurrent);
+          REQUIRE(result.found == a_star.found);
+          REQUIRE(result.cost == a_star.cost);
+          if (a_star.found) {
+            REQUIRE(IsValidPath(map, path, start, goal));
+          }
+        }
+      }
+    }
+  }
+}
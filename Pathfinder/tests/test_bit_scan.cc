@@ -0,0 +1,102 @@
+#include <core/bit_scan.h>
+
+#include <catch2/catch.hpp>
+#include <random>
+
+using pathfinder::CellIndex;
+using pathfinder::Direction;
+using pathfinder::GridMap;
+
+namespace {
+
+/**
+ * Helper method that checks whether (row, col) is inside the map and passable
+ */
+bool IsOpen(const GridMap& map, int row, int col) {
+  return map.InBounds(row, col) && map.IsPassable(map.GetIndex(row, col));
+}
+
+/**
+ * Helper method that does what ScanLine does one cell at a time
+ */
+int ScanLineSlowly(const GridMap& map, CellIndex from, Direction direction) {
+  const int kRowSteps[] = {-1, 1, 0, 0};
+  const int kColSteps[] = {0, 0, -1, 1};
+  int row_step = kRowSteps[direction];
+  int col_step = kColSteps[direction];
+  int row = map.GetRow(from);
+  int col = map.GetCol(from);
+  for (int steps = 1;; steps++) {
+    row += row_step;
+    col += col_step;
+    if (!IsOpen(map, row, col)) {
+      return -(steps - 1);
+    }
+
+    // The sides of the line are the cells across from the direction of travel
+    int side_row = col_step;
+    int side_col = row_step;
+    if ((IsOpen(map, row + side_row, col + side_col) &&
+         !IsOpen(map, row + side_row - row_step, col + side_col - col_step)) ||
+        (IsOpen(map, row - side_row, col - side_col) &&
+         !IsOpen(map, row - side_row - row_step, col - side_col - col_step))) {
+      return steps;
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("Test counting zeros") {
+  REQUIRE(pathfinder::CountTrailingZeros(1) == 0);
+  REQUIRE(pathfinder::CountTrailingZeros(0x80) == 7);
+  REQUIRE(pathfinder::CountTrailingZeros((uint64_t)1 << 63) == 63);
+  REQUIRE(pathfinder::CountLeadingZeros(1) == 63);
+  REQUIRE(pathfinder::CountLeadingZeros((uint64_t)1 << 63) == 0);
+}
+
+TEST_CASE("Test ScanLine") {
+  SECTION("Test scanning across an open map") {
+    GridMap map = GridMap(3, 200);
+    CellIndex from = map.GetIndex(1, 10);
+    REQUIRE(pathfinder::ScanLine(map, from, pathfinder::kRight) == -189);
+    REQUIRE(pathfinder::ScanLine(map, from, pathfinder::kLeft) == -10);
+    REQUIRE(pathfinder::ScanLine(map, from, pathfinder::kUp) == -1);
+    REQUIRE(pathfinder::ScanLine(map, from, pathfinder::kDown) == -1);
+  }
+
+  SECTION("Test that a scan stops past the end of a wall") {
+    // A wall above the row from column 100 to 139, so the cell above column
+    // 140 opens up again
+    GridMap map = GridMap(3, 200);
+    for (size_t col = 100; col < 140; col++) {
+      map.SetPassable(map.GetIndex(0, col), false);
+    }
+    CellIndex from = map.GetIndex(1, 10);
+    REQUIRE(pathfinder::ScanLine(map, from, pathfinder::kRight) == 130);
+    REQUIRE(pathfinder::ScanLine(map, map.GetIndex(1, 199),
+                                 pathfinder::kLeft) == 100);
+  }
+
+  SECTION("Test that scans match a cell by cell scan on random maps") {
+    std::mt19937 random(7);
+    for (int trial = 0; trial < 20; trial++) {
+      size_t num_rows = 1 + random() % 150;
+      size_t num_cols = 1 + random() % 150;
+      GridMap map = GridMap(num_rows, num_cols);
+      std::bernoulli_distribution is_wall(0.02 * (trial % 10));
+      for (CellIndex index = 0; index < map.GetNumCells(); index++) {
+        if (is_wall(random)) {
+          map.SetPassable(index, false);
+        }
+      }
+
+      for (CellIndex index = 0; index < map.GetNumCells(); index++) {
+        for (int direction = 0; direction < 4; direction++) {
+          REQUIRE(pathfinder::ScanLine(map, index, (Direction)direction) ==
+                  ScanLineSlowly(map, index, (Direction)direction));
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,83 @@
+#include <core/bucket_queue.h>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Test BucketQueue") {
+  pathfinder::BucketQueue queue;
+  queue.Reset(16, 5);
+
+  SECTION("Test that a new queue is empty") {
+    REQUIRE(queue.Empty());
+    REQUIRE(queue.Size() == 0);
+  }
+
+  SECTION("Test that cells come out in order of F cost") {
+    queue.Push(3, 7, 1);
+    queue.Push(5, 4, 1);
+    queue.Push(9, 6, 1);
+    REQUIRE(queue.Size() == 3);
+    REQUIRE(queue.Pop() == 5);
+    REQUIRE(queue.Pop() == 9);
+    REQUIRE(queue.Pop() == 3);
+    REQUIRE(queue.Empty());
+  }
+
+  SECTION("Test that ties on F cost go to the cell pushed last") {
+    queue.Push(1, 6, 4);
+    queue.Push(2, 6, 2);
+    queue.Push(3, 6, 3);
+    REQUIRE(queue.Pop() == 3);
+    REQUIRE(queue.Pop() == 2);
+    REQUIRE(queue.Pop() == 1);
+  }
+
+  SECTION("Test that DecreaseKey moves a cell to the front") {
+    queue.Push(1, 5, 1);
+    queue.Push(2, 6, 1);
+    queue.Push(3, 8, 1);
+    queue.DecreaseKey(3, 4, 1);
+    REQUIRE(queue.Size() == 3);
+    REQUIRE(queue.Pop() == 3);
+    REQUIRE(queue.Pop() == 1);
+    REQUIRE(queue.Pop() == 2);
+  }
+
+  SECTION("Test that DecreaseKey can unlink a cell from the middle of a "
+          "bucket") {
+    queue.Push(1, 7, 1);
+    queue.Push(2, 7, 1);
+    queue.Push(3, 7, 1);
+    queue.DecreaseKey(2, 6, 1);
+    REQUIRE(queue.Pop() == 2);
+    REQUIRE(queue.Pop() == 3);
+    REQUIRE(queue.Pop() == 1);
+  }
+
+  SECTION("Test that the buckets are reused as the F cost goes up") {
+    // A spread of 5 needs 8 buckets, so F costs up to 60 wrap around the
+    // ring several times. Each cell is pushed 4 above the one popped before
+    // it, as A* would with a step cost of 3.
+    queue.Push(0, 0, 0);
+    for (pathfinder::CellIndex index = 1; index < 16; index++) {
+      REQUIRE(queue.Pop() == index - 1);
+      queue.Push(index, 4 * (int)index + 1, 0);
+      queue.Push(index - 1, 4 * (int)index + 2, 0);
+      queue.DecreaseKey(index, 4 * (int)index, 0);
+      REQUIRE(queue.Size() == 2);
+      REQUIRE(queue.Pop() == index);
+      REQUIRE(queue.Pop() == index - 1);
+      queue.Push(index, 4 * (int)index, 0);
+    }
+    REQUIRE(queue.Pop() == 15);
+    REQUIRE(queue.Empty());
+  }
+
+  SECTION("Test that Reset empties the queue") {
+    queue.Push(1, 5, 1);
+    queue.Push(2, 6, 1);
+    queue.Reset(16, 5);
+    REQUIRE(queue.Empty());
+    queue.Push(2, 9, 1);
+    REQUIRE(queue.Pop() == 2);
+  }
+}
@@ -0,0 +1,260 @@
+#include <core/connectivity.h>
+#include <core/search.h>
+
+#include <catch2/catch.hpp>
+#include <functional>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+using pathfinder::CellIndex;
+using pathfinder::CornerCutting;
+using pathfinder::EightConnected;
+using pathfinder::FourConnected;
+using pathfinder::GridMap;
+using pathfinder::SearchContext;
+using pathfinder::SearchResult;
+
+namespace {
+
+/**
+ * Helper method that collects the neighbors a connectivity policy visits
+ */
+template <typename Connectivity>
+std::vector<std::pair<CellIndex, int>> GetNeighbors(const GridMap& map,
+                                                    CellIndex current) {
+  std::vector<std::pair<CellIndex, int>> neighbors;
+  Connectivity::ForEachNeighbor(
+      map, current, [&neighbors](CellIndex neighbor, int step_cost) {
+        neighbors.push_back(std::make_pair(neighbor, step_cost));
+      });
+  return neighbors;
+}
+
+/**
+ * Helper method that finds the cheapest cost between two cells with
+ * Dijkstra's algorithm, to check A* against
+ * @return The cost, or -1 if there is no path
+ */
+template <typename Connectivity>
+int FindCheapestCost(const GridMap& map, CellIndex start, CellIndex goal) {
+  if (!map.IsPassable(start) || !map.IsPassable(goal)) {
+    return -1;
+  }
+  typedef std::pair<int, CellIndex> Entry;
+  std::vector<int> costs(map.GetNumCells(), -1);
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  costs[start] = 0;
+  queue.push(Entry(0, start));
+  while (!queue.empty()) {
+    Entry entry = queue.top();
+    queue.pop();
+    if (entry.first != costs[entry.second]) {
+      continue;
+    }
+    Connectivity::ForEachNeighbor(
+        map, entry.second, [&](CellIndex neighbor, int step_cost) {
+          int cost = entry.first + step_cost * map.GetCost(neighbor);
+          if (costs[neighbor] == -1 || cost < costs[neighbor]) {
+            costs[neighbor] = cost;
+            queue.push(Entry(cost, neighbor));
+          }
+        });
+  }
+  return costs[goal];
+}
+
+/**
+ * Helper method that adds up what each step of a path costs, or returns -1
+ * if a step isn't one the connectivity policy allows
+ */
+template <typename Connectivity>
+int GetPathCost(const GridMap& map, const std::vector<CellIndex>& path) {
+  int cost = 0;
+  for (size_t i = 1; i < path.size(); i++) {
+    int step_cost = -1;
+    for (const std::pair<CellIndex, int>& neighbor :
+         GetNeighbors<Connectivity>(map, path[i - 1])) {
+      if (neighbor.first == path[i]) {
+        step_cost = neighbor.second;
+      }
+    }
+    if (step_cost == -1) {
+      return -1;
+    }
+    cost += step_cost * map.GetCost(path[i]);
+  }
+  return cost;
+}
+
+/**
+ * Helper method that checks A* with a connectivity policy finds the
+ * cheapest path between random cells of random maps
+ */
+template <typename Connectivity>
+void CheckAgainstDijkstra() {
+  std::vector<CellIndex> path;
+  std::mt19937 random(7);
+  for (int trial = 0; trial < 8; trial++) {
+    GridMap map = GridMap(19, 26);
+    std::bernoulli_distribution is_wall(0.1 + 0.04 * trial);
+    std::uniform_int_distribution<int> terrain(1, trial < 4 ? 1 : 9);
+    for (CellIndex index = 0; index < map.GetNumCells(); index++) {
+      map.SetPassable(index, !is_wall(random));
+      map.SetCost(index, terrain(random));
+    }
+    SearchContext context = SearchContext(map);
+
+    std::uniform_int_distribution<CellIndex> cell(0, map.GetNumCells() - 1);
+    for (int query = 0; query < 40; query++) {
+      CellIndex start = cell(random);
+      CellIndex goal = cell(random);
+      SearchResult result =
+          pathfinder::FindPath<Connectivity>(context, start, goal, path);
+      int expected = FindCheapestCost<Connectivity>(map, start, goal);
+      REQUIRE(result.found == (expected != -1));
+      if (result.found) {
+        REQUIRE(result.cost == expected);
+        REQUIRE(path.front() == start);
+        REQUIRE(path.back() == goal);
+        REQUIRE(GetPathCost<Connectivity>(map, path) == expected);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("Test FourConnected") {
+  // . . .
+  // . . #
+  // . . .
+  GridMap map = GridMap(3, 3);
+  map.SetPassable(map.GetIndex(1, 2), false);
+
+  SECTION("Test that only open cells sharing an edge are visited") {
+    std::vector<std::pair<CellIndex, int>> neighbors =
+        GetNeighbors<FourConnected>(map, map.GetIndex(1, 1));
+    REQUIRE(neighbors.size() == 3);
+    REQUIRE(neighbors[0].first == map.GetIndex(0, 1));
+    REQUIRE(neighbors[1].first == map.GetIndex(1, 0));
+    REQUIRE(neighbors[2].first == map.GetIndex(2, 1));
+    REQUIRE(neighbors[0].second == 1);
+  }
+
+  SECTION("Test that cells off the map are not visited") {
+    REQUIRE(GetNeighbors<FourConnected>(map, map.GetIndex(0, 0)).size() == 2);
+    REQUIRE(GetNeighbors<FourConnected>(map, map.GetIndex(2, 2)).size() == 1);
+  }
+
+  SECTION("Test the Manhattan distance") {
+    REQUIRE(FourConnected::Distance(map, map.GetIndex(0, 0),
+                                    map.GetIndex(2, 1)) == 3);
+  }
+
+  SECTION("Test that it is the same search as FindPath") {
+    SearchContext context = SearchContext(map);
+    std::vector<CellIndex> path;
+    std::vector<CellIndex> four_path;
+    SearchResult result = pathfinder::FindPath(context, map.GetIndex(0, 2),
+                                               map.GetIndex(2, 2), path);
+    SearchResult four = pathfinder::FindPath<FourConnected>(
+        context, map.GetIndex(0, 2), map.GetIndex(2, 2), four_path);
+    REQUIRE(four.cost == result.cost);
+    REQUIRE(four.num_expanded == result.num_expanded);
+    REQUIRE(four_path == path);
+  }
+}
+
+TEST_CASE("Test EightConnected") {
+  typedef EightConnected<CornerCutting::kAlways> Always;
+  typedef EightConnected<CornerCutting::kOneSideOpen> OneSideOpen;
+  typedef EightConnected<CornerCutting::kNever> Never;
+
+  SECTION("Test that every open cell around is visited in row-major order") {
+    GridMap map = GridMap(3, 3);
+    std::vector<std::pair<CellIndex, int>> neighbors =
+        GetNeighbors<Never>(map, map.GetIndex(1, 1));
+    REQUIRE(neighbors.size() == 8);
+    for (size_t i = 0; i < neighbors.size(); i++) {
+      CellIndex expected = (CellIndex)(i < 4 ? i : i + 1);
+      REQUIRE(neighbors[i].first == expected);
+      REQUIRE(neighbors[i].second == (expected % 2 == 0 ? 7 : 5));
+    }
+    REQUIRE(GetNeighbors<Never>(map, map.GetIndex(0, 0)).size() == 3);
+  }
+
+  SECTION("Test corner cutting past one wall") {
+    // # .
+    // . .
+    GridMap map = GridMap(2, 2);
+    map.SetPassable(map.GetIndex(0, 0), false);
+    CellIndex current = map.GetIndex(1, 0);
+    REQUIRE(GetNeighbors<Always>(map, current).size() == 2);
+    REQUIRE(GetNeighbors<OneSideOpen>(map, current).size() == 2);
+    REQUIRE(GetNeighbors<Never>(map, current).size() == 1);
+  }
+
+  SECTION("Test squeezing between two walls") {
+    // . #
+    // # .
+    GridMap map = GridMap(2, 2);
+    map.SetPassable(map.GetIndex(0, 1), false);
+    map.SetPassable(map.GetIndex(1, 0), false);
+    CellIndex current = map.GetIndex(0, 0);
+    REQUIRE(GetNeighbors<Always>(map, current).size() == 1);
+    REQUIRE(GetNeighbors<OneSideOpen>(map, current).empty());
+    REQUIRE(GetNeighbors<Never>(map, current).empty());
+  }
+
+  SECTION("Test the octile distance") {
+    GridMap map = GridMap(10, 10);
+    REQUIRE(Never::Distance(map, map.GetIndex(1, 2), map.GetIndex(4, 7)) ==
+            3 * 7 + 2 * 5);
+    REQUIRE(Never::Distance(map, map.GetIndex(4, 7), map.GetIndex(1, 2)) ==
+            31);
+  }
+
+  SECTION("Test that an open map is crossed diagonally") {
+    GridMap map = GridMap(20, 30);
+    SearchContext context = SearchContext(map);
+    std::vector<CellIndex> path;
+    SearchResult result = pathfinder::FindPath<Never>(
+        context, map.GetIndex(0, 0), map.GetIndex(19, 29), path);
+    REQUIRE(result.found);
+    REQUIRE(result.cost == 19 * 7 + 10 * 5);
+    REQUIRE(path.size() == 30);
+
+    // The octile distance is exact on an open map, so only the path is
+    // expanded
+    REQUIRE(result.num_expanded == 29);
+  }
+
+  SECTION("Test that corner cutting shortens the path past a wall") {
+    // . . # . .
+    // . . . . .
+    GridMap map = GridMap(2, 5);
+    map.SetPassable(map.GetIndex(0, 2), false);
+    SearchContext context = SearchContext(map);
+    std::vector<CellIndex> path;
+    CellIndex start = map.GetIndex(0, 1);
+    CellIndex goal = map.GetIndex(0, 3);
+
+    // Two diagonal steps around the corner, or four straight ones
+    REQUIRE(pathfinder::FindPath<Always>(context, start, goal, path).cost ==
+            14);
+    REQUIRE(pathfinder::FindPath<OneSideOpen>(context, start, goal, path)
+                .cost == 14);
+    REQUIRE(pathfinder::FindPath<Never>(context, start, goal, path).cost ==
+            20);
+    REQUIRE(path.size() == 5);
+  }
+
+  SECTION("Test that paths are the cheapest on random maps") {
+    CheckAgainstDijkstra<FourConnected>();
+    CheckAgainstDijkstra<Always>();
+    CheckAgainstDijkstra<OneSideOpen>();
+    CheckAgainstDijkstra<Never>();
+  }
+}
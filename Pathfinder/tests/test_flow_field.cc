@@ -0,0 +1,134 @@
+#include <core/flow_field.h>
+#include <core/search.h>
+
+#include <catch2/catch.hpp>
+#include <random>
+
+#include "test_maps.h"
+
+using pathfinder::CellIndex;
+using pathfinder::FlowField;
+using pathfinder::GridMap;
+using pathfinder::SearchContext;
+using pathfinder::SearchResult;
+using pathfinder::testing::MakeRandomMap;
+
+TEST_CASE("Test FlowField") {
+  std::vector<CellIndex> path;
+
+  // Every section runs on the calling thread alone and then on a pool
+  const size_t kNumThreads[] = {1, 3};
+
+  SECTION("Test distances and steps around a wall") {
+    for (size_t num_threads : kNumThreads) {
+      // . . # . .
+      // . . # . .
+      // . . . . .
+      GridMap map = GridMap(3, 5);
+      map.SetPassable(map.GetIndex(0, 2), false);
+      map.SetPassable(map.GetIndex(1, 2), false);
+      FlowField field(num_threads);
+      REQUIRE(field.GetNumThreads() == num_threads);
+      CellIndex goal = map.GetIndex(0, 4);
+      field.Build(map, {goal});
+
+      REQUIRE(field.GetDistance(goal) == 0);
+      REQUIRE(field.GetDistance(map.GetIndex(0, 0)) == 8);
+      REQUIRE(field.GetDistance(map.GetIndex(0, 2)) == -1);
+      REQUIRE(field.GetMaxDistance() == 8);
+      REQUIRE(field.GetNextCell(goal) == pathfinder::kNoCell);
+      REQUIRE(field.GetNextCell(map.GetIndex(0, 2)) == pathfinder::kNoCell);
+      REQUIRE(field.GetNextCell(map.GetIndex(1, 1)) == map.GetIndex(2, 1));
+
+      field.GetPath(map.GetIndex(0, 0), path);
+      REQUIRE(path.size() == 9);
+      REQUIRE(path.front() == map.GetIndex(0, 0));
+      REQUIRE(path.back() == goal);
+    }
+  }
+
+  SECTION("Test cells that can't reach a goal") {
+    for (size_t num_threads : kNumThreads) {
+      // . # .
+      // # . .
+      GridMap map = GridMap(2, 3);
+      map.SetPassable(map.GetIndex(0, 1), false);
+      map.SetPassable(map.GetIndex(1, 0), false);
+      FlowField field(num_threads);
+      field.Build(map, {map.GetIndex(1, 2)});
+      REQUIRE(field.GetDistance(map.GetIndex(0, 0)) == -1);
+      REQUIRE(field.GetNextCell(map.GetIndex(0, 0)) == pathfinder::kNoCell);
+      field.GetPath(map.GetIndex(0, 0), path);
+      REQUIRE(path.empty());
+
+      // A goal on a wall leads nowhere
+      field.Build(map, {map.GetIndex(0, 1)});
+      REQUIRE(field.GetMaxDistance() == -1);
+      REQUIRE(field.GetDistance(map.GetIndex(1, 1)) == -1);
+    }
+  }
+
+  SECTION("Test distances match A* from the nearest goal") {
+    for (size_t num_threads : kNumThreads) {
+      for (unsigned seed = 0; seed < 5; seed++) {
+        GridMap map = MakeRandomMap(23, 29, 0.1 + 0.05 * seed, seed);
+        SearchContext context = SearchContext(map);
+        FlowField field(num_threads);
+
+        std::mt19937 random(seed);
+        std::uniform_int_distribution<CellIndex> cell(0, map.GetNumCells() - 1);
+        std::vector<CellIndex> goals = {cell(random), cell(random),
+                                        cell(random)};
+        field.Build(map, goals);
+
+        for (CellIndex index = 0; index < map.GetNumCells(); index++) {
+          int nearest = -1;
+          for (CellIndex goal : goals) {
+            SearchResult result =
+                pathfinder::FindPath(context, index, goal, path);
+            if (result.found && (nearest == -1 || result.cost < nearest)) {
+              nearest = result.cost;
+            }
+          }
+          REQUIRE(field.GetDistance(index) == nearest);
+
+          // Every step leads to an open neighbor one step closer
+          CellIndex next = field.GetNextCell(index);
+          if (nearest > 0) {
+            REQUIRE(next != pathfinder::kNoCell);
+            REQUIRE(map.IsPassable(next));
+            REQUIRE(pathfinder::ManhattanDistance(map, index, next) == 1);
+            REQUIRE(field.GetDistance(next) == nearest - 1);
+          } else {
+            REQUIRE(next == pathfinder::kNoCell);
+          }
+        }
+      }
+    }
+  }
+
+  SECTION("Test large levels give the same field on any number of threads") {
+    GridMap map = MakeRandomMap(300, 300, 0.2, 11);
+    std::mt19937 random(11);
+    std::uniform_int_distribution<CellIndex> cell(0, map.GetNumCells() - 1);
+    std::vector<CellIndex> goals;
+    for (int goal = 0; goal < 200; goal++) {
+      goals.push_back(cell(random));
+    }
+
+    FlowField single(1);
+    single.Build(map, goals);
+    for (size_t num_threads : {2, 4}) {
+      FlowField field(num_threads);
+
+      // Building twice checks the field is cleared in between
+      field.Build(map, {0});
+      field.Build(map, goals);
+      REQUIRE(field.GetMaxDistance() == single.GetMaxDistance());
+      for (CellIndex index = 0; index < map.GetNumCells(); index++) {
+        REQUIRE(field.GetDistance(index) == single.GetDistance(index));
+        REQUIRE(field.GetNextCell(index) == single.GetNextCell(index));
+      }
+    }
+  }
+}
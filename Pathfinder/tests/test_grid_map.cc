@@ -0,0 +1,127 @@
+#include <core/grid_map.h>
+#include <core/pathfinder.h>
+
+#include <catch2/catch.hpp>
+#include <vector>
+
+TEST_CASE("Test GridMap") {
+  pathfinder::GridMap map = pathfinder::GridMap(3, 70);
+
+  SECTION("Test dimensions") {
+    REQUIRE(map.GetNumRows() == 3);
+    REQUIRE(map.GetNumCols() == 70);
+    REQUIRE(map.GetNumCells() == 210);
+  }
+
+  SECTION("Test converting between positions and indices") {
+    pathfinder::CellIndex index = map.GetIndex(2, 65);
+    REQUIRE(index == 205);
+    REQUIRE(map.GetRow(index) == 2);
+    REQUIRE(map.GetCol(index) == 65);
+  }
+
+  SECTION("Test bounds checking") {
+    REQUIRE(map.InBounds(0, 0));
+    REQUIRE(map.InBounds(2, 69));
+    REQUIRE(!map.InBounds(-1, 0));
+    REQUIRE(!map.InBounds(3, 0));
+    REQUIRE(!map.InBounds(0, 70));
+  }
+
+  SECTION("Test that a new map is passable everywhere") {
+    for (pathfinder::CellIndex index = 0; index < map.GetNumCells(); index++) {
+      REQUIRE(map.IsPassable(index));
+    }
+  }
+
+  SECTION("Test setting walls across word boundaries") {
+    map.SetPassable(63, false);
+    map.SetPassable(64, false);
+    REQUIRE(!map.IsPassable(63));
+    REQUIRE(!map.IsPassable(64));
+    REQUIRE(map.IsPassable(62));
+    REQUIRE(map.IsPassable(65));
+
+    map.SetPassable(63, true);
+    REQUIRE(map.IsPassable(63));
+
+    map.Clear();
+    REQUIRE(map.IsPassable(64));
+  }
+
+  SECTION("Test cell costs") {
+    REQUIRE(map.GetCost(5) == 1);
+    REQUIRE(map.HasUniformCosts());
+
+    map.SetCost(5, 7);
+    REQUIRE(map.GetCost(5) == 7);
+    REQUIRE(map.GetCost(6) == 1);
+    REQUIRE(map.GetMaxCost() == 7);
+    REQUIRE(!map.HasUniformCosts());
+
+    // Costs are clamped, since every step has to cost something
+    map.SetCost(6, 0);
+    map.SetCost(7, 1000);
+    REQUIRE(map.GetCost(6) == 1);
+    REQUIRE(map.GetCost(7) == pathfinder::GridMap::kMaxCost);
+
+    map.Clear();
+    REQUIRE(map.GetCost(5) == 1);
+    REQUIRE(map.HasUniformCosts());
+  }
+
+  SECTION("Test reading a row 64 cells at a time") {
+    map.SetPassable(map.GetIndex(1, 3), false);
+    map.SetPassable(map.GetIndex(1, 66), false);
+
+    // Bit i is (1, first_col + i), and cells off the row read as walls
+    uint64_t bits = map.GetRowBits(1, 3);
+    REQUIRE((bits & 1) == 0);
+    REQUIRE(((bits >> 1) & 1) == 1);
+    REQUIRE(((bits >> 62) & 1) == 1);
+    REQUIRE(((bits >> 63) & 1) == 0);
+
+    bits = map.GetRowBits(1, 60);
+    REQUIRE(bits == 0x3BF);
+
+    bits = map.GetRowBits(1, -2);
+    REQUIRE((bits & 3) == 0);
+    REQUIRE(((bits >> 2) & 1) == 1);
+    REQUIRE(((bits >> 5) & 1) == 0);
+
+    REQUIRE(map.GetRowBits(-1, 0) == 0);
+    REQUIRE(map.GetRowBits(3, 0) == 0);
+    REQUIRE(map.GetRowBits(1, 70) == 0);
+    REQUIRE(map.GetRowBits(1, -64) == 0);
+  }
+
+  SECTION("Test reading a column 64 cells at a time") {
+    map.SetPassable(map.GetIndex(1, 65), false);
+    REQUIRE(map.GetColumnBits(65, 0) == 5);
+    REQUIRE(map.GetColumnBits(65, -1) == 10);
+    REQUIRE(map.GetColumnBits(64, 1) == 3);
+    REQUIRE(map.GetColumnBits(70, 0) == 0);
+
+    map.Clear();
+    REQUIRE(map.GetColumnBits(65, 0) == 7);
+  }
+
+  SECTION("Test building a map from cells") {
+    std::vector<std::vector<pathfinder::Cell>> cells;
+    cells.resize(2);
+    for (size_t row = 0; row < 2; row++) {
+      for (size_t col = 0; col < 3; col++) {
+        cells[row].push_back(
+            pathfinder::Cell(pathfinder::CellType::kEmpty, row, col));
+      }
+    }
+    cells[1][2].SetType(pathfinder::CellType::kWall);
+    cells[0][0].SetType(pathfinder::CellType::kStart);
+
+    pathfinder::GridMap cell_map = pathfinder::MakeGridMap(cells);
+    REQUIRE(cell_map.GetNumRows() == 2);
+    REQUIRE(cell_map.GetNumCols() == 3);
+    REQUIRE(!cell_map.IsPassable(cell_map.GetIndex(1, 2)));
+    REQUIRE(cell_map.IsPassable(cell_map.GetIndex(0, 0)));
+  }
+}
@@ -0,0 +1,141 @@
+#include <core/hierarchical_map.h>
+
+#include <catch2/catch.hpp>
+#include <random>
+
+#include "test_maps.h"
+
+using pathfinder::CellIndex;
+using pathfinder::GridMap;
+using pathfinder::HierarchicalMap;
+using pathfinder::SearchContext;
+using pathfinder::SearchResult;
+using pathfinder::testing::IsValidPath;
+using pathfinder::testing::MakeRandomMap;
+
+TEST_CASE("Test HierarchicalMap") {
+  std::vector<CellIndex> path;
+
+  SECTION("Test splitting the map into clusters") {
+    GridMap map = GridMap(40, 70);
+    HierarchicalMap hierarchy = HierarchicalMap(map, 16);
+    REQUIRE(hierarchy.GetClusterSize() == 16);
+    REQUIRE(hierarchy.GetNumClusters() == 15);
+    REQUIRE(hierarchy.GetNumRebuiltClusters() == 15);
+
+    // Every open border gets an entrance at each end, on both sides
+    REQUIRE(hierarchy.GetNumEntrances() > 0);
+  }
+
+  SECTION("Test that paths on an open map are as short as possible") {
+    GridMap map = GridMap(64, 64);
+    HierarchicalMap hierarchy = HierarchicalMap(map, 16);
+    CellIndex start = map.GetIndex(3, 2);
+    CellIndex goal = map.GetIndex(60, 61);
+    SearchResult result = hierarchy.FindPath(start, goal, path);
+    REQUIRE(result.found);
+    REQUIRE(result.cost == 57 + 59);
+    REQUIRE(result.path_length == path.size());
+    REQUIRE(IsValidPath(map, path, start, goal));
+  }
+
+  SECTION("Test queries inside a single cluster") {
+    GridMap map = GridMap(32, 32);
+    HierarchicalMap hierarchy = HierarchicalMap(map, 16);
+    CellIndex start = map.GetIndex(2, 2);
+    CellIndex goal = map.GetIndex(5, 9);
+    SearchResult result = hierarchy.FindPath(start, goal, path);
+    REQUIRE(result.found);
+    REQUIRE(result.cost == 10);
+    REQUIRE(IsValidPath(map, path, start, goal));
+
+    result = hierarchy.FindPath(start, start, path);
+    REQUIRE(result.found);
+    REQUIRE(result.cost == 0);
+    REQUIRE(path.size() == 1);
+  }
+
+  SECTION("Test that a walled off goal is not found") {
+    GridMap map = GridMap(32, 32);
+    for (size_t col = 0; col < 32; col++) {
+      map.SetPassable(map.GetIndex(20, col), false);
+    }
+    HierarchicalMap hierarchy = HierarchicalMap(map, 8);
+    SearchResult result =
+        hierarchy.FindPath(map.GetIndex(0, 0), map.GetIndex(31, 31), path);
+    REQUIRE(!result.found);
+    REQUIRE(path.empty());
+
+    result =
+        hierarchy.FindPath(map.GetIndex(0, 0), map.GetIndex(20, 3), path);
+    REQUIRE(!result.found);
+  }
+
+  SECTION("Test that paths are found wherever A* finds one") {
+    for (unsigned seed = 0; seed < 10; seed++) {
+      GridMap map = MakeRandomMap(45, 61, 0.05 + 0.03 * seed, seed);
+      HierarchicalMap hierarchy = HierarchicalMap(map, 4 + seed);
+      SearchContext context = SearchContext(map);
+
+      std::mt19937 random(seed);
+      std::uniform_int_distribution<CellIndex> cell(0, map.GetNumCells() - 1);
+      for (int query = 0; query < 50; query++) {
+        CellIndex start = cell(random);
+        CellIndex goal = cell(random);
+        SearchResult a_star = pathfinder::FindPath(
+            context, start, goal, context.GetPathBuffer());
+        SearchResult result = hierarchy.FindPath(start, goal, path);
+        REQUIRE(result.found == a_star.found);
+        if (a_star.found) {
+          REQUIRE(result.cost >= a_star.cost);
+          REQUIRE(result.path_length == (size_t)result.cost + 1);
+          REQUIRE(IsValidPath(map, path, start, goal));
+        }
+      }
+    }
+  }
+
+  SECTION("Test that updating cells matches rebuilding the whole map") {
+    GridMap map = MakeRandomMap(48, 48, 0.2, 3);
+    HierarchicalMap hierarchy = HierarchicalMap(map, 8);
+
+    SECTION("Test a cell inside a cluster") {
+      CellIndex cell = map.GetIndex(19, 11);
+      map.SetPassable(cell, !map.IsPassable(cell));
+      hierarchy.UpdateCells(std::vector<CellIndex>(1, cell));
+      REQUIRE(hierarchy.GetNumRebuiltClusters() == 1);
+    }
+
+    SECTION("Test a cell on the corner of four clusters") {
+      CellIndex cell = map.GetIndex(23, 24);
+      map.SetPassable(cell, !map.IsPassable(cell));
+      hierarchy.UpdateCells(std::vector<CellIndex>(1, cell));
+      REQUIRE(hierarchy.GetNumRebuiltClusters() == 3);
+    }
+
+    SECTION("Test a line of walls across many clusters") {
+      std::vector<CellIndex> cells;
+      for (size_t row = 0; row < 47; row++) {
+        cells.push_back(map.GetIndex(row, 30));
+        map.SetPassable(cells.back(), false);
+      }
+      hierarchy.UpdateCells(cells);
+      REQUIRE(hierarchy.GetNumRebuiltClusters() == 6);
+    }
+
+    HierarchicalMap rebuilt = HierarchicalMap(map, 8);
+    REQUIRE(hierarchy.GetNumEntrances() == rebuilt.GetNumEntrances());
+    std::vector<CellIndex> rebuilt_path;
+    std::mt19937 random(11);
+    std::uniform_int_distribution<CellIndex> cell(0, map.GetNumCells() - 1);
+    for (int query = 0; query < 200; query++) {
+      CellIndex start = cell(random);
+      CellIndex goal = cell(random);
+      SearchResult result = hierarchy.FindPath(start, goal, path);
+      SearchResult expected = rebuilt.FindPath(start, goal, rebuilt_path);
+      REQUIRE(result.found == expected.found);
+      REQUIRE(result.cost == expected.cost);
+      REQUIRE(path == rebuilt_path);
+    }
+  }
+}
@@ -0,0 +1,199 @@
+#include <core/jump_point_search.h>
+
+#include <catch2/catch.hpp>
+#include <random>
+
+#include "test_maps.h"
+
+using pathfinder::CellIndex;
+using pathfinder::GridMap;
+using pathfinder::SearchContext;
+using pathfinder::SearchResult;
+using pathfinder::testing::MakeRandomMap;
+
+namespace {
+
+/**
+ * Helper method that checks a path is made of open cells that share an edge
+ */
+bool IsConnectedPath(const GridMap& map, const std::vector<CellIndex>& path) {
+  for (size_t i = 0; i < path.size(); i++) {
+    if (!map.IsPassable(path[i])) {
+      return false;
+    }
+    if (i > 0 &&
+        pathfinder::ManhattanDistance(map, path[i - 1], path[i]) != 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST_CASE("Test Jump") {
+  // . . . . .
+  // . . # . .
+  // . . . . .
+  GridMap map = GridMap(3, 5);
+  map.SetPassable(map.GetIndex(1, 2), false);
+  pathfinder::JumpTable table;
+  table.Build(map);
+  CellIndex goal = map.GetIndex(0, 4);
+
+  SECTION("Test that a jump stops beside a wall corner") {
+    // Moving right along the bottom row, (2, 3) opens up above the wall
+    CellIndex from = map.GetIndex(2, 0);
+    REQUIRE(pathfinder::Jump(map, from, pathfinder::kRight, goal) ==
+            map.GetIndex(2, 3));
+    REQUIRE(pathfinder::Jump(map, table, from, pathfinder::kRight, goal) ==
+            map.GetIndex(2, 3));
+    REQUIRE(table.GetDistance(from, pathfinder::kRight) == 3);
+  }
+
+  SECTION("Test that a jump stops at the goal") {
+    // The goal comes before the wall corner at (2, 3)
+    CellIndex from = map.GetIndex(2, 0);
+    CellIndex near_goal = map.GetIndex(2, 2);
+    REQUIRE(pathfinder::Jump(map, from, pathfinder::kRight, near_goal) ==
+            near_goal);
+    REQUIRE(pathfinder::Jump(map, table, from, pathfinder::kRight,
+                             near_goal) == near_goal);
+  }
+
+  SECTION("Test that a jump into the edge of the map finds nothing") {
+    CellIndex from = map.GetIndex(1, 4);
+    REQUIRE(pathfinder::Jump(map, from, pathfinder::kRight, goal) ==
+            pathfinder::kNoCell);
+    REQUIRE(pathfinder::Jump(map, table, from, pathfinder::kRight, goal) ==
+            pathfinder::kNoCell);
+    REQUIRE(table.GetDistance(from, pathfinder::kRight) == 0);
+  }
+
+  SECTION("Test that a vertical jump stops where it can turn to the goal") {
+    CellIndex from = map.GetIndex(2, 4);
+    REQUIRE(pathfinder::Jump(map, from, pathfinder::kUp, goal) == goal);
+    REQUIRE(pathfinder::Jump(map, table, from, pathfinder::kUp, goal) == goal);
+
+    from = map.GetIndex(2, 0);
+    REQUIRE(pathfinder::Jump(map, from, pathfinder::kUp, goal) ==
+            map.GetIndex(0, 0));
+    REQUIRE(pathfinder::Jump(map, table, from, pathfinder::kUp, goal) ==
+            map.GetIndex(0, 0));
+  }
+}
+
+TEST_CASE("Test FindJumpPointPath") {
+  std::vector<CellIndex> path;
+
+  SECTION("Test that an open map needs few expansions") {
+    GridMap map = GridMap(64, 64);
+    SearchContext context = SearchContext(map);
+    CellIndex start = map.GetIndex(0, 0);
+    CellIndex goal = map.GetIndex(63, 63);
+
+    SearchResult a_star = pathfinder::FindPath(context, start, goal, path);
+    SearchResult jump =
+        pathfinder::FindJumpPointPath(context, start, goal, path);
+    REQUIRE(jump.found);
+    REQUIRE(jump.cost == a_star.cost);
+    REQUIRE(jump.path_length == 127);
+    REQUIRE(path.size() == 127);
+    REQUIRE(path.front() == start);
+    REQUIRE(path.back() == goal);
+    REQUIRE(IsConnectedPath(map, path));
+    REQUIRE(jump.num_expanded * 10 < a_star.num_expanded);
+  }
+
+  SECTION("Test that the start and goal can be the same cell") {
+    GridMap map = GridMap(4, 4);
+    SearchContext context = SearchContext(map);
+    CellIndex cell = map.GetIndex(2, 1);
+    SearchResult result =
+        pathfinder::FindJumpPointPath(context, cell, cell, path);
+    REQUIRE(result.found);
+    REQUIRE(result.cost == 0);
+    REQUIRE(path.size() == 1);
+  }
+
+  SECTION("Test that a walled off goal is not found") {
+    // . # .
+    // # . .
+    GridMap map = GridMap(2, 3);
+    map.SetPassable(map.GetIndex(0, 1), false);
+    map.SetPassable(map.GetIndex(1, 0), false);
+    SearchContext context = SearchContext(map);
+    pathfinder::JumpTable table;
+    table.Build(map);
+
+    CellIndex start = map.GetIndex(1, 2);
+    CellIndex goal = map.GetIndex(0, 0);
+    REQUIRE(!pathfinder::FindJumpPointPath(context, start, goal, path).found);
+    REQUIRE(path.empty());
+    REQUIRE(!pathfinder::FindJumpPointPath(context, start, goal, path, &table)
+                 .found);
+  }
+
+  SECTION("Test that paths cost the same as A* on random maps") {
+    for (unsigned seed = 0; seed < 20; seed++) {
+      GridMap map = MakeRandomMap(24, 31, 0.1 + 0.02 * seed, seed);
+      SearchContext context = SearchContext(map);
+      pathfinder::JumpTable table;
+      table.Build(map);
+      std::vector<CellIndex> a_star_path;
+
+      std::mt19937 random(seed);
+      std::uniform_int_distribution<CellIndex> cell(0, map.GetNumCells() - 1);
+      for (int query = 0; query < 50; query++) {
+        CellIndex start = cell(random);
+        CellIndex goal = cell(random);
+        SearchResult a_star =
+            pathfinder::FindPath(context, start, goal, a_star_path);
+
+        SearchResult jump =
+            pathfinder::FindJumpPointPath(context, start, goal, path);
+        REQUIRE(jump.found == a_star.found);
+        REQUIRE(jump.cost == a_star.cost);
+        REQUIRE(path.size() == a_star_path.size());
+        REQUIRE(IsConnectedPath(map, path));
+
+        SearchResult jump_plus =
+            pathfinder::FindJumpPointPath(context, start, goal, path, &table);
+        REQUIRE(jump_plus.found == a_star.found);
+        REQUIRE(jump_plus.cost == a_star.cost);
+        REQUIRE(jump_plus.num_expanded == jump.num_expanded);
+        REQUIRE(IsConnectedPath(map, path));
+        if (a_star.found) {
+          REQUIRE(path.front() == start);
+          REQUIRE(path.back() == goal);
+        }
+      }
+    }
+  }
+
+  SECTION("Test that maps with cell costs fall back to A*") {
+    for (unsigned seed = 0; seed < 5; seed++) {
+      GridMap map = MakeRandomMap(24, 31, 0.15, seed);
+      std::mt19937 random(seed);
+      std::uniform_int_distribution<int> terrain(1, 5);
+      for (CellIndex index = 0; index < map.GetNumCells(); index++) {
+        map.SetCost(index, terrain(random));
+      }
+      SearchContext context = SearchContext(map);
+      std::vector<CellIndex> a_star_path;
+
+      std::uniform_int_distribution<CellIndex> cell(0, map.GetNumCells() - 1);
+      for (int query = 0; query < 50; query++) {
+        CellIndex start = cell(random);
+        CellIndex goal = cell(random);
+        SearchResult a_star =
+            pathfinder::FindPath(context, start, goal, a_star_path);
+        SearchResult jump =
+            pathfinder::FindJumpPointPath(context, start, goal, path);
+        REQUIRE(jump.found == a_star.found);
+        REQUIRE(jump.cost == a_star.cost);
+        REQUIRE(IsConnectedPath(map, path));
+      }
+    }
+  }
+}
@@ -0,0 +1,236 @@
+#include <core/landmarks.h>
+#include <core/search.h>
+
+#include <catch2/catch.hpp>
+#include <random>
+#include <sstream>
+
+#include "test_maps.h"
+
+using pathfinder::CellIndex;
+using pathfinder::GridMap;
+using pathfinder::LandmarkTable;
+using pathfinder::SearchContext;
+using pathfinder::SearchResult;
+using pathfinder::testing::MakeRandomMap;
+
+namespace {
+
+/**
+ * Helper method that makes a map split by a wall down the middle, which is
+ * only open at the bottom row
+ */
+GridMap MakeDividedMap(size_t num_rows, size_t num_cols) {
+  GridMap map = GridMap(num_rows, num_cols);
+  for (size_t row = 0; row + 1 < num_rows; row++) {
+    map.SetPassable(map.GetIndex(row, num_cols / 2), false);
+  }
+  return map;
+}
+
+}  // namespace
+
+TEST_CASE("Test LandmarkTable") {
+  std::vector<CellIndex> path;
+
+  SECTION("Test an empty table estimates 0") {
+    LandmarkTable table;
+    REQUIRE(table.GetLandmarks().empty());
+    REQUIRE(table.GetLowerBound(3, 7) == 0);
+  }
+
+  SECTION("Test distances on a corridor") {
+    // . . . . . .
+    GridMap map = GridMap(1, 6);
+    LandmarkTable table;
+    table.Build(map, 2);
+
+    // The two ends are the farthest apart
+    REQUIRE(table.GetLandmarks().size() == 2);
+    REQUIRE(table.GetDistance(0, table.GetLandmarks()[0]) == 0);
+    REQUIRE(table.GetDistance(1, table.GetLandmarks()[0]) == 5);
+    REQUIRE(table.GetLowerBound(map.GetIndex(0, 1), map.GetIndex(0, 4)) == 3);
+  }
+
+  SECTION("Test unreachable cells") {
+    // . # .
+    // . # .
+    GridMap map = GridMap(2, 3);
+    map.SetPassable(map.GetIndex(0, 1), false);
+    map.SetPassable(map.GetIndex(1, 1), false);
+    LandmarkTable table;
+    table.Build(map, 4);
+
+    // Each landmark can only reach its own side
+    for (size_t landmark = 0; landmark < table.GetLandmarks().size();
+         landmark++) {
+      CellIndex cell = table.GetLandmarks()[landmark];
+      CellIndex other_side =
+          map.GetCol(cell) == 0 ? map.GetIndex(0, 2) : map.GetIndex(0, 0);
+      REQUIRE(table.GetDistance(landmark, other_side) == -1);
+      REQUIRE(table.GetDistance(landmark, map.GetIndex(0, 1)) == -1);
+    }
+    REQUIRE(table.GetLowerBound(map.GetIndex(0, 0), map.GetIndex(1, 2)) == 0);
+  }
+
+  SECTION("Test a map with fewer open cells than landmarks") {
+    GridMap map = GridMap(2, 2);
+    map.SetPassable(map.GetIndex(0, 0), false);
+    LandmarkTable table;
+    table.Build(map, 8);
+    REQUIRE(table.GetLandmarks().size() == 3);
+    REQUIRE(table.GetDistance(2, map.GetIndex(1, 1)) >= 0);
+
+    map.SetPassable(map.GetIndex(0, 1), false);
+    map.SetPassable(map.GetIndex(1, 0), false);
+    map.SetPassable(map.GetIndex(1, 1), false);
+    table.Build(map, 8);
+    REQUIRE(table.GetLandmarks().empty());
+  }
+
+  SECTION("Test the lower bound never overestimates on random maps") {
+    for (unsigned seed = 0; seed < 10; seed++) {
+      GridMap map = MakeRandomMap(20, 27, 0.1 + 0.03 * seed, seed);
+      SearchContext context = SearchContext(map);
+      LandmarkTable table;
+      table.Build(map);
+
+      std::mt19937 random(seed);
+      std::uniform_int_distribution<CellIndex> cell(0, map.GetNumCells() - 1);
+      for (int query = 0; query < 50; query++) {
+        CellIndex start = cell(random);
+        CellIndex goal = cell(random);
+        SearchResult result = pathfinder::FindPath(context, start, goal, path);
+        if (result.found) {
+          REQUIRE(table.GetLowerBound(start, goal) <= result.cost);
+          REQUIRE(table.GetLowerBound(goal, start) <= result.cost);
+        }
+      }
+    }
+  }
+
+  SECTION("Test searches with landmarks find equally short paths") {
+    for (unsigned seed = 0; seed < 10; seed++) {
+      GridMap map = MakeRandomMap(24, 31, 0.15 + 0.02 * seed, seed);
+      SearchContext context = SearchContext(map);
+      SearchContext landmark_context = SearchContext(map);
+      LandmarkTable table;
+      table.Build(map);
+      landmark_context.SetLandmarks(&table);
+      std::vector<CellIndex> landmark_path;
+
+      std::mt19937 random(seed);
+      std::uniform_int_distribution<CellIndex> cell(0, map.GetNumCells() - 1);
+      for (int query = 0; query < 50; query++) {
+        CellIndex start = cell(random);
+        CellIndex goal = cell(random);
+        SearchResult manhattan =
+            pathfinder::FindPath(context, start, goal, path);
+        SearchResult landmarks =
+            pathfinder::FindPath(landmark_context, start, goal, landmark_path);
+        REQUIRE(landmarks.found == manhattan.found);
+        REQUIRE(landmarks.cost == manhattan.cost);
+      }
+    }
+  }
+
+  SECTION("Test landmarks expand fewer cells around walls") {
+    GridMap map = MakeDividedMap(40, 41);
+    SearchContext context = SearchContext(map);
+    CellIndex start = map.GetIndex(0, 19);
+    CellIndex goal = map.GetIndex(0, 21);
+    SearchResult manhattan = pathfinder::FindPath(context, start, goal, path);
+
+    LandmarkTable table;
+    table.Build(map);
+    context.SetLandmarks(&table);
+    SearchResult landmarks = pathfinder::FindPath(context, start, goal, path);
+    REQUIRE(landmarks.found);
+    REQUIRE(landmarks.cost == manhattan.cost);
+    REQUIRE(landmarks.num_expanded * 4 < manhattan.num_expanded);
+  }
+
+  SECTION("Test a saved table loads back the same") {
+    GridMap map = MakeRandomMap(17, 23, 0.25, 7);
+    LandmarkTable table;
+    table.Build(map, 5);
+    std::stringstream stream;
+    REQUIRE(table.Save(stream));
+
+    LandmarkTable loaded;
+    REQUIRE(loaded.Load(stream, map));
+    REQUIRE(loaded.GetLandmarks() == table.GetLandmarks());
+    for (size_t landmark = 0; landmark < table.GetLandmarks().size();
+         landmark++) {
+      for (CellIndex index = 0; index < map.GetNumCells(); index++) {
+        REQUIRE(loaded.GetDistance(landmark, index) ==
+                table.GetDistance(landmark, index));
+      }
+    }
+  }
+
+  SECTION("Test malformed tables are rejected") {
+    GridMap map = GridMap(4, 5);
+    LandmarkTable table;
+    table.Build(map, 2);
+    std::stringstream stream;
+    REQUIRE(table.Save(stream));
+    std::string saved = stream.str();
+    LandmarkTable loaded;
+
+    SECTION("Test a map of a different size") {
+      std::istringstream input(saved);
+      REQUIRE(!loaded.Load(input, GridMap(5, 4)));
+      REQUIRE(loaded.GetLandmarks().empty());
+    }
+
+    SECTION("Test a map with different walls") {
+      map.SetPassable(map.GetIndex(2, 3), false);
+      std::istringstream input(saved);
+      REQUIRE(!loaded.Load(input, map));
+    }
+
+    SECTION("Test a wrong header") {
+      saved[0] = 'X';
+      std::istringstream input(saved);
+      REQUIRE(!loaded.Load(input, map));
+    }
+
+    SECTION("Test a truncated table") {
+      std::istringstream input(saved.substr(0, saved.size() - 1));
+      REQUIRE(!loaded.Load(input, map));
+      REQUIRE(loaded.GetLandmarks().empty());
+    }
+
+    SECTION("Test a corrupt number of landmarks") {
+      // The number of landmarks follows the magic, the size and the hash
+      SECTION("Test more landmarks than cells") {
+        saved.replace(16, 4, "\xff\xff\xff\xff", 4);
+        std::istringstream input(saved);
+        REQUIRE(!loaded.Load(input, map));
+      }
+
+      SECTION("Test more landmarks than the file holds") {
+        saved.replace(16, 4, "\x03\x00\x00\x00", 4);
+        std::istringstream input(saved);
+        REQUIRE(!loaded.Load(input, map));
+        REQUIRE(loaded.GetLandmarks().empty());
+      }
+    }
+  }
+
+  SECTION("Test checking which map a table was built for") {
+    GridMap map = GridMap(4, 5);
+    LandmarkTable table;
+    REQUIRE(!table.IsBuiltFor(map));
+    table.Build(map, 2);
+    REQUIRE(table.IsBuiltFor(map));
+
+    // Costs don't change the distances, but walls and sizes do
+    map.SetCost(map.GetIndex(1, 1), 5);
+    REQUIRE(table.IsBuiltFor(map));
+    map.SetPassable(map.GetIndex(1, 1), false);
+    REQUIRE(!table.IsBuiltFor(map));
+    REQUIRE(!table.IsBuiltFor(GridMap(5, 4)));
+  }
+}
@@ -1,7 +1,111 @@
+#include <core/map_io.h>
 #include <core/pathfinder.h>
 
 #include <catch2/catch.hpp>
+#include <sstream>
 
 TEST_CASE("Check that test file is working") {
   REQUIRE(1 == 1);
 }
+
+TEST_CASE("Test LoadMap") {
+  pathfinder::GridMap map;
+
+  SECTION("Test loading a map") {
+    std::istringstream input("..@.\n.T..\nGS.W\n");
+    REQUIRE(pathfinder::LoadMap(input, map));
+    REQUIRE(map.GetNumRows() == 3);
+    REQUIRE(map.GetNumCols() == 4);
+
+    SECTION("Test that walls are loaded") {
+      REQUIRE(!map.IsPassable(map.GetIndex(0, 2)));
+      REQUIRE(!map.IsPassable(map.GetIndex(1, 1)));
+      REQUIRE(!map.IsPassable(map.GetIndex(2, 3)));
+    }
+
+    SECTION("Test that passable terrain is loaded") {
+      REQUIRE(map.IsPassable(map.GetIndex(0, 0)));
+      REQUIRE(map.IsPassable(map.GetIndex(2, 0)));
+      REQUIRE(map.IsPassable(map.GetIndex(2, 1)));
+    }
+  }
+
+  SECTION("Test that carriage returns and blank lines are ignored") {
+    std::istringstream input("..\r\n\r\n.@\r\n");
+    REQUIRE(pathfinder::LoadMap(input, map));
+    REQUIRE(map.GetNumRows() == 2);
+    REQUIRE(map.GetNumCols() == 2);
+    REQUIRE(!map.IsPassable(map.GetIndex(1, 1)));
+  }
+
+  SECTION("Test that rows of different lengths are rejected") {
+    std::istringstream input("...\n..\n");
+    REQUIRE(!pathfinder::LoadMap(input, map));
+  }
+
+  SECTION("Test that an empty map is rejected") {
+    std::istringstream input("");
+    REQUIRE(!pathfinder::LoadMap(input, map));
+  }
+
+  SECTION("Test loading a Moving AI map") {
+    std::istringstream input(
+        "type octile\nheight 2\nwidth 3\nmap\n.@.\nT..\n");
+    REQUIRE(pathfinder::LoadMap(input, map));
+    REQUIRE(map.GetNumRows() == 2);
+    REQUIRE(map.GetNumCols() == 3);
+    REQUIRE(!map.IsPassable(map.GetIndex(0, 1)));
+    REQUIRE(!map.IsPassable(map.GetIndex(1, 0)));
+    REQUIRE(map.IsPassable(map.GetIndex(1, 2)));
+  }
+
+  SECTION("Test that a Moving AI map with too few rows is rejected") {
+    std::istringstream input("type octile\nheight 3\nwidth 3\nmap\n...\n");
+    REQUIRE(!pathfinder::LoadMap(input, map));
+  }
+
+  SECTION("Test that a Moving AI map with the wrong width is rejected") {
+    std::istringstream input("type octile\nheight 1\nwidth 3\nmap\n....\n");
+    REQUIRE(!pathfinder::LoadMap(input, map));
+  }
+
+  SECTION("Test that a Moving AI map without a map line is rejected") {
+    std::istringstream input("type octile\nheight 1\nwidth 3\n...\n");
+    REQUIRE(!pathfinder::LoadMap(input, map));
+  }
+}
+
+TEST_CASE("Test LoadScenarios") {
+  std::vector<pathfinder::Scenario> scenarios;
+
+  SECTION("Test loading scenarios") {
+    std::istringstream input(
+        "version 1\n"
+        "0\tmaps/arena.map\t49\t50\t1\t11\t2\t12\t1.41421356\n"
+        "3\tmaps/arena.map\t49\t50\t5\t6\t7\t8\t12.5\n");
+    REQUIRE(pathfinder::LoadScenarios(input, scenarios));
+    REQUIRE(scenarios.size() == 2);
+    REQUIRE(scenarios[0].bucket == 0);
+    REQUIRE(scenarios[0].map_name == "maps/arena.map");
+    REQUIRE(scenarios[0].map_width == 49);
+    REQUIRE(scenarios[0].map_height == 50);
+
+    // x is the column and y is the row
+    REQUIRE(scenarios[0].start_col == 1);
+    REQUIRE(scenarios[0].start_row == 11);
+    REQUIRE(scenarios[0].goal_col == 2);
+    REQUIRE(scenarios[0].goal_row == 12);
+    REQUIRE(scenarios[0].optimal_length == Approx(1.41421356));
+    REQUIRE(scenarios[1].bucket == 3);
+  }
+
+  SECTION("Test that a missing version line is rejected") {
+    std::istringstream input("0\tarena.map\t49\t50\t1\t11\t2\t12\t1\n");
+    REQUIRE(!pathfinder::LoadScenarios(input, scenarios));
+  }
+
+  SECTION("Test that a malformed scenario is rejected") {
+    std::istringstream input("version 1\n0\tarena.map\t49\n");
+    REQUIRE(!pathfinder::LoadScenarios(input, scenarios));
+  }
+}
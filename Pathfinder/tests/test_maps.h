@@ -0,0 +1,68 @@
+#pragma once
+
+#include <random>
+#include <vector>
+
+#include "core/grid_map.h"
+#include "core/search.h"
+
+namespace pathfinder {
+
+namespace testing {
+
+/**
+ * Helper method that makes a map with roughly the given share of walls
+ */
+inline GridMap MakeRandomMap(size_t num_rows, size_t num_cols,
+                             double wall_chance, unsigned seed) {
+  GridMap map = GridMap(num_rows, num_cols);
+  std::mt19937 random(seed);
+  std::bernoulli_distribution is_wall(wall_chance);
+  for (CellIndex index = 0; index < map.GetNumCells(); index++) {
+    if (is_wall(random)) {
+      map.SetPassable(index, false);
+    }
+  }
+  return map;
+}
+
+/**
+ * Helper method that makes a map with roughly the given share of walls and
+ * random cell costs up to max_cost
+ */
+inline GridMap MakeRandomMap(size_t num_rows, size_t num_cols,
+                             double wall_chance, int max_cost, unsigned seed) {
+  GridMap map = GridMap(num_rows, num_cols);
+  std::mt19937 random(seed);
+  std::bernoulli_distribution is_wall(wall_chance);
+  std::uniform_int_distribution<int> terrain(1, max_cost);
+  for (CellIndex index = 0; index < map.GetNumCells(); index++) {
+    map.SetPassable(index, !is_wall(random));
+    map.SetCost(index, terrain(random));
+  }
+  return map;
+}
+
+/**
+ * Helper method that checks a path is made of open cells that share an edge
+ * and runs from start to goal
+ */
+inline bool IsValidPath(const GridMap& map, const std::vector<CellIndex>& path,
+                        CellIndex start, CellIndex goal) {
+  if (path.empty() || path.front() != start || path.back() != goal) {
+    return false;
+  }
+  for (size_t i = 0; i < path.size(); i++) {
+    if (!map.IsPassable(path[i])) {
+      return false;
+    }
+    if (i > 0 && ManhattanDistance(map, path[i - 1], path[i]) != 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace testing
+
+}  // namespace pathfinder
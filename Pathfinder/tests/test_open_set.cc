@@ -0,0 +1,79 @@
+#include <core/open_set.h>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Test OpenSet") {
+  pathfinder::OpenSet open_set = pathfinder::OpenSet(16);
+
+  SECTION("Test that a new open set is empty") {
+    REQUIRE(open_set.Empty());
+    REQUIRE(!open_set.Contains(0));
+  }
+
+  SECTION("Test that cells come out in order of F cost") {
+    open_set.Push(3, 7, 1);
+    open_set.Push(5, 2, 1);
+    open_set.Push(9, 4, 1);
+    REQUIRE(open_set.Size() == 3);
+    REQUIRE(open_set.Pop() == 5);
+    REQUIRE(open_set.Pop() == 9);
+    REQUIRE(open_set.Pop() == 3);
+    REQUIRE(open_set.Empty());
+  }
+
+  SECTION("Test tie breaking") {
+    SECTION("Test that ties on F cost go to the lower H cost") {
+      open_set.Push(1, 6, 4);
+      open_set.Push(2, 6, 2);
+      REQUIRE(open_set.Pop() == 2);
+    }
+
+    SECTION("Test that ties on F and H cost go to the lower index") {
+      open_set.Push(8, 6, 2);
+      open_set.Push(4, 6, 2);
+      REQUIRE(open_set.Pop() == 4);
+    }
+  }
+
+  SECTION("Test that DecreaseKey moves a cell to the front") {
+    open_set.Push(1, 5, 1);
+    open_set.Push(2, 6, 1);
+    open_set.Push(3, 8, 1);
+    open_set.DecreaseKey(3, 4, 1);
+    REQUIRE(open_set.Top() == 3);
+    REQUIRE(open_set.GetTopFCost() == 4);
+    REQUIRE(open_set.GetTopHCost() == 1);
+    REQUIRE(open_set.Size() == 3);
+  }
+
+  SECTION("Test Contains and Remove") {
+    open_set.Push(1, 5, 1);
+    open_set.Push(2, 6, 1);
+    open_set.Push(3, 8, 1);
+    REQUIRE(open_set.Contains(2));
+    open_set.Remove(1);
+    REQUIRE(!open_set.Contains(1));
+    REQUIRE(open_set.Pop() == 2);
+    REQUIRE(open_set.Pop() == 3);
+    REQUIRE(!open_set.Contains(3));
+  }
+
+  SECTION("Test that Reset empties the open set") {
+    open_set.Push(1, 5, 1);
+    open_set.Reset(4);
+    REQUIRE(open_set.Empty());
+    REQUIRE(!open_set.Contains(1));
+  }
+
+  SECTION("Test that positions left over from a reset are not members") {
+    open_set.Push(1, 5, 1);
+    open_set.Push(2, 6, 1);
+    open_set.Reset(16);
+
+    // Cell 3 now sits where cell 1 used to be
+    open_set.Push(3, 4, 1);
+    REQUIRE(open_set.Contains(3));
+    REQUIRE(!open_set.Contains(1));
+    REQUIRE(!open_set.Contains(2));
+  }
+}
@@ -21,8 +21,9 @@ TEST_CASE("Test Pathfinder") {
   pathfinder::Cell start_ = grid[0][0];
   pathfinder::Cell end_ = grid[4][4];
 
+  pathfinder::GridMap map = pathfinder::MakeGridMap(grid);
   pathfinder::Pathfinder test_pathfinder =
-      pathfinder::Pathfinder(grid, start_, end_);
+      pathfinder::Pathfinder(map, start_, end_);
 
   SECTION("Test that program can stop when path is found") {
     REQUIRE(test_pathfinder.PathFound(grid[4][4]));
@@ -35,15 +36,18 @@ TEST_CASE("Test Pathfinder") {
     }
 
     SECTION("Test that a wall is not included as a valid cell to move to") {
-      grid[2][2].SetType(pathfinder::CellType::kWall);
-      REQUIRE(test_pathfinder.FindNextCell(grid[2][2]).GetPosition() !=
-              grid[2][3].GetPosition());
-      REQUIRE(test_pathfinder.FindNextCell(grid[2][2]).GetPosition() ==
-              grid[3][2].GetPosition());
+      grid[2][3].SetType(pathfinder::CellType::kWall);
+      pathfinder::GridMap wall_map = pathfinder::MakeGridMap(grid);
+      pathfinder::Pathfinder wall_pathfinder =
+          pathfinder::Pathfinder(wall_map, start_, end_);
+      pathfinder::Cell next_cell = wall_pathfinder.FindNextCell(grid[2][2]);
+      REQUIRE(next_cell.GetPosition() != grid[2][3].GetPosition());
+      REQUIRE(next_cell.GetPosition() == grid[3][2].GetPosition());
     }
 
     SECTION("Test that an element from the closed set is not included") {
-      REQUIRE(test_pathfinder.FindNextCell(grid[0][1]).GetPosition() !=
+      pathfinder::Cell next_cell = test_pathfinder.FindNextCell(start_);
+      REQUIRE(test_pathfinder.FindNextCell(next_cell).GetPosition() !=
               start_.GetPosition());
     }
 
@@ -93,23 +97,45 @@ TEST_CASE("Test Pathfinder") {
       pathfinder::Cell new_cell = test_pathfinder.FindNextCell(start_);
       std::vector<pathfinder::Cell> set = test_pathfinder.GetOpenSet();
       REQUIRE(!test_pathfinder.ContainsElement(set, start_));
+      REQUIRE(!test_pathfinder.ContainsElement(set, new_cell));
+    }
+
+    SECTION("Test that a shorter route lowers the G cost of an open cell") {
+      // Moving from start_ to grid[0][1] opens grid[1][1] with a G cost of 2
+      pathfinder::Cell next_cell = test_pathfinder.FindNextCell(start_);
+      test_pathfinder.FindNextCell(next_cell);
+
+      // grid[2][1] has never been reached, so it is expanded with a G cost
+      // of 0 and gives grid[1][1] a cheaper route
+      test_pathfinder.FindNextCell(grid[2][1]);
+      std::vector<pathfinder::Cell> path = test_pathfinder.GetPath(grid[1][1]);
+      REQUIRE(path[0].GetGCost() == 1);
+      REQUIRE(path[1].GetPosition() == grid[2][1].GetPosition());
     }
   }
 
   SECTION("Test Algorithm") {
     SECTION("Test that proper cell is chosen") {
       SECTION("Test that proper cell is chosen normally") {
-        REQUIRE(test_pathfinder.FindNextCell(grid[2][2]).GetPosition().x ==
-                grid[2][2].GetPosition().x);
-        REQUIRE(test_pathfinder.FindNextCell(grid[2][2]).GetPosition().y ==
-                grid[2][3].GetPosition().y);
+        pathfinder::Cell next_cell = test_pathfinder.FindNextCell(grid[2][2]);
+        REQUIRE(next_cell.GetPosition().row == grid[2][3].GetPosition().row);
+        REQUIRE(next_cell.GetPosition().col == grid[2][3].GetPosition().col);
       }
 
       SECTION("Test that proper cell is chosen when next to the end node") {
-        REQUIRE((test_pathfinder.FindNextCell(grid[3][3]).GetPosition().x ==
-                 grid[4][4].GetPosition().x));
-        REQUIRE((test_pathfinder.FindNextCell(grid[3][3]).GetPosition().y ==
-                 grid[4][4].GetPosition().y));
+        pathfinder::Cell next_cell = test_pathfinder.FindNextCell(grid[3][3]);
+        next_cell = test_pathfinder.FindNextCell(next_cell);
+        REQUIRE(next_cell.GetPosition().row == grid[4][4].GetPosition().row);
+        REQUIRE(next_cell.GetPosition().col == grid[4][4].GetPosition().col);
+      }
+
+      SECTION("Test that ties on F cost go to the cell closer to the end") {
+        // grid[1][0] and grid[0][1] have equal F and H costs, so the lower
+        // index wins, after which the cells along row 0 have the lowest H
+        pathfinder::Cell next_cell = test_pathfinder.FindNextCell(start_);
+        REQUIRE(next_cell.GetPosition() == grid[0][1].GetPosition());
+        next_cell = test_pathfinder.FindNextCell(next_cell);
+        REQUIRE(next_cell.GetPosition() == grid[0][2].GetPosition());
       }
     }
 
@@ -119,24 +145,148 @@ TEST_CASE("Test Pathfinder") {
 
       SECTION("Test that it goes from the start_ to the end_") {
         SECTION("Test that it has start_") {
-          REQUIRE(path[path.size() - 1].GetPosition() == end_.GetPosition());
+          REQUIRE(path[path.size() - 1].GetPosition() == start_.GetPosition());
         }
 
         SECTION("Test that it goes till the end_") {
           REQUIRE(path[0].GetPosition() == end_.GetPosition());
         }
 
+        SECTION("Test that the path is as short as possible") {
+          REQUIRE(path.size() == 9);
+        }
+
         SECTION("Test key points in the path") {
           SECTION("Test that the turning point is there") {
-            REQUIRE(path[4].GetPosition() == grid[4][0].GetPosition());
+            REQUIRE(path[4].GetPosition() == grid[0][4].GetPosition());
           }
         }
       }
     }
 
+    SECTION("Test that the path goes around walls") {
+      // Wall off column 2 except for the bottom row
+      for (size_t row = 0; row < 4; row++) {
+        grid[row][2].SetType(pathfinder::CellType::kWall);
+      }
+      pathfinder::GridMap wall_map = pathfinder::MakeGridMap(grid);
+      pathfinder::Pathfinder wall_pathfinder =
+          pathfinder::Pathfinder(wall_map, start_, end_);
+      wall_pathfinder.FindPath();
+      std::vector<pathfinder::Cell> path = wall_pathfinder.GetPath(end_);
+
+      REQUIRE(path.size() == 9);
+      REQUIRE(wall_pathfinder.ContainsElement(path, grid[4][2]));
+      for (size_t row = 0; row < 4; row++) {
+        REQUIRE(!wall_pathfinder.ContainsElement(path, grid[row][2]));
+      }
+    }
+
+    SECTION("Test that jump point search finds an equally short path") {
+      // Wall off column 2 except for the bottom row
+      for (size_t row = 0; row < 4; row++) {
+        grid[row][2].SetType(pathfinder::CellType::kWall);
+      }
+      pathfinder::GridMap wall_map = pathfinder::MakeGridMap(grid);
+      pathfinder::SearchMode modes[] = {pathfinder::SearchMode::kJumpPoint,
+                                        pathfinder::SearchMode::kJumpPointPlus};
+      for (pathfinder::SearchMode mode : modes) {
+        pathfinder::Pathfinder jump_pathfinder =
+            pathfinder::Pathfinder(wall_map, start_, end_);
+        jump_pathfinder.SetSearchMode(mode);
+        REQUIRE(jump_pathfinder.GetSearchMode() == mode);
+
+        // Only jump points are moved to, so the end is reached in fewer steps
+        // than there are cells in the path
+        size_t num_steps = 0;
+        pathfinder::Cell current_cell = start_;
+        while (!jump_pathfinder.PathFound(current_cell)) {
+          current_cell = jump_pathfinder.FindNextCell(current_cell);
+          num_steps++;
+        }
+        REQUIRE(num_steps < 8);
+
+        // The cells between jump points are filled back in
+        std::vector<pathfinder::Cell> path = jump_pathfinder.GetPath(end_);
+        REQUIRE(path.size() == 9);
+        REQUIRE(path[0].GetPosition() == end_.GetPosition());
+        REQUIRE(path[8].GetPosition() == start_.GetPosition());
+        REQUIRE(jump_pathfinder.ContainsElement(path, grid[4][2]));
+      }
+    }
+
+    SECTION("Test that a bidirectional search finds an equally short path") {
+      for (size_t row = 0; row < 4; row++) {
+        grid[row][2].SetType(pathfinder::CellType::kWall);
+      }
+      pathfinder::GridMap wall_map = pathfinder::MakeGridMap(grid);
+      pathfinder::Pathfinder bidirectional_pathfinder =
+          pathfinder::Pathfinder(wall_map, start_, end_);
+      bidirectional_pathfinder.SetSearchMode(
+          pathfinder::SearchMode::kBidirectional);
+      bidirectional_pathfinder.FindPath();
+      REQUIRE(!bidirectional_pathfinder.IsExhausted());
+
+      // The path is joined where the two searches met
+      std::vector<pathfinder::Cell> path =
+          bidirectional_pathfinder.GetPath(end_);
+      REQUIRE(path.size() == 9);
+      REQUIRE(path[0].GetPosition() == end_.GetPosition());
+      REQUIRE(path[8].GetPosition() == start_.GetPosition());
+      REQUIRE(bidirectional_pathfinder.ContainsElement(path, grid[4][2]));
+    }
+
+    SECTION("Test that landmarks find an equally short path") {
+      for (size_t row = 0; row < 4; row++) {
+        grid[row][2].SetType(pathfinder::CellType::kWall);
+      }
+      pathfinder::GridMap wall_map = pathfinder::MakeGridMap(grid);
+      pathfinder::Pathfinder landmark_pathfinder =
+          pathfinder::Pathfinder(wall_map, start_, end_);
+      landmark_pathfinder.SetUseLandmarks(true);
+      REQUIRE(landmark_pathfinder.GetUseLandmarks());
+      landmark_pathfinder.FindPath();
+      REQUIRE(!landmark_pathfinder.IsExhausted());
+      REQUIRE(landmark_pathfinder.GetPath(end_).size() == 9);
+    }
+
+    SECTION("Test that searching again expands the same cells") {
+      std::vector<pathfinder::Cell> first_search;
+      pathfinder::Cell current_cell = start_;
+      while (!test_pathfinder.PathFound(current_cell)) {
+        current_cell = test_pathfinder.FindNextCell(current_cell);
+        first_search.push_back(current_cell);
+      }
+
+      test_pathfinder.SetGrid(map, start_, end_);
+      REQUIRE(test_pathfinder.GetOpenSet().size() == 1);
+      current_cell = start_;
+      for (const pathfinder::Cell& cell : first_search) {
+        current_cell = test_pathfinder.FindNextCell(current_cell);
+        REQUIRE(current_cell.GetPosition() == cell.GetPosition());
+        REQUIRE(current_cell.GetGCost() == cell.GetGCost());
+      }
+    }
+
+    SECTION("Test that the search stops when there is no path") {
+      grid[3][4].SetType(pathfinder::CellType::kWall);
+      grid[4][3].SetType(pathfinder::CellType::kWall);
+      pathfinder::GridMap wall_map = pathfinder::MakeGridMap(grid);
+      pathfinder::Pathfinder wall_pathfinder =
+          pathfinder::Pathfinder(wall_map, start_, end_);
+      wall_pathfinder.FindPath();
+      REQUIRE(wall_pathfinder.IsExhausted());
+
+      wall_pathfinder.SetSearchMode(pathfinder::SearchMode::kBidirectional);
+      wall_pathfinder.FindPath();
+      REQUIRE(wall_pathfinder.IsExhausted());
+    }
+
     SECTION("Test that F Cost is calculated correctly") {
+      test_pathfinder.FindPath();
       std::vector<pathfinder::Cell> path = test_pathfinder.GetPath(end_);
       REQUIRE(path[path.size() - 1].GetFCost() == 8);
+      REQUIRE(path[0].GetFCost() == 8);
     }
 
     SECTION("Test ContainsElement") {
@@ -146,7 +296,7 @@ TEST_CASE("Test Pathfinder") {
         }
 
         SECTION("Test middle of vector") {
-          REQUIRE(test_pathfinder.ContainsElement(grid[0], grid[0][5]));
+          REQUIRE(test_pathfinder.ContainsElement(grid[0], grid[0][2]));
         }
 
         SECTION("Test end of vector") {
@@ -160,4 +310,4 @@ TEST_CASE("Test Pathfinder") {
       }
     }
   }
-}
\ No newline at end of file
+}
@@ -0,0 +1,175 @@
+#include <core/replanner.h>
+
+#include <catch2/catch.hpp>
+#include <random>
+
+#include "test_maps.h"
+
+using pathfinder::CellIndex;
+using pathfinder::GridMap;
+using pathfinder::Replanner;
+using pathfinder::SearchContext;
+using pathfinder::SearchResult;
+using pathfinder::testing::IsValidPath;
+
+TEST_CASE("Test Replanner") {
+  std::vector<CellIndex> path;
+
+  SECTION("Test the first search on an open map") {
+    GridMap map = GridMap(10, 10);
+    Replanner replanner = Replanner(map);
+    CellIndex start = map.GetIndex(1, 2);
+    CellIndex goal = map.GetIndex(8, 6);
+    replanner.Reset(start, goal);
+    SearchResult result = replanner.FindPath(path);
+    REQUIRE(result.found);
+    REQUIRE(result.cost == 7 + 4);
+    REQUIRE(result.path_length == 12);
+    REQUIRE(IsValidPath(map, path, start, goal));
+  }
+
+  SECTION("Test that the start can be the goal") {
+    GridMap map = GridMap(4, 4);
+    Replanner replanner = Replanner(map);
+    replanner.Reset(5, 5);
+    SearchResult result = replanner.FindPath(path);
+    REQUIRE(result.found);
+    REQUIRE(result.cost == 0);
+    REQUIRE(path == std::vector<CellIndex>{5});
+  }
+
+  SECTION("Test walling off the goal and opening it again") {
+    GridMap map = GridMap(5, 5);
+    Replanner replanner = Replanner(map);
+    CellIndex start = map.GetIndex(0, 0);
+    CellIndex goal = map.GetIndex(4, 4);
+    replanner.Reset(start, goal);
+    REQUIRE(replanner.FindPath(path).found);
+
+    std::vector<CellIndex> walls = {map.GetIndex(3, 4), map.GetIndex(4, 3)};
+    for (CellIndex wall : walls) {
+      map.SetPassable(wall, false);
+    }
+    replanner.UpdateCells(walls);
+    REQUIRE(!replanner.FindPath(path).found);
+    REQUIRE(path.empty());
+
+    map.SetPassable(walls[1], true);
+    replanner.UpdateCells({walls[1]});
+    SearchResult result = replanner.FindPath(path);
+    REQUIRE(result.found);
+    REQUIRE(result.cost == 8);
+    REQUIRE(path[path.size() - 2] == walls[1]);
+  }
+
+  SECTION("Test that a small change only touches nearby cells") {
+    GridMap map = GridMap(64, 64);
+    Replanner replanner = Replanner(map);
+    CellIndex start = map.GetIndex(0, 0);
+    CellIndex goal = map.GetIndex(63, 63);
+    replanner.Reset(start, goal);
+    replanner.FindPath(path);
+    size_t first_touched = replanner.GetNumTouched();
+
+    // A wall next to the path is off every shortest path there is
+    CellIndex wall = map.GetIndex(40, 10);
+    map.SetPassable(wall, false);
+    replanner.UpdateCells({wall});
+    SearchResult result = replanner.FindPath(path);
+    REQUIRE(result.found);
+    REQUIRE(result.cost == 126);
+    REQUIRE(replanner.GetNumTouched() < first_touched / 10);
+  }
+
+  SECTION("Test replanning against A* while walls change and the start "
+          "moves") {
+    std::mt19937 random(12);
+    for (int trial = 0; trial < 10; trial++) {
+      GridMap map = GridMap(30, 40);
+      std::bernoulli_distribution is_wall(0.25);
+      for (CellIndex index = 0; index < map.GetNumCells(); index++) {
+        map.SetPassable(index, !is_wall(random));
+      }
+      std::uniform_int_distribution<CellIndex> cell(0, map.GetNumCells() - 1);
+      CellIndex start = cell(random);
+      CellIndex goal = cell(random);
+      map.SetPassable(start, true);
+      map.SetPassable(goal, true);
+
+      Replanner replanner = Replanner(map);
+      replanner.Reset(start, goal);
+      SearchContext context = SearchContext(map);
+      std::vector<CellIndex> expected_path;
+      for (int tick = 0; tick < 30; tick++) {
+        // Flip a batch of cells, never the start or the goal
+        std::vector<CellIndex> changed;
+        for (int i = 0; i < 8; i++) {
+          CellIndex index = cell(random);
+          if (index != start && index != goal) {
+            map.SetPassable(index, !map.IsPassable(index));
+            changed.push_back(index);
+          }
+        }
+        replanner.UpdateCells(changed);
+
+        SearchResult result = replanner.FindPath(path);
+        SearchResult expected =
+            pathfinder::FindPath(context, start, goal, expected_path);
+        REQUIRE(result.found == expected.found);
+        if (!result.found) {
+          continue;
+        }
+        REQUIRE(result.cost == expected.cost);
+        REQUIRE(result.path_length == path.size());
+        REQUIRE(IsValidPath(map, path, start, goal));
+
+        // The agent takes one step along the path before the next change
+        if (path.size() > 1) {
+          start = path[1];
+          replanner.SetStart(start);
+        }
+      }
+    }
+  }
+
+  SECTION("Test replanning against A* while cell costs change") {
+    std::mt19937 random(5);
+    std::uniform_int_distribution<int> terrain(1, 9);
+    for (int trial = 0; trial < 5; trial++) {
+      GridMap map = GridMap(30, 40);
+      std::bernoulli_distribution is_wall(0.15);
+      for (CellIndex index = 0; index < map.GetNumCells(); index++) {
+        map.SetPassable(index, !is_wall(random));
+        map.SetCost(index, terrain(random));
+      }
+      std::uniform_int_distribution<CellIndex> cell(0, map.GetNumCells() - 1);
+      CellIndex start = cell(random);
+      CellIndex goal = cell(random);
+      map.SetPassable(start, true);
+      map.SetPassable(goal, true);
+
+      Replanner replanner = Replanner(map);
+      replanner.Reset(start, goal);
+      SearchContext context = SearchContext(map);
+      std::vector<CellIndex> expected_path;
+      for (int tick = 0; tick < 20; tick++) {
+        std::vector<CellIndex> changed;
+        for (int i = 0; i < 8; i++) {
+          CellIndex index = cell(random);
+          map.SetCost(index, terrain(random));
+          changed.push_back(index);
+        }
+        replanner.UpdateCells(changed);
+
+        SearchResult result = replanner.FindPath(path);
+        SearchResult expected =
+            pathfinder::FindPath(context, start, goal, expected_path);
+        REQUIRE(result.found == expected.found);
+        REQUIRE(result.cost == expected.cost);
+        if (result.found) {
+          REQUIRE(IsValidPath(map, path, start, goal));
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,202 @@
+#include <core/pathfinder.h>
+
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Counts every allocation made through operator new in the test binary
+std::atomic<size_t> allocation_count(0);
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  allocation_count++;
+  void* pointer = std::malloc(size == 0 ? 1 : size);
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+TEST_CASE("Test FindPath with a SearchContext") {
+  // 5x5 map with column 2 walled off except for the bottom row
+  pathfinder::GridMap map = pathfinder::GridMap(5, 5);
+  for (size_t row = 0; row < 4; row++) {
+    map.SetPassable(map.GetIndex(row, 2), false);
+  }
+  pathfinder::SearchContext context = pathfinder::SearchContext(map);
+  std::vector<pathfinder::CellIndex> path;
+
+  SECTION("Test that the path goes from start to goal around the wall") {
+    pathfinder::SearchResult result =
+        pathfinder::FindPath(context, map.GetIndex(0, 0), map.GetIndex(0, 4),
+                             path);
+    REQUIRE(result.found);
+    REQUIRE(result.cost == 12);
+    REQUIRE(path.size() == 13);
+    REQUIRE(path.front() == map.GetIndex(0, 0));
+    REQUIRE(path.back() == map.GetIndex(0, 4));
+    REQUIRE(path[6] == map.GetIndex(4, 2));
+  }
+
+  SECTION("Test that a start equal to the goal gives a one cell path") {
+    pathfinder::SearchResult result = pathfinder::FindPath(
+        context, map.GetIndex(3, 3), map.GetIndex(3, 3), path);
+    REQUIRE(result.found);
+    REQUIRE(result.cost == 0);
+    REQUIRE(path.size() == 1);
+  }
+
+  SECTION("Test that an unreachable goal leaves the path empty") {
+    map.SetPassable(map.GetIndex(4, 2), false);
+    path.push_back(7);
+    pathfinder::SearchResult result = pathfinder::FindPath(
+        context, map.GetIndex(0, 0), map.GetIndex(0, 4), path);
+    REQUIRE(!result.found);
+    REQUIRE(path.empty());
+    REQUIRE(result.num_expanded == 10);
+  }
+
+  SECTION("Test that a wall can't be the start or the goal") {
+    pathfinder::SearchResult result = pathfinder::FindPath(
+        context, map.GetIndex(0, 2), map.GetIndex(0, 4), path);
+    REQUIRE(!result.found);
+  }
+
+  SECTION("Test that the context can be reused with the same results") {
+    pathfinder::SearchResult first = pathfinder::FindPath(
+        context, map.GetIndex(0, 0), map.GetIndex(0, 4), path);
+    std::vector<pathfinder::CellIndex> first_path = path;
+    pathfinder::FindPath(context, map.GetIndex(4, 4), map.GetIndex(1, 1),
+                         path);
+    pathfinder::SearchResult second = pathfinder::FindPath(
+        context, map.GetIndex(0, 0), map.GetIndex(0, 4), path);
+    REQUIRE(path == first_path);
+    REQUIRE(second.num_expanded == first.num_expanded);
+  }
+}
+
+TEST_CASE("Test that repeated queries don't allocate") {
+  // 32x32 map with a few walls so that paths have to bend
+  const size_t kMapSize = 32;
+  const size_t kNumQueries = 10000;
+  pathfinder::GridMap map = pathfinder::GridMap(kMapSize, kMapSize);
+  for (size_t row = 0; row < kMapSize - 4; row += 4) {
+    for (size_t col = 2; col < kMapSize; col++) {
+      map.SetPassable(map.GetIndex(row + (col % 3), col), false);
+    }
+  }
+
+  std::vector<pathfinder::CellIndex> starts;
+  std::vector<pathfinder::CellIndex> goals;
+  std::srand(42);
+  while (starts.size() < kNumQueries) {
+    pathfinder::CellIndex start = std::rand() % map.GetNumCells();
+    pathfinder::CellIndex goal = std::rand() % map.GetNumCells();
+    if (map.IsPassable(start) && map.IsPassable(goal)) {
+      starts.push_back(start);
+      goals.push_back(goal);
+    }
+  }
+
+  pathfinder::SearchContext context = pathfinder::SearchContext(map);
+  std::vector<size_t> path_lengths(kNumQueries);
+  size_t num_found = 0;
+
+  size_t allocations_before = allocation_count;
+  for (size_t query = 0; query < kNumQueries; query++) {
+    std::vector<pathfinder::CellIndex>& path = context.GetPathBuffer();
+    pathfinder::SearchResult result =
+        pathfinder::FindPath(context, starts[query], goals[query], path);
+    path_lengths[query] = path.size();
+    num_found += result.found;
+  }
+  size_t allocations_after = allocation_count;
+
+  REQUIRE(allocations_after == allocations_before);
+  REQUIRE(num_found > 0);
+}
+
+TEST_CASE("Test FindPath on a map with cell costs") {
+  std::vector<pathfinder::CellIndex> path;
+
+  SECTION("Test that the path goes around a costly strip") {
+    // Crossing column 2 directly costs 13, and the detour around the bottom
+    // costs 12
+    pathfinder::GridMap map = pathfinder::GridMap(5, 5);
+    for (size_t row = 0; row < 4; row++) {
+      map.SetCost(map.GetIndex(row, 2), 10);
+    }
+    pathfinder::SearchContext context = pathfinder::SearchContext(map);
+    pathfinder::SearchResult result = pathfinder::FindPath(
+        context, map.GetIndex(0, 0), map.GetIndex(0, 4), path);
+    REQUIRE(result.found);
+    REQUIRE(result.cost == 12);
+    REQUIRE(path[6] == map.GetIndex(4, 2));
+
+    // Once the strip is cheap enough, going straight across wins
+    for (size_t row = 0; row < 4; row++) {
+      map.SetCost(map.GetIndex(row, 2), 3);
+    }
+    context.SetMap(map);
+    result = pathfinder::FindPath(context, map.GetIndex(0, 0),
+                                  map.GetIndex(0, 4), path);
+    REQUIRE(result.cost == 6);
+    REQUIRE(path.size() == 5);
+  }
+
+  SECTION("Test that the bucket queue and the heap find equal costs") {
+    std::mt19937 random(3);
+    std::uniform_int_distribution<int> terrain(1, 9);
+    std::bernoulli_distribution is_wall(0.2);
+    for (int trial = 0; trial < 10; trial++) {
+      pathfinder::GridMap map = pathfinder::GridMap(20, 27);
+      for (pathfinder::CellIndex index = 0; index < map.GetNumCells();
+           index++) {
+        map.SetPassable(index, !is_wall(random));
+        map.SetCost(index, terrain(random));
+      }
+
+      // A single wall with a cost too high for buckets sends the second map
+      // through the heap without changing any path
+      pathfinder::GridMap heap_map = map;
+      heap_map.SetPassable(0, false);
+      heap_map.SetCost(0, pathfinder::kMaxBucketCost + 1);
+      map.SetPassable(0, false);
+      pathfinder::SearchContext bucket_context =
+          pathfinder::SearchContext(map);
+      pathfinder::SearchContext heap_context =
+          pathfinder::SearchContext(heap_map);
+      std::vector<pathfinder::CellIndex> heap_path;
+
+      std::uniform_int_distribution<pathfinder::CellIndex> cell(
+          0, map.GetNumCells() - 1);
+      for (int query = 0; query < 50; query++) {
+        pathfinder::CellIndex start = cell(random);
+        pathfinder::CellIndex goal = cell(random);
+        pathfinder::SearchResult bucket =
+            pathfinder::FindPath(bucket_context, start, goal, path);
+        pathfinder::SearchResult heap =
+            pathfinder::FindPath(heap_context, start, goal, heap_path);
+        REQUIRE(bucket.found == heap.found);
+        REQUIRE(bucket.cost == heap.cost);
+
+        // The cost of a path is the sum of the cells entered after the start
+        int path_cost = 0;
+        for (size_t i = 1; i < path.size(); i++) {
+          path_cost += map.GetCost(path[i]);
+        }
+        REQUIRE(path_cost == bucket.cost);
+      }
+    }
+  }
+}
@@ -0,0 +1,79 @@
+#include <core/search_state.h>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Test SearchState") {
+  pathfinder::SearchState state = pathfinder::SearchState(10);
+
+  SECTION("Test that a new state has not visited any cells") {
+    for (pathfinder::CellIndex index = 0; index < 10; index++) {
+      REQUIRE(!state.IsVisited(index));
+      REQUIRE(!state.IsClosed(index));
+      REQUIRE(state.GetParent(index) == pathfinder::kNoCell);
+    }
+  }
+
+  SECTION("Test visiting and closing cells") {
+    state.Visit(3, 7, 2);
+    REQUIRE(state.IsVisited(3));
+    REQUIRE(!state.IsClosed(3));
+    REQUIRE(state.GetGCost(3) == 7);
+    REQUIRE(state.GetParent(3) == 2);
+
+    state.Close(3);
+    REQUIRE(state.IsClosed(3));
+    REQUIRE(state.GetGCost(3) == 7);
+  }
+
+  SECTION("Test that closing an unvisited cell gives it no parent") {
+    state.Close(5);
+    REQUIRE(state.IsVisited(5));
+    REQUIRE(state.IsClosed(5));
+    REQUIRE(state.GetGCost(5) == 0);
+    REQUIRE(state.GetParent(5) == pathfinder::kNoCell);
+  }
+
+  SECTION("Test that Reset forgets the previous search") {
+    state.Visit(1, 4, 0);
+    state.Close(2);
+    state.Reset(10);
+    REQUIRE(!state.IsVisited(1));
+    REQUIRE(!state.IsClosed(2));
+    REQUIRE(state.GetGCost(1) == 0);
+    REQUIRE(state.GetParent(1) == pathfinder::kNoCell);
+
+    state.Visit(1, 9, 3);
+    REQUIRE(state.GetGCost(1) == 9);
+  }
+
+  SECTION("Test that Reset can change the number of cells") {
+    state.Visit(1, 4, 0);
+    state.Reset(20);
+    REQUIRE(!state.IsVisited(1));
+    state.Close(19);
+    REQUIRE(state.IsClosed(19));
+  }
+}
+
+TEST_CASE("Test CellSet") {
+  pathfinder::CellSet set = pathfinder::CellSet(10);
+
+  SECTION("Test inserting cells") {
+    REQUIRE(!set.Contains(4));
+    set.Insert(4);
+    REQUIRE(set.Contains(4));
+    REQUIRE(!set.Contains(5));
+  }
+
+  SECTION("Test that Clear empties the set") {
+    set.Insert(4);
+    set.Clear();
+    REQUIRE(!set.Contains(4));
+    set.Insert(6);
+    REQUIRE(set.Contains(6));
+  }
+
+  SECTION("Test that cells outside of the map are never contained") {
+    REQUIRE(!set.Contains(10));
+  }
+}
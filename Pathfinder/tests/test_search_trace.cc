@@ -0,0 +1,201 @@
+#include <core/search.h>
+#include <core/search_context.h>
+#include <core/search_trace.h>
+
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * Helper method that writes a trace of the given events on the given map
+ * and returns its bytes
+ */
+std::string WriteTrace(const pathfinder::GridMap& map,
+                       const std::vector<pathfinder::TraceEvent>& events) {
+  std::ostringstream output;
+  pathfinder::TraceWriter writer(output);
+  writer.WriteHeader(map);
+  for (const pathfinder::TraceEvent& event : events) {
+    writer.Record(event.GetType(), event.cell, event.GetCost());
+  }
+  writer.Flush();
+  return output.str();
+}
+
+}  // namespace
+
+TEST_CASE("Test TraceEvent") {
+  SECTION("Test that the type and cost are packed together") {
+    pathfinder::TraceEvent event = pathfinder::TraceEvent::Make(
+        pathfinder::TraceEventType::kDecreaseKey, 42, 1234);
+    REQUIRE(event.GetType() == pathfinder::TraceEventType::kDecreaseKey);
+    REQUIRE(event.cell == 42);
+    REQUIRE(event.GetCost() == 1234);
+  }
+
+  SECTION("Test that costs out of range are clamped") {
+    pathfinder::TraceEvent event = pathfinder::TraceEvent::Make(
+        pathfinder::TraceEventType::kPath, 0, 1 << 30);
+    REQUIRE(event.GetType() == pathfinder::TraceEventType::kPath);
+    REQUIRE(event.GetCost() == pathfinder::TraceEvent::kMaxCost);
+
+    event = pathfinder::TraceEvent::Make(pathfinder::TraceEventType::kPop, 0,
+                                         -5);
+    REQUIRE(event.GetCost() == 0);
+  }
+}
+
+TEST_CASE("Test writing and loading traces") {
+  pathfinder::GridMap map = pathfinder::GridMap(3, 4);
+  map.SetPassable(map.GetIndex(1, 1), false);
+  map.SetCost(map.GetIndex(2, 3), 7);
+
+  // More events than fit in the writer's buffer at once
+  std::vector<pathfinder::TraceEvent> events;
+  for (int i = 0; i < 20000; i++) {
+    events.push_back(pathfinder::TraceEvent::Make(
+        (pathfinder::TraceEventType)(i % 6), i % map.GetNumCells(), i));
+  }
+  std::string bytes = WriteTrace(map, events);
+
+  SECTION("Test that a trace loads back the same map and events") {
+    std::istringstream input(bytes);
+    pathfinder::SearchTrace trace;
+    REQUIRE(pathfinder::LoadTrace(input, trace));
+    REQUIRE(trace.map.GetNumRows() == 3);
+    REQUIRE(trace.map.GetNumCols() == 4);
+    for (pathfinder::CellIndex index = 0; index < map.GetNumCells();
+         index++) {
+      REQUIRE(trace.map.IsPassable(index) == map.IsPassable(index));
+      if (map.IsPassable(index)) {
+        REQUIRE(trace.map.GetCost(index) == map.GetCost(index));
+      }
+    }
+    REQUIRE(trace.events.size() == events.size());
+    for (size_t i = 0; i < events.size(); i++) {
+      REQUIRE(trace.events[i].cell == events[i].cell);
+      REQUIRE(trace.events[i].type_and_cost == events[i].type_and_cost);
+    }
+  }
+
+  SECTION("Test that a partly written event at the end is ignored") {
+    std::istringstream input(bytes.substr(0, bytes.size() - 3));
+    pathfinder::SearchTrace trace;
+    REQUIRE(pathfinder::LoadTrace(input, trace));
+    REQUIRE(trace.events.size() == events.size() - 1);
+  }
+
+  SECTION("Test that data that isn't a trace is rejected") {
+    std::string not_trace = bytes;
+    not_trace[0] = 'X';
+    std::istringstream input(not_trace);
+    pathfinder::SearchTrace trace;
+    REQUIRE_FALSE(pathfinder::LoadTrace(input, trace));
+    REQUIRE(trace.events.empty());
+  }
+
+  SECTION("Test that a cut off map is rejected") {
+    std::istringstream input(bytes.substr(0, 20));
+    pathfinder::SearchTrace trace;
+    REQUIRE_FALSE(pathfinder::LoadTrace(input, trace));
+  }
+
+  SECTION("Test that a huge map with no cells after it is rejected") {
+    // The header of a 65536x65536 map, which would take 4 GB to allocate
+    std::string huge = bytes.substr(0, 8) + std::string("\x00\x00\x01\x00", 4) +
+                       std::string("\x00\x00\x01\x00", 4);
+    std::istringstream input(huge);
+    pathfinder::SearchTrace trace;
+    REQUIRE_FALSE(pathfinder::LoadTrace(input, trace));
+
+    // The same size, but within the limit on each side
+    huge = bytes.substr(0, 8) + std::string("\xff\xff\x00\x00", 4) +
+           std::string("\xff\xff\x00\x00", 4);
+    input.str(huge);
+    input.clear();
+    REQUIRE_FALSE(pathfinder::LoadTrace(input, trace));
+    REQUIRE(trace.events.empty());
+  }
+
+  SECTION("Test that events for cells off the map are rejected") {
+    std::vector<pathfinder::TraceEvent> bad_events = events;
+    bad_events.push_back(pathfinder::TraceEvent::Make(
+        pathfinder::TraceEventType::kPush, map.GetNumCells(), 0));
+    std::istringstream input(WriteTrace(map, bad_events));
+    pathfinder::SearchTrace trace;
+    REQUIRE_FALSE(pathfinder::LoadTrace(input, trace));
+  }
+}
+
+TEST_CASE("Test tracing a search") {
+  // 5x5 map with column 2 walled off except for the bottom row
+  pathfinder::GridMap map = pathfinder::GridMap(5, 5);
+  for (size_t row = 0; row < 4; row++) {
+    map.SetPassable(map.GetIndex(row, 2), false);
+  }
+  pathfinder::SearchContext context = pathfinder::SearchContext(map);
+  std::ostringstream output;
+  pathfinder::TraceWriter writer(output);
+  writer.WriteHeader(map);
+  context.SetTrace(&writer);
+
+  std::vector<pathfinder::CellIndex> path;
+  pathfinder::CellIndex start = map.GetIndex(0, 0);
+  pathfinder::CellIndex goal = map.GetIndex(0, 4);
+  pathfinder::SearchResult result =
+      pathfinder::FindPath(context, start, goal, path);
+  REQUIRE(result.found);
+  writer.Flush();
+
+  std::istringstream input(output.str());
+  pathfinder::SearchTrace trace;
+  REQUIRE(pathfinder::LoadTrace(input, trace));
+
+#ifdef PATHFINDER_TRACE
+  SECTION("Test that the trace starts with the query") {
+    REQUIRE(trace.events.size() == writer.GetNumEvents());
+    REQUIRE(trace.events.size() > 3);
+    REQUIRE(trace.events[0].GetType() == pathfinder::TraceEventType::kStart);
+    REQUIRE(trace.events[0].cell == start);
+    REQUIRE(trace.events[1].GetType() == pathfinder::TraceEventType::kGoal);
+    REQUIRE(trace.events[1].cell == goal);
+    REQUIRE(trace.events[2].GetType() == pathfinder::TraceEventType::kPush);
+    REQUIRE(trace.events[2].cell == start);
+  }
+
+  SECTION("Test that every expanded cell is pushed before it is popped") {
+    std::vector<bool> pushed(map.GetNumCells(), false);
+    size_t num_pops = 0;
+    for (const pathfinder::TraceEvent& event : trace.events) {
+      if (event.GetType() == pathfinder::TraceEventType::kPush) {
+        pushed[event.cell] = true;
+      } else if (event.GetType() == pathfinder::TraceEventType::kPop) {
+        REQUIRE(pushed[event.cell]);
+        num_pops++;
+      }
+    }
+
+    // The goal is popped, but not expanded
+    REQUIRE(num_pops == result.num_expanded + 1);
+  }
+
+  SECTION("Test that the trace ends with the path") {
+    REQUIRE(trace.events.size() > path.size());
+    size_t first = trace.events.size() - path.size();
+    for (size_t i = 0; i < path.size(); i++) {
+      const pathfinder::TraceEvent& event = trace.events[first + i];
+      REQUIRE(event.GetType() == pathfinder::TraceEventType::kPath);
+      REQUIRE(event.cell == path[i]);
+    }
+    REQUIRE(trace.events.back().GetCost() == result.cost);
+  }
+#else
+  SECTION("Test that nothing is recorded when tracing is compiled out") {
+    REQUIRE(writer.GetNumEvents() == 0);
+    REQUIRE(trace.events.empty());
+  }
+#endif
+}
@@ -0,0 +1,85 @@
+#include <core/spsc_ring_buffer.h>
+
+#include <catch2/catch.hpp>
+#include <thread>
+
+using pathfinder::SpscRingBuffer;
+
+TEST_CASE("Test SpscRingBuffer") {
+  SpscRingBuffer<int> buffer(5);
+  int element = -1;
+
+  SECTION("Test that the capacity is rounded up to a power of two") {
+    REQUIRE(buffer.GetCapacity() == 8);
+    REQUIRE(SpscRingBuffer<int>(8).GetCapacity() == 8);
+  }
+
+  SECTION("Test that a new buffer is empty") {
+    REQUIRE(buffer.Empty());
+    REQUIRE(!buffer.TryPop(element));
+    REQUIRE(element == -1);
+  }
+
+  SECTION("Test that elements come out in the order they went in") {
+    REQUIRE(buffer.TryPush(3));
+    REQUIRE(buffer.TryPush(1));
+    REQUIRE(buffer.TryPush(2));
+    REQUIRE(!buffer.Empty());
+    REQUIRE(buffer.TryPop(element));
+    REQUIRE(element == 3);
+    REQUIRE(buffer.TryPop(element));
+    REQUIRE(element == 1);
+    REQUIRE(buffer.TryPop(element));
+    REQUIRE(element == 2);
+    REQUIRE(buffer.Empty());
+  }
+
+  SECTION("Test that a full buffer refuses elements until one is popped") {
+    for (int i = 0; i < 8; i++) {
+      REQUIRE(buffer.TryPush(i));
+    }
+    REQUIRE(!buffer.TryPush(8));
+    REQUIRE(buffer.TryPop(element));
+    REQUIRE(element == 0);
+    REQUIRE(buffer.TryPush(8));
+
+    // The slots wrap around
+    for (int i = 1; i <= 8; i++) {
+      REQUIRE(buffer.TryPop(element));
+      REQUIRE(element == i);
+    }
+  }
+
+  SECTION("Test that Clear empties the buffer") {
+    buffer.TryPush(1);
+    buffer.TryPush(2);
+    buffer.Clear();
+    REQUIRE(buffer.Empty());
+    REQUIRE(buffer.TryPush(4));
+    REQUIRE(buffer.TryPop(element));
+    REQUIRE(element == 4);
+  }
+
+  SECTION("Test that every element crosses between two threads in order") {
+    const int kNumElements = 200000;
+    std::thread producer([&buffer] {
+      for (int i = 0; i < kNumElements; i++) {
+        while (!buffer.TryPush(i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    // Checked after joining, since REQUIRE is not thread safe
+    bool in_order = true;
+    for (int expected = 0; expected < kNumElements; expected++) {
+      while (!buffer.TryPop(element)) {
+        std::this_thread::yield();
+      }
+      in_order = in_order && element == expected;
+    }
+    producer.join();
+    REQUIRE(in_order);
+    REQUIRE(buffer.Empty());
+  }
+}
@@ -0,0 +1,100 @@
+#include <core/trace_replay.h>
+
+#include <catch2/catch.hpp>
+#include <vector>
+
+namespace {
+
+/**
+ * Helper method that adds an event to a trace
+ */
+void AddEvent(pathfinder::SearchTrace& trace, pathfinder::TraceEventType type,
+              pathfinder::CellIndex cell) {
+  trace.events.push_back(pathfinder::TraceEvent::Make(type, cell, 0));
+}
+
+}  // namespace
+
+TEST_CASE("Test TraceReplay") {
+  // Two queries on a 1x4 map: 0 to 2, then 3 to 2
+  pathfinder::SearchTrace trace;
+  trace.map = pathfinder::GridMap(1, 4);
+  AddEvent(trace, pathfinder::TraceEventType::kStart, 0);
+  AddEvent(trace, pathfinder::TraceEventType::kGoal, 2);
+  AddEvent(trace, pathfinder::TraceEventType::kPush, 0);
+  AddEvent(trace, pathfinder::TraceEventType::kPop, 0);
+  AddEvent(trace, pathfinder::TraceEventType::kPush, 1);
+  AddEvent(trace, pathfinder::TraceEventType::kPop, 1);
+  AddEvent(trace, pathfinder::TraceEventType::kPush, 2);
+  AddEvent(trace, pathfinder::TraceEventType::kPop, 2);
+  AddEvent(trace, pathfinder::TraceEventType::kPath, 0);
+  AddEvent(trace, pathfinder::TraceEventType::kPath, 1);
+  AddEvent(trace, pathfinder::TraceEventType::kPath, 2);
+  AddEvent(trace, pathfinder::TraceEventType::kStart, 3);
+  AddEvent(trace, pathfinder::TraceEventType::kGoal, 2);
+  AddEvent(trace, pathfinder::TraceEventType::kPush, 3);
+  pathfinder::TraceReplay replay = pathfinder::TraceReplay(trace);
+  std::vector<pathfinder::CellIndex> changed;
+
+  SECTION("Test that the queries are split at each start") {
+    REQUIRE(replay.GetNumQueries() == 2);
+    REQUIRE(replay.GetQuery() == 0);
+    REQUIRE(replay.GetStart() == 0);
+    REQUIRE(replay.GetGoal() == 2);
+    REQUIRE(replay.GetNumSteps() == 11);
+    REQUIRE(replay.GetPosition() == 0);
+
+    replay.SelectQuery(1);
+    REQUIRE(replay.GetStart() == 3);
+    REQUIRE(replay.GetGoal() == 2);
+    REQUIRE(replay.GetNumSteps() == 3);
+  }
+
+  SECTION("Test that cells change state as the search reaches them") {
+    for (pathfinder::CellIndex cell = 0; cell < 4; cell++) {
+      REQUIRE(replay.GetCellState(cell) ==
+              pathfinder::ReplayCellState::kUnseen);
+    }
+
+    replay.Seek(5, changed);
+    REQUIRE(replay.GetCellState(0) == pathfinder::ReplayCellState::kClosed);
+    REQUIRE(replay.GetCellState(1) == pathfinder::ReplayCellState::kOpen);
+    REQUIRE(replay.GetCellState(2) == pathfinder::ReplayCellState::kUnseen);
+
+    replay.Seek(11, changed);
+    for (pathfinder::CellIndex cell = 0; cell < 3; cell++) {
+      REQUIRE(replay.GetCellState(cell) == pathfinder::ReplayCellState::kPath);
+    }
+    REQUIRE(replay.GetCellState(3) == pathfinder::ReplayCellState::kUnseen);
+  }
+
+  SECTION("Test scrubbing backwards") {
+    replay.Seek(11, changed);
+    changed.clear();
+    replay.Seek(4, changed);
+    REQUIRE(replay.GetPosition() == 4);
+    REQUIRE(replay.GetCellState(0) == pathfinder::ReplayCellState::kClosed);
+    REQUIRE(replay.GetCellState(1) == pathfinder::ReplayCellState::kUnseen);
+
+    // The cells of the 7 events moved past
+    REQUIRE(changed.size() == 7);
+    REQUIRE(changed.front() == 1);
+    REQUIRE(changed.back() == 2);
+  }
+
+  SECTION("Test that seeking past the end stops at the end") {
+    replay.Seek(100, changed);
+    REQUIRE(replay.GetPosition() == replay.GetNumSteps());
+    REQUIRE(changed.size() == replay.GetNumSteps());
+  }
+
+  SECTION("Test that selecting a query forgets the last one") {
+    replay.Seek(11, changed);
+    replay.SelectQuery(1);
+    REQUIRE(replay.GetPosition() == 0);
+    replay.Seek(3, changed);
+    REQUIRE(replay.GetCellState(0) == pathfinder::ReplayCellState::kUnseen);
+    REQUIRE(replay.GetCellState(2) == pathfinder::ReplayCellState::kUnseen);
+    REQUIRE(replay.GetCellState(3) == pathfinder::ReplayCellState::kOpen);
+  }
+}